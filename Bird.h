@@ -1,99 +1,190 @@
-/* Bird.h
- * Author: Max Elliott
- * Created On: 2017-12-12
- *
- * Header for Bird objects. Used to represent each bird in the flocking simulation. Each Bird has methods to apply
- * each of its behaviours, which are all called with it's update() method. Inherits from FlockObject.
- */
-#ifndef BIRD_H
-#define BIRD_H
-
-#include<string>
-#include "FlockObject.h"
-#include <TwoVector.h>
-#include <vector>
-#include "Obstacle.h"
-
-
-class Bird : public FlockObject {
-public:
-
-    //Constructor
-    Bird(TwoVector position, double maxSpeed, double heading, int separationDistance, int detectionDistance, std::string colour,
-         double separationStrength, double cohesionStrength, double alignmentStrength, double avoidPredatorStrength);
-
-    //Destructor
-    virtual ~Bird();
-
-    /* Getter methods for data members. Declared inline for faster execution time,
-     * at the cost of more memory usage. Declared const so compiler can perform
-     * some optimisation */
-    inline TwoVector const getVelocity() const{return fVelocity;}
-    inline double const getMaxSpeed()const {return fMaxSpeed;}
-    inline double const getHeading(){return fHeading;}
-    inline int const getSeparationDistance()const {return fSeparationDistance;}
-    inline int const getDetectionDistance()const {return fDetectionDistance;}
-    inline double const getMaxForce()const{return fMaxForce;}
-    inline std::string const getColour()const {return fColour;}
-    inline double const getSeperationStrength()const{return fSeparationStrength;}
-    inline double const getCohesionstrength()const{return fCohesionStrength;}
-    inline double const getAlignmentStrength()const{return fAlignmentStrength;}
-    inline double const getAvoidPredatorStrength()const{return fAvoidPredatorStrength;}
-
-    //setters for all variables (except colour and that will never change)
-    inline void setVelocity(TwoVector newVal){fVelocity = newVal;}
-    inline void setMaxSpeed(double newVal){fMaxSpeed = newVal;}
-    inline void setHeading(double newVal){fHeading = newVal;}
-    inline void setSeparationDistance(int newVal){fSeparationDistance = newVal;}
-    inline void setDetectionDistance(int newVal){fDetectionDistance = newVal;}
-    inline void setSeperationStrength(double newVal){fSeparationStrength = newVal;}
-    inline void setCohesionstrength(double newVal){fCohesionStrength = newVal;}
-    inline void setAlignmentStrength(double newVal){fAlignmentStrength = newVal;}
-    inline void setAvoidPredatorStrength(double newVal){fAvoidPredatorStrength = newVal;}
-
-    //method called on all birds to update it's velocity based on its interaction with the rest of the flock
-    virtual void update(std::vector<Bird*>* flock,std::vector<Obstacle*>* obstacles, int xdim, int ydim);
-
-    //Behavioural methods that calculate the change in velocity for the bird. These are called in the update method.
-    //Each returns a TwoVector 'force' to alter the velocity. Each is due to a different behaviour.
-    TwoVector cohesion(std::vector<Bird* >* flock);
-    TwoVector separation(std::vector<Bird* >* flock);
-    TwoVector alignment(std::vector<Bird* >* flock);
-    TwoVector avoidWalls(int xdim, int ydim);
-    TwoVector avoidPredators(std::vector<Bird* >* flock);
-    TwoVector avoidObstacles(std::vector<Obstacle*>* obstacles);
-
-    //This method is essentially F=ma with m=1. The argument 'TwoVector force' becomes the acceleration, which is added to velocity.
-    void applyForce(TwoVector force);
-
-    //Calculates the heading of the Bird, based on the velocity. Used when drawing the Birds.
-    void changeHeading();
-
-    //Moves the Bird in the direction of its velocity
-    void move();
-
-    //check to make sure the bird is still in the display window dimensions.
-    bool outOfBounds(int xdim, int ydim);
-
-
-
-
-private:
-
-    TwoVector fVelocity;//current velocity
-    double fMaxSpeed;//max speed allowed
-    double fHeading;//angle the Bird is facing towards in degrees
-    const double fMaxForce = 0.07;//maximum magnitude a TwoVector from a single behavior method can be
-    int fSeparationDistance;//distance Birds want to be apart form each other
-    int fDetectionDistance;//Distance Birds can detect other Birds
-    std::string fColour;//colour of object, used when drawing objects in DisplayWindow
-
-    //Weightings of each behaviour. avoidWalls and avoidObstacles do not have weighting variable as they cannot be varied; they have a set weighting.
-    double fSeparationStrength;
-    double fCohesionStrength;
-    double fAlignmentStrength;
-    double fAvoidPredatorStrength;
-
-};
-
-#endif // BIRD_H
+/* Bird.h
+ * Author: Max Elliott
+ * Created On: 2017-12-12
+ *
+ * Header for Bird objects. Used to represent each bird in the flocking simulation. Each Bird has methods to apply
+ * each of its behaviours, which are all called with it's update() method. Inherits from FlockObject.
+ */
+#ifndef BIRD_H
+#define BIRD_H
+
+#include<string>
+#include "FlockObject.h"
+#include <TwoVector.h>
+#include <vector>
+#include "Obstacle.h"
+#include "BirdArena.h"
+
+/* Numeric ids for the colours of Bird. Used where comparing or storing the colour string
+ * would be too slow or take too much space, such as when recording the flock. */
+enum Species{
+    kBlue = 0,
+    kGreen = 1,
+    kRed = 2,
+    kOtherSpecies = 3
+};
+
+/* The behaviours whose forces change slowly enough to be worked out less often than every tick
+ * (see Flock::setBehaviourInterval). Separation and avoiding obstacles and walls are always worked
+ * out, as Birds would crash without them. The bits 1 << behaviour of a mask say which are due. */
+enum SlowBehaviour{
+    kCohesion = 0,
+    kAlignment = 1,
+    kAvoidPredators = 2,
+    kSlowBehaviours = 3
+};
+const int kEverySlowBehaviour = (1 << kSlowBehaviours) - 1;
+
+/* Settings shared by every Bird of a species, as set by the controls in MainWindow. Used to
+ * create many Birds at once with Flock::spawnBatch. hunger is only used by Predators. */
+struct SpeciesParams{
+    double maxSpeed;
+    int separationDistance;
+    int detectionDistance;
+    double separationStrength;
+    double cohesionStrength;
+    double alignmentStrength;
+    double avoidPredatorStrength;
+    int hunger;
+};
+
+/* Number and position sum of some Birds of one species. Used by Flock to hand a Bird whole grid
+ * cells of neighbours that are far away at once, rather than one Bird at a time (see
+ * Flock::setFarField). Sums are kept in double whatever Real is, as they add up many positions. A
+ * Fixed position fits in a double with bits to spare, so in the fixed build the sums are exact. */
+struct NeighbourSums{
+    int count;
+    double x;
+    double y;
+};
+
+class Bird : public FlockObject {
+public:
+
+    //Constructor
+    Bird(TwoVector position, Real maxSpeed, Real heading, int separationDistance, int detectionDistance, std::string colour,
+         Real separationStrength, Real cohesionStrength, Real alignmentStrength, Real avoidPredatorStrength);
+
+    //Destructor
+    virtual ~Bird();
+
+    //Birds and Predators are allocated through BirdArena, so they can be put in huge pages
+    static inline void* operator new(size_t size){return BirdArena::allocate(size);}
+    static inline void operator delete(void* memory){BirdArena::release(memory);}
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline TwoVector const getVelocity() const{return fVelocity;}
+    inline Real const getMaxSpeed()const {return fMaxSpeed;}
+    inline int const getSeparationDistance()const {return fSeparationDistance;}
+    inline int const getDetectionDistance()const {return fDetectionDistance;}
+    inline Real const getMaxForce()const{return fMaxForce;}
+    inline std::string const getColour()const {return fColour;}
+    inline int const getSpecies()const{return fSpecies;}
+    inline int const getId()const{return fId;}
+    inline Real const getSeperationStrength()const{return fSeparationStrength;}
+    inline Real const getCohesionstrength()const{return fCohesionStrength;}
+    inline Real const getAlignmentStrength()const{return fAlignmentStrength;}
+    inline Real const getAvoidPredatorStrength()const{return fAvoidPredatorStrength;}
+    inline bool const getWasEaten()const{return fWasEaten;}
+    inline TwoVector const getSlowForce(int behaviour)const{return fSlowForces[behaviour];}
+    inline int const getKnownForces()const{return fKnownForces;}
+
+    //angle the Bird is facing, in radians, worked out from its velocity when asked for
+    Real getHeading()const;
+
+    //setters for all variables (except colour and that will never change)
+    inline void setId(int newVal){fId = newVal;}
+    inline void setVelocity(TwoVector newVal){fVelocity = newVal;}
+    inline void setMaxSpeed(Real newVal){fMaxSpeed = newVal;}
+    inline void setHeading(Real newVal){fHeading = newVal;}
+    inline void setSeparationDistance(int newVal){fSeparationDistance = newVal;}
+    inline void setDetectionDistance(int newVal){fDetectionDistance = newVal;}
+    inline void setSeperationStrength(Real newVal){fSeparationStrength = newVal;}
+    inline void setCohesionstrength(Real newVal){fCohesionStrength = newVal;}
+    inline void setAlignmentStrength(Real newVal){fAlignmentStrength = newVal;}
+    inline void setAvoidPredatorStrength(Real newVal){fAvoidPredatorStrength = newVal;}
+    inline void setWasEaten(bool newVal){fWasEaten = newVal;}
+
+    //sets the last force of a SlowBehaviour, and marks it as worked out, so a Bird saved or handed over carries on the same
+    inline void setSlowForce(int behaviour, TwoVector force){fSlowForces[behaviour] = force; fKnownForces |= 1 << behaviour;}
+
+    /* method called on all birds to update it's velocity based on its interaction with the rest of the flock.
+     * far, if not 0, sums up more Birds of the same species that are in detection range, but further away
+     * than the separation distance, and so are not in flock. due is a mask of the SlowBehaviours to work
+     * out this time; the others reuse the force they gave last time. */
+    virtual void update(std::vector<Bird*>* flock,std::vector<Obstacle*>* obstacles, int xdim, int ydim, const NeighbourSums* far = 0,
+                        int due = kEverySlowBehaviour);
+
+    //Behavioural methods that calculate the change in velocity for the bird. These are called in the update method.
+    //Each returns a TwoVector 'force' to alter the velocity. Each is due to a different behaviour.
+    TwoVector cohesion(std::vector<Bird* >* flock, const NeighbourSums* far = 0);
+    TwoVector separation(std::vector<Bird* >* flock);
+    TwoVector alignment(std::vector<Bird* >* flock);
+    TwoVector avoidWalls(int xdim, int ydim);
+    TwoVector avoidPredators(std::vector<Bird* >* flock);
+    TwoVector avoidObstacles(std::vector<Obstacle*>* obstacles);
+
+    /* Updates a Bird no force acts on, if it can tell cheaply that none does, and returns whether it
+     * could. Flock calls this for isolated Birds in place of update (see Flock::setSkipIsolated). */
+    bool coast(std::vector<Obstacle*>* obstacles, int xdim, int ydim, int due, int obstaclesVersion);
+
+    //This method is essentially F=ma with m=1. The argument 'TwoVector force' becomes the acceleration, which is added to velocity.
+    void applyForce(TwoVector force);
+
+    //sets the velocity to the one found by the last update, once all Birds have been updated
+    void finishUpdate();
+
+    //converts a colour into its Species id
+    static int speciesFromColour(std::string colour);
+
+    //converts a Species id back into its colour
+    static std::string colourFromSpecies(int species);
+
+    //Moves the Bird in the direction of its velocity
+    void move();
+
+    //check to make sure the bird is still inside the world.
+    bool outOfBounds(int xdim, int ydim);
+
+
+
+
+private:
+
+    TwoVector fVelocity;//current velocity
+    TwoVector fNextVelocity;//velocity found by update, which becomes fVelocity when finishUpdate is called
+    Real fMaxSpeed;//max speed allowed
+    Real fHeading;//angle the Bird was facing when made, in radians. Only used while it isn't moving.
+    Real fMaxForce = 0.07;//maximum magnitude a TwoVector from a single behavior method can be. Not const, so Birds can be assigned (see Flock::reorderBirds)
+    int fSeparationDistance;//distance Birds want to be apart form each other
+    int fDetectionDistance;//Distance Birds can detect other Birds
+    std::string fColour;//colour of object, used when drawing objects in DisplayWindow
+    int fSpecies;//fColour as a Species id
+    int fId;//unique id given to the Bird by Flock when it is added, which stays the same for its whole life
+    bool fWasEaten;//true if a Predator killed the Bird, so Flock can tell what it died of
+
+    //last force of each SlowBehaviour, before weighting, and a mask of those worked out at least once
+    TwoVector fSlowForces[kSlowBehaviours];
+    int fKnownForces;
+
+    /* While a Bird coasts it flies in a straight line, so once it has checked that no obstacle is
+     * near enough to the line it stays clear of them. fClearTicks is how many more ticks it can
+     * coast before checking again, and fClearVersion is Flock's obstacles version when it checked. */
+    static const int kClearTicks = 32;
+    int fClearTicks;
+    int fClearVersion;
+
+    //whether no Obstacle is near the line the Bird is flying along, or near it and ahead of it
+    bool clearOfObstacles(std::vector<Obstacle*>* obstacles);
+
+    //Weightings of each behaviour. avoidWalls and avoidObstacles do not have weighting variable as they cannot be varied; they have a set weighting.
+    Real fSeparationStrength;
+    Real fCohesionStrength;
+    Real fAlignmentStrength;
+    Real fAvoidPredatorStrength;
+
+};
+
+#endif // BIRD_H
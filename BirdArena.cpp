@@ -0,0 +1,93 @@
+/* BirdArena.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for BirdArena, which allocates Birds, in blocks of huge pages when asked to.
+ */
+#include "BirdArena.h"
+#include "Numa.h"
+#include <new>
+
+std::atomic<int> BirdArena::sHugePages(kNoHugePages);
+std::atomic<long long> BirdArena::sMappedBytes(0);
+
+/* The start of every block. references counts the Birds in the block that haven't been deleted,
+ * plus one while it is still the block its thread takes Birds from. used is only read and written
+ * by that thread. */
+struct BirdArena::Block
+{
+    std::atomic<long> references;
+    size_t used;
+};
+
+//the block each thread takes Birds from, which it lets go of when the thread ends
+struct CurrentBlock
+{
+    BirdArena::Block* block;
+    ~CurrentBlock(){if(block) BirdArena::dropReference(block);}
+};
+static thread_local CurrentBlock tCurrentBlock = {0};
+
+//space taken by the start of a block, rounded up so Birds are aligned as the normal operator new would
+static const size_t kBlockHeaderSize = 64;
+
+/* allocate
+ *
+ * inputs:
+ * - size: bytes wanted
+ *
+ * return: memory for the Bird, aligned to 16 bytes
+ */
+void* BirdArena::allocate(size_t size){
+    size_t total = kPrefixSize + (size + 15)/16*16;
+    int hugePages = getHugePages();
+    if(hugePages != kNoHugePages && total <= kHugePageSize - kBlockHeaderSize){
+        CurrentBlock& current = tCurrentBlock;
+        if(!current.block || current.block->used + total > kHugePageSize){
+            Block* block = mapBlock();
+            if(block){
+                if(current.block) dropReference(current.block);
+                current.block = block;
+            }
+        }
+        if(current.block && current.block->used + total <= kHugePageSize){
+            char* start = reinterpret_cast<char*>(current.block) + current.block->used;
+            current.block->used += total;
+            current.block->references.fetch_add(1, std::memory_order_relaxed);
+            *reinterpret_cast<Block**>(start) = current.block;
+            return start + kPrefixSize;
+        }
+    }
+
+    //huge pages are off, or no block could be mapped
+    char* start = static_cast<char*>(::operator new(total));
+    *reinterpret_cast<Block**>(start) = 0;
+    return start + kPrefixSize;
+}
+
+void BirdArena::release(void* memory){
+    if(!memory) return;
+    char* start = static_cast<char*>(memory) - kPrefixSize;
+    Block* block = *reinterpret_cast<Block**>(start);
+    if(block) dropReference(block);
+    else ::operator delete(start);
+}
+
+//maps a block in the current HugePages, with the calling thread's reference to it
+BirdArena::Block* BirdArena::mapBlock(){
+    void* memory = mapMemory(kHugePageSize, getHugePages());
+    if(!memory) return 0;
+    sMappedBytes.fetch_add(kHugePageSize, std::memory_order_relaxed);
+    Block* block = new(memory) Block;
+    block->references.store(1, std::memory_order_relaxed);
+    block->used = kBlockHeaderSize;
+    return block;
+}
+
+//a Bird can be deleted on any thread, so the last reference is found with an atomic count
+void BirdArena::dropReference(Block* block){
+    if(block->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    block->~Block();
+    unmapMemory(block, kHugePageSize);
+    sMappedBytes.fetch_sub(kHugePageSize, std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+/* BirdArena.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for BirdArena, which Birds are allocated from (see Bird::operator new). Normally it
+ * hands every Bird to the normal operator new. With huge pages turned on (see Flock::setHugePages),
+ * it maps memory in blocks of one huge page instead, so that the processor only needs one entry in
+ * its page table cache for every few thousand Birds, rather than one for every twenty.
+ *
+ * Each thread takes Birds from its own block, one after the other, so a block is first written to,
+ * and so placed on a NUMA node, by the thread that made its Birds, until Flock moves its pages (see
+ * Flock::setPinThreads). Memory in a block isn't reused: a block is unmapped once every Bird in it
+ * has been deleted and its thread has moved on to another block, so a flock whose Birds keep dying
+ * and being replaced can hold on to blocks that are mostly empty.
+ */
+#ifndef BIRDARENA_H
+#define BIRDARENA_H
+
+#include <cstddef>
+#include <atomic>
+
+class BirdArena
+{
+public:
+
+    //size bytes for a Bird, from a block if huge pages are on, or else from the normal operator new
+    static void* allocate(size_t size);
+
+    //frees memory from allocate, whichever way it was allocated
+    static void release(void* memory);
+
+    //sets how blocks are mapped from now on, as a HugePages (see Numa.h). Birds already made stay where they are.
+    static inline void setHugePages(int hugePages){sHugePages.store(hugePages, std::memory_order_relaxed);}
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    static inline int getHugePages(){return sHugePages.load(std::memory_order_relaxed);}
+    static inline long long getMappedBytes(){return sMappedBytes.load(std::memory_order_relaxed);}
+
+private:
+
+    //a block of memory Birds are taken from, which starts with this
+    struct Block;
+
+    //the block each thread takes Birds from
+    friend struct CurrentBlock;
+
+    //maps a new block for the calling thread
+    static Block* mapBlock();
+
+    //drops one reference to a block, unmapping it if it was the last
+    static void dropReference(Block* block);
+
+    static std::atomic<int> sHugePages;
+    static std::atomic<long long> sMappedBytes;
+
+    //bytes before each Bird, holding the Block it came from, or 0 if it came from operator new
+    static const size_t kPrefixSize = 16;
+};
+
+#endif // BIRDARENA_H
@@ -1,51 +1,44 @@
-#-------------------------------------------------
-#
-# Project created by QtCreator 2018-01-07T11:44:09
-#
-#-------------------------------------------------
-
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = BirdFlock
-TEMPLATE = app
-CONFIG+= static
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which has been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-
-SOURCES += \
-        Bird.cpp \
-        DisplayWindow.cpp \
-        Flock.cpp \
-        FlockObject.cpp \
-        main.cpp \
-        MainWindow.cpp \
-        Obstacle.cpp \
-        Predator.cpp \
-        TwoVector.cpp
-
-HEADERS += \
-        Bird.h \
-        main.h \
-        DisplayWindow.h \
-        Flock.h \
-        FlockObject.h \
-        MainWindow.h \
-        Obstacle.h \
-        Predator.h \
-        TwoVector.h
-
-FORMS += \
-        DisplayWindow.ui \
-        MainWindow.ui
+#-------------------------------------------------
+#
+# Project created by QtCreator 2018-01-07T11:44:09
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = BirdFlock
+TEMPLATE = app
+CONFIG+= static
+CONFIG += c++11
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+
+# the simulation itself, shared with BirdFlockHeadless.pro
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        DisplayWindow.cpp \
+        main.cpp \
+        MainWindow.cpp
+
+HEADERS += \
+        main.h \
+        DisplayWindow.h \
+        MainWindow.h \
+        Parallel.h
+
+FORMS += \
+        DisplayWindow.ui \
+        MainWindow.ui
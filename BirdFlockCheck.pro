@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Checks that the results which must not change don't:
+# trajectory round trips, any number of threads, Morton
+# reordering, and Predator claims in one Flock and across
+# tiles. Returns 1 if any check fails. Doesn't need Qt
+# at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockCheck
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        CheckMain.cpp
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# BirdFlockCheck built with Fixed instead of double (see
+# BirdFlockHeadlessFixed.pro), so the same checks are run
+# on the integer build.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockCheckFixed
+TEMPLATE = app
+
+DEFINES += BIRDFLOCK_FIXED
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        CheckMain.cpp
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# Runs a scenario's birds as a CompactFlock, with millions
+# of birds in a few bytes each, and reports the memory and
+# time each tick takes. Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockCompact
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        CompactMain.cpp
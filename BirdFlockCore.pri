@@ -0,0 +1,78 @@
+#-------------------------------------------------
+#
+# Sources of the simulation, without the GUI. Included by
+# BirdFlock.pro, BirdFlockHeadless.pro, BirdFlockSweep.pro,
+# BirdFlockCheck.pro and the other headless projects.
+#
+#-------------------------------------------------
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+        $$PWD/Bird.cpp \
+        $$PWD/BirdArena.cpp \
+        $$PWD/Checkpoint.cpp \
+        $$PWD/CompactFlock.cpp \
+        $$PWD/DistributedFlock.cpp \
+        $$PWD/Flock.cpp \
+        $$PWD/FlockAnalytics.cpp \
+        $$PWD/FlockObject.cpp \
+        $$PWD/Numa.cpp \
+        $$PWD/Obstacle.cpp \
+        $$PWD/Predator.cpp \
+        $$PWD/RadixSort.cpp \
+        $$PWD/Random.cpp \
+        $$PWD/Scenario.cpp \
+        $$PWD/SharedMemoryTransport.cpp \
+        $$PWD/SharedFlockReader.cpp \
+        $$PWD/SharedFlockWriter.cpp \
+        $$PWD/SimulationHost.cpp \
+        $$PWD/SocketTransport.cpp \
+        $$PWD/SpatialGrid.cpp \
+        $$PWD/StreamServer.cpp \
+        $$PWD/Sweep.cpp \
+        $$PWD/ThreadPool.cpp \
+        $$PWD/TileTransport.cpp \
+        $$PWD/Trajectory.cpp \
+        $$PWD/TrajectoryReader.cpp \
+        $$PWD/TrajectoryRecorder.cpp \
+        $$PWD/TwoVector.cpp \
+        $$PWD/WebSocket.cpp
+
+HEADERS += \
+        $$PWD/Bird.h \
+        $$PWD/BirdArena.h \
+        $$PWD/Checkpoint.h \
+        $$PWD/CompactFlock.h \
+        $$PWD/DistributedFlock.h \
+        $$PWD/FastMath.h \
+        $$PWD/Fixed.h \
+        $$PWD/Flock.h \
+        $$PWD/FlockAnalytics.h \
+        $$PWD/FlockObject.h \
+        $$PWD/Numa.h \
+        $$PWD/Obstacle.h \
+        $$PWD/Predator.h \
+        $$PWD/RadixSort.h \
+        $$PWD/Random.h \
+        $$PWD/Scenario.h \
+        $$PWD/SharedFlock.h \
+        $$PWD/SharedFlockReader.h \
+        $$PWD/SharedFlockWriter.h \
+        $$PWD/SharedMemoryTransport.h \
+        $$PWD/SimulationHost.h \
+        $$PWD/SocketTransport.h \
+        $$PWD/SpatialGrid.h \
+        $$PWD/StatsChannel.h \
+        $$PWD/StreamServer.h \
+        $$PWD/Sweep.h \
+        $$PWD/ThreadPool.h \
+        $$PWD/TileTransport.h \
+        $$PWD/Trajectory.h \
+        $$PWD/TrajectoryReader.h \
+        $$PWD/TrajectoryRecorder.h \
+        $$PWD/TwoVector.h \
+        $$PWD/WebSocket.h
+
+unix: LIBS += -pthread
+unix:!macx: LIBS += -lrt
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# Runs a scenario split into tiles, one process per
+# tile, on one machine or several. Doesn't need Qt at
+# run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockDistributed
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        DistributedMain.cpp
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Compares two recordings of the same scenario, to check
+# the float and fixed builds flock the same way as the
+# normal one.
+# Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockDrift
+TEMPLATE = app
+
+SOURCES += \
+        DriftMain.cpp \
+        Trajectory.cpp \
+        TrajectoryReader.cpp
+
+HEADERS += \
+        Trajectory.h \
+        TrajectoryReader.h
@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Measures how fast a flock can be published into shared
+# memory and read back out. Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockExportBench
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        ExportBenchMain.cpp
@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Runs a scenario file without any windows, for large runs
+# and benchmarks. Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockHeadless
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        HeadlessMain.cpp
@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# BirdFlockHeadless built with Fixed, a 64 bit integer
+# with 24 bits after the point, instead of double for
+# every position, velocity and setting of the Birds
+# (see Fixed.h). Its results are the same to the last
+# bit with any compiler, options, processor and number
+# of threads. Any of the other projects can be built the
+# same way with qmake "DEFINES+=BIRDFLOCK_FIXED".
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockHeadlessFixed
+TEMPLATE = app
+
+DEFINES += BIRDFLOCK_FIXED
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        HeadlessMain.cpp
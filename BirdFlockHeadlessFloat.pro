@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# BirdFlockHeadless built with float instead of double
+# for every position, velocity and setting of the Birds
+# (see TwoVector.h). Any of the other projects can be
+# built the same way with qmake "DEFINES+=BIRDFLOCK_FLOAT".
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockHeadlessFloat
+TEMPLATE = app
+
+DEFINES += BIRDFLOCK_FLOAT
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        HeadlessMain.cpp
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Example of following a simulation from another program,
+# through the shared memory BirdFlockHeadless --export
+# publishes into. Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockReader
+TEMPLATE = app
+
+SOURCES += \
+        ReaderMain.cpp \
+        SharedFlockReader.cpp
+
+HEADERS += \
+        SharedFlock.h \
+        SharedFlockReader.h
+
+unix:!macx: LIBS += -lrt
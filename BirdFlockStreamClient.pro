@@ -0,0 +1,23 @@
+#-------------------------------------------------
+#
+# Command line viewer for the stream BirdFlockHeadless
+# --serve sends, for checking it without a browser.
+# Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockStreamClient
+TEMPLATE = app
+
+SOURCES += \
+        StreamClientMain.cpp \
+        Trajectory.cpp \
+        WebSocket.cpp
+
+HEADERS += \
+        Trajectory.h \
+        WebSocket.h
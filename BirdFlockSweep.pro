@@ -0,0 +1,18 @@
+#-------------------------------------------------
+#
+# Runs a scenario many times with different settings
+# and writes a results file. Doesn't need Qt at run time.
+#
+#-------------------------------------------------
+
+QT       -= core gui
+CONFIG   -= qt app_bundle
+CONFIG   += console c++11
+
+TARGET = BirdFlockSweep
+TEMPLATE = app
+
+include(BirdFlockCore.pri)
+
+SOURCES += \
+        SweepMain.cpp
@@ -0,0 +1,429 @@
+/* CheckMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-19
+ *
+ * main for BirdFlockCheck and BirdFlockCheckFixed, which run small flocks through the paths whose
+ * results must not change, and check that they don't:
+ *
+ *     BirdFlockCheck [--ticks N]
+ *
+ * - trajectory: a recording reads back, in any order, as exactly the frames that were recorded
+ * - threads: 1, 2, 4 and 7 threads end in exactly the same state
+ * - reorder: putting the Birds in Morton order in memory doesn't change the result
+ * - claims: every Bird eaten is eaten by exactly one Predator
+ * - tiles: a world split into tiles (see DistributedFlock), crowded enough that Predators in two
+ *   tiles catch the same Birds, ends exactly as one Flock does
+ * - intervals: with slow behaviours worked out every few ticks, more threads, restoring from a
+ *   checkpoint and splitting into tiles still end exactly the same
+ *
+ * Each check prints ok or what went wrong, and the program returns 1 if any failed. Every check
+ * runs for N ticks, 60 by default. BirdFlockCheckFixed is the same with Real as Fixed.
+ */
+#include "Flock.h"
+#include "Predator.h"
+#include "Scenario.h"
+#include "Checkpoint.h"
+#include "DistributedFlock.h"
+#include "TileTransport.h"
+#include "TrajectoryRecorder.h"
+#include "TrajectoryReader.h"
+#include <vector>
+#include <map>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+#include <unistd.h>
+
+//ticks each check runs if --ticks doesn't say
+static const int kDefaultTicks = 60;
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockCheck [--ticks N]" << std::endl;
+}
+
+/* makeScenario
+ *
+ * inputs:
+ * - width, height: size of the world
+ * - blue, green, red: number of Birds of each species
+ * - threads: threads to simulate with
+ *
+ * return: a scenario with those settings and a fixed seed, and the defaults for everything else
+ */
+static Scenario makeScenario(int width, int height, int blue, int green, int red, int threads){
+    Scenario scenario;
+    scenario.setSetting("world.width", width);
+    scenario.setSetting("world.height", height);
+    scenario.setSetting("species.blue.count", blue);
+    scenario.setSetting("species.green.count", green);
+    scenario.setSetting("species.red.count", red);
+    scenario.setSetting("species.red.hunger", 1000);
+    scenario.setSetting("obstacles.count", 4);
+    scenario.setSeed(7);
+    scenario.setThreads(threads);
+    return scenario;
+}
+
+//runs a scenario for some ticks and saves where it ends. Returns the number of times the Birds were reordered.
+static long long runScenario(const Scenario& scenario, int ticks, Checkpoint* checkpoint){
+    Flock flock;
+    scenario.apply(&flock);
+    for(int tick=0; tick<ticks; tick++){
+        flock.simulateFlock();
+    }
+    flock.saveCheckpoint(checkpoint);
+    return flock.getReorderCount();
+}
+
+//whether two Birds are the same to the last bit
+inline static bool sameBird(const CheckpointBird& a, const CheckpointBird& b){
+    return memcmp(&a, &b, sizeof(CheckpointBird)) == 0;
+}
+
+/* compareCheckpoints
+ *
+ * inputs:
+ * - expected, actual: the checkpoints
+ * - problem: set to what is different, if anything
+ *
+ * return: true if they are exactly the same
+ */
+static bool compareCheckpoints(const Checkpoint& expected, const Checkpoint& actual, std::string* problem){
+    if(memcmp(&expected.header, &actual.header, sizeof(CheckpointHeader)) != 0){
+        *problem = "the headers differ";
+        return false;
+    }
+    if(expected.birds.size() != actual.birds.size()){
+        *problem = std::to_string(actual.birds.size()) + " birds, not " + std::to_string(expected.birds.size());
+        return false;
+    }
+    for(int i=0; i<expected.birds.size(); i++){
+        if(!sameBird(expected.birds[i], actual.birds[i])){
+            *problem = "bird " + std::to_string(expected.birds[i].id) + " differs";
+            return false;
+        }
+    }
+    return true;
+}
+
+/* checkTrajectory
+ *
+ * Records a run, keeping the quantised state of every tick, then reads the recording back from
+ * the last frame to the first, so most frames are found from their keyframe.
+ *
+ * inputs:
+ * - ticks: ticks to record
+ * - problem: set to what went wrong
+ *
+ * return: true if every frame read back is the one recorded, and none were lost
+ */
+static bool checkTrajectory(int ticks, std::string* problem){
+    std::string path = "/tmp/birdflock-check-" + std::to_string(getpid()) + ".bftr";
+    Scenario scenario = makeScenario(1200, 800, 400, 200, 5, 2);
+    Flock flock;
+    scenario.apply(&flock);
+
+    TrajectoryRecorder recorder;
+    if(!recorder.open(path, flock.getWorldWidth(), flock.getWorldHeight(), 16)){
+        *problem = "couldn't create " + path;
+        return false;
+    }
+    flock.setRecorder(&recorder);
+    std::vector<TrajectoryFrame> expected(ticks);
+    for(int tick=0; tick<ticks; tick++){
+        flock.simulateFlock();
+        TrajectoryRecorder::quantiseFlock(&flock, &expected[tick]);
+    }
+    flock.setRecorder(0);
+    recorder.close();
+
+    TrajectoryReader reader;
+    bool same = reader.open(path);
+    if(!same) *problem = "couldn't read " + path;
+    if(same && reader.getFrameCount() + recorder.getDroppedFrames() != ticks){
+        *problem = std::to_string(reader.getFrameCount()) + " frames read back, " + std::to_string(recorder.getDroppedFrames()) + " dropped, of " + std::to_string(ticks);
+        same = false;
+    }
+    for(int frame=reader.getFrameCount()-1; same && frame>=0; frame--){
+        const TrajectoryFrame* read = reader.readFrame(frame);
+        const TrajectoryFrame* recorded = 0;
+        for(int tick=0; tick<ticks && !recorded; tick++){
+            if(read && expected[tick].tick == read->tick) recorded = &expected[tick];
+        }
+        if(!recorded || read->ids != recorded->ids || read->species != recorded->species || read->x != recorded->x ||
+           read->y != recorded->y || read->vx != recorded->vx || read->vy != recorded->vy){
+            *problem = "frame " + std::to_string(frame) + " differs";
+            same = false;
+        }
+    }
+    reader.close();
+    remove(path.c_str());
+    return same;
+}
+
+//runs the same scenario with 1, 2, 4 and 7 threads, with Predators so the claims are settled between threads too
+static bool checkThreads(int ticks, std::string* problem){
+    const int threadCounts[] = {1, 2, 4, 7};
+    Checkpoint expected;
+    runScenario(makeScenario(1200, 800, 1500, 750, 40, 1), ticks, &expected);
+    for(int i=1; i<sizeof(threadCounts)/sizeof(threadCounts[0]); i++){
+        Checkpoint actual;
+        runScenario(makeScenario(1200, 800, 1500, 750, 40, threadCounts[i]), ticks, &actual);
+        if(!compareCheckpoints(expected, actual, problem)){
+            *problem = std::to_string(threadCounts[i]) + " threads: " + *problem;
+            return false;
+        }
+    }
+    return true;
+}
+
+//runs the same scenario never reordering the Birds and checking every few ticks
+static bool checkReorder(int ticks, std::string* problem){
+    Scenario scenario = makeScenario(1200, 800, 1500, 750, 40, 2);
+    scenario.setSetting("reorder_interval", 0);
+    Checkpoint expected;
+    runScenario(scenario, ticks, &expected);
+
+    scenario.setSetting("reorder_interval", 5);
+    Checkpoint actual;
+    if(runScenario(scenario, ticks, &actual) == 0){
+        *problem = "the birds were never reordered";
+        return false;
+    }
+    return compareCheckpoints(expected, actual, problem);
+}
+
+/* checkClaims
+ *
+ * Runs a small world crowded with Predators, so many Birds are caught by several at once. After
+ * every tick, the hunger each Predator lost must be at most one, and add up to the Birds eaten.
+ *
+ * inputs:
+ * - ticks: ticks to run
+ * - problem: set to what went wrong
+ *
+ * return: true if no Bird was eaten twice or by no one, and some were eaten
+ */
+static bool checkClaims(int ticks, std::string* problem){
+    Flock flock;
+    makeScenario(400, 400, 3000, 0, 1500, 4).apply(&flock);
+    std::map<int, int> hunger;
+    long long eaten = 0;
+    for(int tick=0; tick<ticks; tick++){
+        hunger.clear();
+        for(int i=0; i<flock.getBirds()->size(); i++){
+            Predator* p = dynamic_cast<Predator*>(flock.getBirds()->at(i));
+            if(p && !p->getIsDead()) hunger[p->getId()] = p->getHunger();
+        }
+        flock.simulateFlock();
+
+        //the Birds eaten this tick are only removed at the start of the next
+        int eatenNow = 0, hungerLost = 0;
+        for(int i=0; i<flock.getBirds()->size(); i++){
+            Bird* b = flock.getBirds()->at(i);
+            Predator* p = dynamic_cast<Predator*>(b);
+            if(b->getWasEaten()) eatenNow++;
+            if(!p || !hunger.count(p->getId())) continue;
+            int lost = hunger[p->getId()] - p->getHunger();
+            if(lost < 0 || lost > 1){
+                *problem = "predator " + std::to_string(p->getId()) + " ate " + std::to_string(lost) + " birds in tick " + std::to_string(tick);
+                return false;
+            }
+            hungerLost += lost;
+        }
+        if(eatenNow != hungerLost){
+            *problem = std::to_string(eatenNow) + " birds eaten in tick " + std::to_string(tick) + ", but predators ate " + std::to_string(hungerLost);
+            return false;
+        }
+        eaten += eatenNow;
+    }
+    if(eaten == 0){
+        *problem = "no bird was eaten";
+        return false;
+    }
+    return true;
+}
+
+/* compareTiles
+ *
+ * Runs a scenario split into 2 by 2 tiles, each on its own thread and connected by Unix sockets,
+ * and the same scenario in one Flock.
+ *
+ * inputs:
+ * - scenario: the scenario, which must use one thread
+ * - ticks: ticks to run
+ * - problem: set to what went wrong
+ *
+ * return: true if the tiles end with exactly the Birds one Flock ends with
+ */
+static bool compareTiles(const Scenario& scenario, int ticks, std::string* problem){
+    const int tilesX = 2, tilesY = 2, tiles = tilesX*tilesY;
+    std::string spec = "unix:/tmp/birdflock-check-" + std::to_string(getpid());
+
+    std::vector<std::vector<CheckpointBird> > birds(tiles);
+    std::vector<std::string> errors(tiles);
+    std::vector<std::thread> threads;
+    for(int rank=0; rank<tiles; rank++){
+        threads.push_back(std::thread([&, rank](){
+            TileTransport* transport = TileTransport::create(spec, rank, tiles, DistributedFlock::getNeighbourRanks(rank, tilesX, tilesY), &errors[rank]);
+            if(!transport) return;
+            DistributedFlock* tile = new DistributedFlock(transport, tilesX, tilesY);
+            bool succeeded = tile->setup(scenario);
+            for(int tick=0; succeeded && tick<ticks; tick++){
+                succeeded = tile->simulate();
+            }
+            if(!succeeded) errors[rank] = tile->getError();
+            std::vector<Bird*>* own = tile->getFlock()->getBirds();
+            for(int i=0; i<own->size(); i++){
+                if(own->at(i)->getIsDead()) continue;
+                CheckpointBird saved;
+                Flock::saveBird(own->at(i), &saved);
+                birds[rank].push_back(saved);
+            }
+            delete tile;
+            delete transport;
+        }));
+    }
+    for(int rank=0; rank<tiles; rank++){
+        threads[rank].join();
+    }
+    for(int rank=0; rank<tiles; rank++){
+        if(!errors[rank].empty()){
+            *problem = "rank " + std::to_string(rank) + ": " + errors[rank];
+            return false;
+        }
+    }
+
+    std::vector<CheckpointBird> actual;
+    for(int rank=0; rank<tiles; rank++){
+        actual.insert(actual.end(), birds[rank].begin(), birds[rank].end());
+    }
+    std::sort(actual.begin(), actual.end(), [](const CheckpointBird& a, const CheckpointBird& b){return a.id < b.id;});
+
+    Flock flock;
+    scenario.apply(&flock);
+    for(int tick=0; tick<ticks; tick++){
+        flock.simulateFlock();
+    }
+    std::vector<CheckpointBird> expected;
+    for(int i=0; i<flock.getBirds()->size(); i++){
+        Bird* b = flock.getBirds()->at(i);
+        if(b->getIsDead()) continue;
+        CheckpointBird saved;
+        Flock::saveBird(b, &saved);
+        expected.push_back(saved);
+    }
+
+    if(expected.size() != actual.size()){
+        *problem = std::to_string(actual.size()) + " birds in the tiles, not " + std::to_string(expected.size());
+        return false;
+    }
+    for(int i=0; i<expected.size(); i++){
+        if(!sameBird(expected[i], actual[i])){
+            *problem = "bird " + std::to_string(expected[i].id) + " differs";
+            return false;
+        }
+    }
+    return true;
+}
+
+//runs the same crowded world as checkClaims in tiles, where Birds near the edges are caught by Predators in other tiles
+static bool checkTiles(int ticks, std::string* problem){
+    return compareTiles(makeScenario(400, 400, 3000, 0, 1500, 1), ticks, problem);
+}
+
+/* checkIntervals
+ *
+ * Works out the slow behaviours only every few ticks (see Flock::setBehaviourInterval), and checks
+ * that the result is still the same with 1 or 3 threads, restored from a checkpoint half way, and
+ * split into tiles, where Birds handed over carry the forces they keep in between.
+ *
+ * inputs:
+ * - ticks: ticks to run
+ * - problem: set to what went wrong
+ *
+ * return: true if every run ends exactly the same
+ */
+static bool checkIntervals(int ticks, std::string* problem){
+    Scenario scenario = makeScenario(800, 600, 1500, 1500, 20, 1);
+    scenario.setSetting("cohesion_interval", 4);
+    scenario.setSetting("alignment_interval", 4);
+    scenario.setSetting("avoid_predator_interval", 3);
+    Checkpoint expected;
+    runScenario(scenario, ticks, &expected);
+
+    Scenario threaded = scenario;
+    threaded.setThreads(3);
+    Checkpoint actual;
+    runScenario(threaded, ticks, &actual);
+    if(!compareCheckpoints(expected, actual, problem)){
+        *problem = "3 threads: " + *problem;
+        return false;
+    }
+
+    Checkpoint half;
+    runScenario(scenario, ticks/2, &half);
+    Flock restored;
+    restored.restoreCheckpoint(&half);
+    scenario.applySettings(&restored);
+    for(int tick=ticks/2; tick<ticks; tick++){
+        restored.simulateFlock();
+    }
+    restored.saveCheckpoint(&actual);
+    if(!compareCheckpoints(expected, actual, problem)){
+        *problem = "restored: " + *problem;
+        return false;
+    }
+
+    if(!compareTiles(scenario, ticks, problem)){
+        *problem = "tiles: " + *problem;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    int ticks = kDefaultTicks;
+    for(int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--ticks" && i+1 < argc){
+            ticks = atoi(argv[++i]);
+        }
+        else{
+            printUsage();
+            return 2;
+        }
+    }
+    if(ticks <= 0){
+        printUsage();
+        return 2;
+    }
+
+    struct Check{
+        const char* name;
+        bool (*run)(int, std::string*);
+    };
+    const Check checks[] = {
+        {"trajectory", checkTrajectory},
+        {"threads", checkThreads},
+        {"reorder", checkReorder},
+        {"claims", checkClaims},
+        {"tiles", checkTiles},
+        {"intervals", checkIntervals}
+    };
+
+    int failed = 0;
+    for(int i=0; i<sizeof(checks)/sizeof(checks[0]); i++){
+        std::string problem;
+        bool passed = checks[i].run(ticks, &problem);
+        std::cout << checks[i].name << ": " << (passed ? "ok" : "FAILED, " + problem) << std::endl;
+        if(!passed) failed++;
+    }
+    if(failed > 0) std::cout << failed << " checks failed" << std::endl;
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+/* Checkpoint.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for Checkpoint and CheckpointWriter, which save complete copies of the state of a
+ * Flock to a file and read them back.
+ */
+#include "Checkpoint.h"
+#include "Flock.h"
+#include "Bird.h"
+#include <cstdio>
+#include <cstring>
+
+static_assert(kCheckpointSpecies == kOtherSpecies, "checkpoints keep totals for every species");
+static_assert(kCheckpointSlowBehaviours == kSlowBehaviours, "checkpoints keep the force of every slow behaviour");
+
+//Constructor
+Checkpoint::Checkpoint(){
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kCheckpointMagic, 4);
+    header.version = kCheckpointVersion;
+}
+
+/* write
+ *
+ * Writes the header and both arrays to a file. The checkpoint is written to a temporary file
+ * which is then renamed over path, so a crash while saving never leaves a half written
+ * checkpoint in place of the last good one.
+ *
+ * inputs:
+ * - path: file to write
+ *
+ * return: true if the whole checkpoint was written
+ */
+bool Checkpoint::write(std::string path)const{
+    std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if(!file) return false;
+
+    CheckpointHeader out = header;
+    out.birdCount = birds.size();
+    out.obstacleCount = obstacles.size();
+
+    bool ok = fwrite(&out, sizeof(out), 1, file) == 1;
+    if(ok && !birds.empty()) ok = fwrite(birds.data(), sizeof(CheckpointBird), birds.size(), file) == birds.size();
+    if(ok && !obstacles.empty()) ok = fwrite(obstacles.data(), sizeof(CheckpointObstacle), obstacles.size(), file) == obstacles.size();
+    ok = (fclose(file) == 0) && ok;
+
+    if(!ok || rename(tempPath.c_str(), path.c_str()) != 0){
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/* read
+ *
+ * Reads a checkpoint file written by write(). Each array is read with a single fread.
+ *
+ * inputs:
+ * - path: file to read
+ *
+ * return: true if the file is a complete checkpoint of this version
+ */
+bool Checkpoint::read(std::string path){
+    FILE* file = fopen(path.c_str(), "rb");
+    if(!file) return false;
+
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+            memcmp(header.magic, kCheckpointMagic, 4) == 0 && header.version == kCheckpointVersion;
+    if(ok){
+        birds.resize(header.birdCount);
+        obstacles.resize(header.obstacleCount);
+        if(!birds.empty()) ok = fread(birds.data(), sizeof(CheckpointBird), birds.size(), file) == birds.size();
+        if(ok && !obstacles.empty()) ok = fread(obstacles.data(), sizeof(CheckpointObstacle), obstacles.size(), file) == obstacles.size();
+    }
+    fclose(file);
+
+    if(!ok){
+        *this = Checkpoint();
+    }
+    return ok;
+}
+
+//Constructor
+CheckpointWriter::CheckpointWriter() : fSaving(false), fSucceeded(true){}
+
+//Deconstructor
+CheckpointWriter::~CheckpointWriter(){
+    wait();
+}
+
+/* save
+ *
+ * Copies the flock into fCheckpoint, then writes it on a background thread. Only the copy
+ * happens on the calling thread, so the simulation can carry on straight away.
+ *
+ * inputs:
+ * - flock: the Flock to save
+ * - path: file to save it to
+ *
+ * return: true if the save was started
+ */
+bool CheckpointWriter::save(Flock* flock, std::string path){
+    if(fSaving) return false;
+    if(fWriter.joinable()) fWriter.join();
+
+    flock->saveCheckpoint(&fCheckpoint);
+    fPath = path;
+    fSaving = true;
+    fWriter = std::thread(&CheckpointWriter::writeCheckpoint, this);
+    return true;
+}
+
+//waits for the background thread to finish writing
+bool CheckpointWriter::wait(){
+    if(fWriter.joinable()) fWriter.join();
+    return fSucceeded;
+}
+
+//run by the background thread
+void CheckpointWriter::writeCheckpoint(){
+    fSucceeded = fCheckpoint.write(fPath);
+    fSaving = false;
+}
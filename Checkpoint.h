@@ -0,0 +1,137 @@
+/* Checkpoint.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for checkpoints, complete copies of the state of a Flock that can be saved to a file
+ * and restored later, so a long simulation can carry on after a crash or a restart without having
+ * to warm up again. A Checkpoint stores every living Bird (including its own copy of the parameters
+ * of its species, the hunger of Predators and the last forces of its slow behaviours, see
+ * Flock::setBehaviourInterval), every Obstacle, the size of the world, the tick and id counters of
+ * the Flock, the totals of Birds born, died and eaten (see FlockCounters) and the state of its
+ * random numbers. Flock::saveCheckpoint fills one in and Flock::restoreCheckpoint puts it back.
+ *
+ * A checkpoint file is a CheckpointHeader followed by the array of CheckpointBirds and the array of
+ * CheckpointObstacles. All structs are fixed size, so each array is written and read in one go.
+ * CheckpointWriter saves a Checkpoint on a background thread, so the simulation only has to wait
+ * for the Flock to be copied, not for the disk.
+ */
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+
+//magic number at the start of the file, and the version of the format
+const char kCheckpointMagic[4] = {'B','F','C','P'};
+const uint32_t kCheckpointVersion = 4;
+
+//number of species the totals are kept for, which is kOtherSpecies (see Bird.h)
+const int kCheckpointSpecies = 3;
+
+//number of slow behaviours whose last forces are kept for each Bird, which is kSlowBehaviours (see Bird.h)
+const int kCheckpointSlowBehaviours = 3;
+
+//start of the file
+struct CheckpointHeader{
+    char magic[4];//kCheckpointMagic
+    uint32_t version;//kCheckpointVersion
+    int32_t worldWidth;
+    int32_t worldHeight;
+    int64_t tick;//ticks simulated so far
+    int32_t nextId;//id the Flock will give the next Bird added
+    uint32_t birdCount;
+    uint32_t obstacleCount;
+    uint32_t reserved;
+    uint64_t seed;//seed of the random numbers of the Flock
+    uint64_t randomCounter;//number of values used from the spawning stream
+    int64_t born[kCheckpointSpecies];//totals of FlockCounters, by Species
+    int64_t died[kCheckpointSpecies];
+    int64_t eaten[kCheckpointSpecies];
+};
+
+//one Bird or Predator
+struct CheckpointBird{
+    int32_t id;
+    int32_t species;//Species id of the colour of the Bird
+    int32_t hunger;//hunger of a Predator, or -1 for normal Birds
+    int32_t separationDistance;
+    int32_t detectionDistance;
+    int32_t knownForces;//mask of the slow behaviours the Bird has worked out, whose forces follow
+    double x;
+    double y;
+    double vx;
+    double vy;
+    double heading;
+    double maxSpeed;
+    double separationStrength;
+    double cohesionStrength;
+    double alignmentStrength;
+    double avoidPredatorStrength;
+    double slowForces[kCheckpointSlowBehaviours][2];//last x and y of each slow behaviour's force
+};
+
+//one Obstacle
+struct CheckpointObstacle{
+    double x;
+    double y;
+    int32_t radius;
+    int32_t reserved;
+};
+
+class Checkpoint
+{
+public:
+
+    //Constructor. Makes an empty checkpoint.
+    Checkpoint();
+
+    //writes the checkpoint to a file. Returns false if the file couldn't be written.
+    bool write(std::string path)const;
+
+    //reads a checkpoint file. Returns false if it isn't a valid checkpoint file.
+    bool read(std::string path);
+
+    /* Data members are public, as Checkpoint is only a container that Flock fills in and
+     * reads back. birds and obstacles are kept in the same order as in the Flock. */
+    CheckpointHeader header;
+    std::vector<CheckpointBird> birds;
+    std::vector<CheckpointObstacle> obstacles;
+};
+
+class Flock;
+
+class CheckpointWriter
+{
+public:
+
+    //Constructor
+    CheckpointWriter();
+
+    //Deconstructor. Waits for a save that is still being written.
+    virtual ~CheckpointWriter();
+
+    /* Copies the flock into a Checkpoint and starts writing it to path on a background thread.
+     * Returns false without copying anything if the previous save is still being written. */
+    bool save(Flock* flock, std::string path);
+
+    //waits for the current save to finish. Returns true if the last save was written successfully.
+    bool wait();
+
+    inline bool const isSaving()const{return fSaving;}
+
+private:
+
+    //run by the background thread to write fCheckpoint
+    void writeCheckpoint();
+
+    Checkpoint fCheckpoint;//only touched by the background thread while fSaving is true
+    std::string fPath;
+    std::thread fWriter;
+    std::atomic<bool> fSaving;
+    bool fSucceeded;
+};
+
+#endif // CHECKPOINT_H
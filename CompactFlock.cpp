@@ -0,0 +1,431 @@
+/* CompactFlock.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for CompactFlock. The rules are the same as in Bird.cpp and Predator.cpp; see there for
+ * why each behaviour works the way it does.
+ */
+#include "CompactFlock.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <algorithm>
+
+const float CompactFlock::kMaxForce = 0.07f;
+
+//rounds to the nearest step, and keeps it in the range a 16 bit velocity can hold
+static inline int16_t quantiseVelocity(float v, float step){
+    float steps = std::floor(v/step + 0.5f);
+    steps = std::max(-(float)CompactFlock::kVelocitySteps, std::min((float)CompactFlock::kVelocitySteps, steps));
+    return (int16_t)steps;
+}
+
+/* steer
+ *
+ * The steering force of a behaviour, as in Bird: the change of velocity that would take the Bird to
+ * max speed in the direction of (dx, dy), limited to kMaxForce.
+ *
+ * inputs:
+ * - dx, dy: direction the behaviour wants to go in, of any length
+ * - maxSpeed: max speed of the Bird
+ * - vx, vy: velocity of the Bird
+ * - maxForce: largest force allowed
+ * - fx, fy: set to the force
+ */
+static inline void steer(float dx, float dy, float maxSpeed, float vx, float vy, float maxForce, float* fx, float* fy){
+    float length2 = dx*dx + dy*dy;
+    float scale = length2 > 0 ? maxSpeed/std::sqrt(length2) : 0;
+    float sx = dx*scale - vx, sy = dy*scale - vy;
+    float steer2 = sx*sx + sy*sy;
+    if(steer2 > maxForce*maxForce){
+        float limit = maxForce/std::sqrt(steer2);
+        sx *= limit;
+        sy *= limit;
+    }
+    *fx = sx;
+    *fy = sy;
+}
+
+/* Constructor
+ *
+ * Works out the size of the tiles, and how many tiles around its own each species has to search to
+ * find every neighbour. Smaller tiles mean fewer Birds are looked at that turn out to be too far
+ * away, but more tiles to go through.
+ *
+ * inputs:
+ * - worldWidth, worldHeight: size of the world
+ * - params: settings of each species
+ * - threadCount: threads to simulate with, 0 for one per core
+ */
+CompactFlock::CompactFlock(int worldWidth, int worldHeight, const SpeciesParams params[kOtherSpecies], int threadCount){
+    fWorldWidth = worldWidth;
+    fWorldHeight = worldHeight;
+    fTick = 0;
+
+    int shortest = 0, longest = 1;
+    double fastest = 0;
+    for(int s=0; s<kOtherSpecies; s++){
+        fParams[s] = params[s];
+        fCount[s] = 0;
+        int reach = std::max(1, std::max(params[s].separationDistance, params[s].detectionDistance));
+        shortest = shortest == 0 ? reach : std::min(shortest, reach);
+        longest = std::max(longest, reach);
+        fastest = std::max(fastest, params[s].maxSpeed);
+    }
+    fTileSize = std::max(shortest, (longest + 3)/4);
+    fColumns = std::max(1, (worldWidth + fTileSize - 1)/fTileSize);
+    fRows = std::max(1, (worldHeight + fTileSize - 1)/fTileSize);
+    fPositionStep = (double)fTileSize/kPositionSteps;
+    fVelocityStep = fastest > 0 ? fastest/kVelocitySteps : 1;
+
+    for(int s=0; s<kOtherSpecies; s++){
+        SpeciesSteps& steps = fSteps[s];
+        double separation = params[s].separationDistance/fPositionStep;
+        double detection = params[s].detectionDistance/fPositionStep;
+        steps.maxSpeed = params[s].maxSpeed;
+        steps.separation2 = (int64_t)(separation*separation);
+        steps.detection2 = (int64_t)(detection*detection);
+        steps.reach2 = std::max(steps.separation2, steps.detection2);
+        steps.tiles = (std::max(params[s].separationDistance, params[s].detectionDistance) + fTileSize - 1)/fTileSize;
+        steps.separationStrength = params[s].separationStrength;
+        steps.cohesionStrength = params[s].cohesionStrength;
+        steps.alignmentStrength = params[s].alignmentStrength;
+        steps.avoidPredatorStrength = params[s].avoidPredatorStrength;
+    }
+
+    fTileStart.assign(fColumns*fRows + 1, 0);
+    fThreadPool = new ThreadPool(threadCount);
+}
+
+//Deconstructor
+CompactFlock::~CompactFlock(){
+    delete fThreadPool;
+}
+
+/* spawn
+ *
+ * Adds Birds at random positions and headings, drawn in a fixed order from random, as
+ * Flock::spawnBatch does. The Birds already in the flock are put into the second set of arrays
+ * with the new ones after them, and all of them are sorted into tiles.
+ *
+ * inputs:
+ * - species: Species id of the new Birds
+ * - n: number of Birds to add
+ * - random: stream to draw the positions and headings from
+ *
+ * return: the number of Birds added
+ */
+int CompactFlock::spawn(int species, int n, Random* random){
+    if(n <= 0 || species < 0 || species >= kOtherSpecies) return 0;
+    int old = fX.size();
+    int count = old + n;
+    fNewX.reserve(count);
+    fNewY.reserve(count);
+    fNewVX.reserve(count);
+    fNewVY.reserve(count);
+    fNewSpecies.reserve(count);
+    fNewTile.reserve(count);
+    fNewX.resize(count);
+    fNewY.resize(count);
+    fNewVX.resize(count);
+    fNewVY.resize(count);
+    fNewSpecies.resize(count);
+    fNewTile.resize(count);
+
+    for(int tile=0; tile<fColumns*fRows; tile++){
+        for(uint32_t i=fTileStart[tile]; i<fTileStart[tile+1]; i++){
+            fNewX[i] = fX[i];
+            fNewY[i] = fY[i];
+            fNewVX[i] = fVX[i];
+            fNewVY[i] = fVY[i];
+            fNewSpecies[i] = fSpecies[i];
+            fNewTile[i] = tile;
+        }
+    }
+
+    float speed = fParams[species].maxSpeed;
+    float step = fVelocityStep;
+    for(int i=old; i<count; i++){
+        double x = random->uniform(0, fWorldWidth);
+        double y = random->uniform(0, fWorldHeight);
+        double heading = random->uniformInt(360)*M_PI/180.;
+        int64_t px = (int64_t)(x/fPositionStep), py = (int64_t)(y/fPositionStep);
+        fNewX[i] = (uint16_t)(px % kPositionSteps);
+        fNewY[i] = (uint16_t)(py % kPositionSteps);
+        fNewVX[i] = quantiseVelocity(speed*std::cos(heading), step);
+        fNewVY[i] = quantiseVelocity(speed*std::sin(heading), step);
+        fNewSpecies[i] = species;
+        fNewTile[i] = (py/kPositionSteps)*fColumns + px/kPositionSteps;
+    }
+
+    sortIntoTiles(count);
+    return fX.size() - old;
+}
+
+/* simulate
+ *
+ * Works out the new state of every Bird, one tile at a time on the threads of fThreadPool, then
+ * sorts the Birds by the tiles they have moved to. Every Bird only reads the first set of arrays
+ * and only writes its own entry in the second, so the result doesn't depend on the threads.
+ */
+void CompactFlock::simulate(){
+    int count = fX.size();
+    fNewX.resize(count);
+    fNewY.resize(count);
+    fNewVX.resize(count);
+    fNewVY.resize(count);
+    fNewSpecies.resize(count);
+    fNewTile.resize(count);
+
+    fThreadPool->parallelFor(fColumns*fRows, kTilesPerChunk, [this](int begin, int end, int){
+        for(int tile=begin; tile<end; tile++){
+            updateTile(tile);
+        }
+    });
+
+    sortIntoTiles(count);
+    fTick++;
+}
+
+/* updateTile
+ *
+ * Applies the rules of Bird::update, or Predator::update for predators, to each Bird in a tile. The
+ * displacement to each Bird in the tiles around it is worked out in position steps, as the
+ * difference of the tiles times kPositionSteps plus the difference of the positions in them, and
+ * compared with the distances the species cares about without ever leaving integers. Cohesion and
+ * alignment add up whole steps, which is exact; separation, avoiding predators and the final
+ * velocity are worked out in float. The Bird is then moved by its new velocity, rounded to steps,
+ * and given the tile it ends up in, or deadTile() if it has left the world.
+ *
+ * inputs:
+ * - tile: index of the tile, row by row
+ */
+void CompactFlock::updateTile(int tile){
+    int column = tile % fColumns, row = tile / fColumns;
+    float positionStep = fPositionStep;
+    float velocityStep = fVelocityStep;
+    int64_t worldX = (int64_t)std::ceil(fWorldWidth/fPositionStep);
+    int64_t worldY = (int64_t)std::ceil(fWorldHeight/fPositionStep);
+
+    for(uint32_t i=fTileStart[tile]; i<fTileStart[tile+1]; i++){
+        int species = fSpecies[i];
+        const SpeciesSteps& steps = fSteps[species];
+        bool predator = species == kRed;
+        int32_t x = fX[i], y = fY[i];
+        float vx = fVX[i]*velocityStep, vy = fVY[i]*velocityStep;
+
+        //sums over the neighbours of each behaviour
+        int64_t cohesionX = 0, cohesionY = 0;
+        int cohesionCount = 0;
+        float separationX = 0, separationY = 0;
+        int separationCount = 0;
+        int64_t alignmentX = 0, alignmentY = 0;
+        int alignmentCount = 0;
+        float predatorX = 0, predatorY = 0;
+        int predatorCount = 0;
+        int64_t nearestPrey2 = steps.detection2;
+        int32_t preyX = 0, preyY = 0;
+        bool foundPrey = false;
+
+        for(int r=std::max(0, row-steps.tiles); r<=std::min(fRows-1, row+steps.tiles); r++){
+            for(int c=std::max(0, column-steps.tiles); c<=std::min(fColumns-1, column+steps.tiles); c++){
+                int other = r*fColumns + c;
+                int32_t offsetX = (c - column)*kPositionSteps - x;
+                int32_t offsetY = (r - row)*kPositionSteps - y;
+                for(uint32_t j=fTileStart[other]; j<fTileStart[other+1]; j++){
+                    int32_t dx = offsetX + fX[j], dy = offsetY + fY[j];
+                    int64_t distance2 = (int64_t)dx*dx + (int64_t)dy*dy;
+                    if(distance2 == 0 || distance2 >= steps.reach2) continue;
+
+                    int otherSpecies = fSpecies[j];
+                    bool same = otherSpecies == species;
+                    if(distance2 < steps.detection2){
+                        if(same){
+                            cohesionX += dx;
+                            cohesionY += dy;
+                            cohesionCount++;
+                        }
+                        //the displacement over the distance squared is the unit vector over the distance
+                        if(otherSpecies == kRed && !predator){
+                            float inverse = 1.f/distance2;
+                            predatorX -= dx*inverse;
+                            predatorY -= dy*inverse;
+                            predatorCount++;
+                        }
+                        if(predator && otherSpecies != kRed && distance2 < nearestPrey2){
+                            nearestPrey2 = distance2;
+                            preyX = dx;
+                            preyY = dy;
+                            foundPrey = true;
+                        }
+                    }
+                    if(distance2 < steps.separation2){
+                        float inverse = 1.f/distance2;
+                        separationX -= dx*inverse;
+                        separationY -= dy*inverse;
+                        separationCount++;
+                        if(same){
+                            alignmentX += fVX[j];
+                            alignmentY += fVY[j];
+                            alignmentCount++;
+                        }
+                    }
+                }
+            }
+        }
+
+        //steering forces, weighted as in Bird::update and Predator::update
+        float forceX = 0, forceY = 0, fx, fy;
+        if(separationCount > 0){
+            steer(separationX, separationY, steps.maxSpeed, vx, vy, kMaxForce, &fx, &fy);
+            float weight = predator ? 1 : steps.separationStrength;
+            forceX += fx*weight;
+            forceY += fy*weight;
+        }
+        if(!predator){
+            if(cohesionCount > 0){
+                steer((float)cohesionX, (float)cohesionY, steps.maxSpeed, vx, vy, kMaxForce, &fx, &fy);
+                forceX += fx*steps.cohesionStrength;
+                forceY += fy*steps.cohesionStrength;
+            }
+            if(alignmentCount > 0){
+                steer((float)alignmentX, (float)alignmentY, steps.maxSpeed, vx, vy, kMaxForce, &fx, &fy);
+                forceX += fx*steps.alignmentStrength;
+                forceY += fy*steps.alignmentStrength;
+            }
+            if(predatorCount > 0){
+                steer(predatorX, predatorY, steps.maxSpeed, vx, vy, kMaxForce, &fx, &fy);
+                forceX += fx*steps.avoidPredatorStrength;
+                forceY += fy*steps.avoidPredatorStrength;
+            }
+        }
+        else if(foundPrey){
+            steer((float)preyX, (float)preyY, steps.maxSpeed, vx, vy, kMaxForce, &fx, &fy);
+            forceX += fx*3;
+            forceY += fy*3;
+        }
+
+        //avoid the walls, as in Bird::avoidWalls
+        float worldPositionX = ((int64_t)column*kPositionSteps + x)*positionStep;
+        float worldPositionY = ((int64_t)row*kPositionSteps + y)*positionStep;
+        float wallX = 0, wallY = 0;
+        if(worldPositionY < fWorldHeight/10.f) wallY = 1/worldPositionY;
+        else if(worldPositionY > 9*fWorldHeight/10.f) wallY = -1/(fWorldHeight - worldPositionY);
+        if(worldPositionX < fWorldWidth/10.f) wallX = 1/worldPositionX;
+        else if(worldPositionX > 9*fWorldWidth/10.f) wallX = -1/(fWorldWidth - worldPositionX);
+        float wallWeight = predator ? 4 : 5;
+        forceX += wallX*wallWeight;
+        forceY += wallY*wallWeight;
+
+        //apply the force as in Bird::applyForce
+        float newVX, newVY;
+        if(forceX == 0 && forceY == 0){
+            newVX = vx*1.01f;
+            newVY = vy*1.01f;
+        }
+        else{
+            newVX = vx + forceX;
+            newVY = vy + forceY;
+        }
+        float speed2 = newVX*newVX + newVY*newVY;
+        if(speed2 > steps.maxSpeed*steps.maxSpeed){
+            float limit = steps.maxSpeed/std::sqrt(speed2);
+            newVX *= limit;
+            newVY *= limit;
+        }
+        int16_t qx = quantiseVelocity(newVX, velocityStep);
+        int16_t qy = quantiseVelocity(newVY, velocityStep);
+
+        //move by the velocity as it will be stored, so the position and velocity agree
+        int64_t px = (int64_t)column*kPositionSteps + x + (int64_t)std::floor(qx*velocityStep/positionStep + 0.5f);
+        int64_t py = (int64_t)row*kPositionSteps + y + (int64_t)std::floor(qy*velocityStep/positionStep + 0.5f);
+        bool dead = px < 0 || py < 0 || px >= worldX || py >= worldY;
+        fNewX[i] = (uint16_t)(px & (kPositionSteps - 1));
+        fNewY[i] = (uint16_t)(py & (kPositionSteps - 1));
+        fNewVX[i] = qx;
+        fNewVY[i] = qy;
+        fNewSpecies[i] = species;
+        fNewTile[i] = dead ? deadTile() : (uint32_t)((py/kPositionSteps)*fColumns + px/kPositionSteps);
+    }
+}
+
+/* sortIntoTiles
+ *
+ * A counting sort of the second set of arrays into the first by tile. It is stable, so the Birds of
+ * a tile stay in the same order from tick to tick, and those that moved in come after those from
+ * lower tiles. Dead Birds are counted into deadTile(), which comes last, and are left off the end.
+ *
+ * inputs:
+ * - count: number of Birds in the second set of arrays
+ */
+void CompactFlock::sortIntoTiles(int count){
+    int tiles = fColumns*fRows;
+    fTileStart.assign(tiles + 2, 0);
+    for(int i=0; i<count; i++){
+        fTileStart[fNewTile[i] + 1]++;
+    }
+    for(int tile=0; tile<=tiles; tile++){
+        fTileStart[tile + 1] += fTileStart[tile];
+    }
+
+    int alive = fTileStart[tiles];
+    fX.reserve(alive);
+    fY.reserve(alive);
+    fVX.reserve(alive);
+    fVY.reserve(alive);
+    fSpecies.reserve(alive);
+    fX.resize(alive);
+    fY.resize(alive);
+    fVX.resize(alive);
+    fVY.resize(alive);
+    fSpecies.resize(alive);
+    for(int s=0; s<kOtherSpecies; s++) fCount[s] = 0;
+
+    //fTileStart[tile] is moved along as each Bird is placed, ending at the start of the next tile
+    for(int i=0; i<count; i++){
+        uint32_t tile = fNewTile[i];
+        if(tile == (uint32_t)tiles) continue;
+        uint32_t to = fTileStart[tile]++;
+        fX[to] = fNewX[i];
+        fY[to] = fNewY[i];
+        fVX[to] = fNewVX[i];
+        fVY[to] = fNewVY[i];
+        fSpecies[to] = fNewSpecies[i];
+        fCount[fNewSpecies[i]]++;
+    }
+
+    //shift back to the starts, with the number of Birds after the last tile
+    for(int tile=tiles; tile>0; tile--){
+        fTileStart[tile] = fTileStart[tile - 1];
+    }
+    fTileStart[0] = 0;
+    fTileStart.resize(tiles + 1);
+}
+
+/* getBird
+ *
+ * inputs:
+ * - i: index of the Bird, in tile order
+ * - x, y: set to its position
+ * - vx, vy: set to its velocity
+ */
+void CompactFlock::getBird(int i, double* x, double* y, double* vx, double* vy)const{
+    int tile = std::upper_bound(fTileStart.begin(), fTileStart.end(), (uint32_t)i) - fTileStart.begin() - 1;
+    *x = ((double)(tile % fColumns)*kPositionSteps + fX[i])*fPositionStep;
+    *y = ((double)(tile / fColumns)*kPositionSteps + fY[i])*fPositionStep;
+    *vx = fVX[i]*fVelocityStep;
+    *vy = fVY[i]*fVelocityStep;
+}
+
+//bytes of the first set of arrays, which hold the Birds between ticks
+size_t CompactFlock::getStateBytes()const{
+    return fX.size()*(sizeof(uint16_t)*2 + sizeof(int16_t)*2 + sizeof(uint8_t)) + fTileStart.size()*sizeof(uint32_t);
+}
+
+//bytes allocated by both sets of arrays
+size_t CompactFlock::getAllocatedBytes()const{
+    return fX.capacity()*sizeof(uint16_t) + fY.capacity()*sizeof(uint16_t) + fVX.capacity()*sizeof(int16_t) +
+           fVY.capacity()*sizeof(int16_t) + fSpecies.capacity() + fTileStart.capacity()*sizeof(uint32_t) +
+           fNewX.capacity()*sizeof(uint16_t) + fNewY.capacity()*sizeof(uint16_t) + fNewVX.capacity()*sizeof(int16_t) +
+           fNewVY.capacity()*sizeof(int16_t) + fNewSpecies.capacity() + fNewTile.capacity()*sizeof(uint32_t);
+}
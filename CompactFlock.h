@@ -0,0 +1,142 @@
+/* CompactFlock.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for CompactFlock, a flock stored in as few bytes per Bird as possible, for worlds of
+ * millions of Birds. A Flock keeps every Bird as an object on the heap, with a vtable, a colour
+ * string and its settings, which comes to a couple of hundred bytes a Bird. A CompactFlock keeps
+ * only what changes from tick to tick, in arrays of small integers, and the settings once per
+ * species:
+ *
+ * - The world is cut into square tiles, and the Birds are kept sorted by tile, so a tile's Birds
+ *   are next to each other and only the tiles around a Bird need be searched for its neighbours.
+ *   The tiles are as wide as the shortest distance any species can see, but no less than a quarter
+ *   of the longest, and each species searches as many tiles around it as it needs.
+ * - A position is two 16 bit integers, in steps of 1/65536 of a tile from the tile's corner. The
+ *   tile is known from where the Bird is in the arrays.
+ * - A velocity is two 16 bit integers, in steps of 1/32767 of the fastest species' max speed.
+ * - The species is one byte.
+ *
+ * That is 9 bytes a Bird between ticks. While a tick runs, the new state is written to a second
+ * set of arrays, along with the tile each Bird has moved to, and then sorted back into the first,
+ * so the total is 22 bytes a Bird.
+ *
+ * The Birds follow the same rules as Bird and Predator, worked out straight from the integers:
+ * distances are compared in whole steps, and only the forces are worked out in float. Predators
+ * chase the nearest Bird but don't eat, and there are no obstacles. Birds that leave the world die.
+ * Every Bird reads the state from the start of the tick, so the result is the same for any number
+ * of threads, but it isn't the same as a Flock's, as the positions are rounded to the steps.
+ */
+#ifndef COMPACTFLOCK_H
+#define COMPACTFLOCK_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Bird.h"
+
+class Random;
+class ThreadPool;
+
+class CompactFlock
+{
+public:
+
+    /* Constructor. The settings of each species can't be changed afterwards, as the size of the
+     * tiles depends on them. threadCount 0 means one thread per core. */
+    CompactFlock(int worldWidth, int worldHeight, const SpeciesParams params[kOtherSpecies], int threadCount = 0);
+
+    //Deconstructor
+    virtual ~CompactFlock();
+
+    //adds n Birds of a species at random positions and headings. Returns the number added.
+    int spawn(int species, int n, Random* random);
+
+    //moves every Bird on by one tick
+    void simulate();
+
+    //position and velocity of the Bird at index i, decoded
+    void getBird(int i, double* x, double* y, double* vx, double* vy)const;
+
+    //bytes kept between ticks, and bytes of every array, including those only used during a tick
+    size_t getStateBytes()const;
+    size_t getAllocatedBytes()const;
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline int const getBirdCount()const{return fX.size();}
+    inline int const getCount(int species)const{return fCount[species];}
+    inline int const getSpecies(int i)const{return fSpecies[i];}
+    inline long long const getTick()const{return fTick;}
+    inline int const getTileSize()const{return fTileSize;}
+    inline int const getColumns()const{return fColumns;}
+    inline int const getRows()const{return fRows;}
+
+    //steps of position across a tile, and of velocity up to the fastest max speed
+    static const int kPositionSteps = 65536;
+    static const int kVelocitySteps = 32767;
+
+private:
+
+    //settings of one species, converted into steps where they are compared with distances
+    struct SpeciesSteps{
+        float maxSpeed;
+        int64_t separation2;//separation distance squared, in position steps
+        int64_t detection2;
+        int64_t reach2;//the larger of the two
+        int tiles;//tiles searched on each side of the Bird's own
+        float separationStrength;
+        float cohesionStrength;
+        float alignmentStrength;
+        float avoidPredatorStrength;
+    };
+
+    //works out the new state of the Birds in one tile into the second set of arrays
+    void updateTile(int tile);
+
+    //sorts count Birds from the second set of arrays by their new tile into the first, leaving out the dead
+    void sortIntoTiles(int count);
+
+    //the first set of arrays: the state between ticks, sorted by tile
+    std::vector<uint16_t> fX;
+    std::vector<uint16_t> fY;
+    std::vector<int16_t> fVX;
+    std::vector<int16_t> fVY;
+    std::vector<uint8_t> fSpecies;
+    std::vector<uint32_t> fTileStart;//index of the first Bird of each tile, and the Bird count at the end
+
+    //the second set: the state worked out during a tick, and the tile each Bird is now in
+    std::vector<uint16_t> fNewX;
+    std::vector<uint16_t> fNewY;
+    std::vector<int16_t> fNewVX;
+    std::vector<int16_t> fNewVY;
+    std::vector<uint8_t> fNewSpecies;
+    std::vector<uint32_t> fNewTile;
+
+    int fWorldWidth;
+    int fWorldHeight;
+    int fTileSize;
+    int fColumns;
+    int fRows;
+    double fPositionStep;//size of a position step
+    double fVelocityStep;//size of a velocity step
+    SpeciesParams fParams[kOtherSpecies];
+    SpeciesSteps fSteps[kOtherSpecies];
+
+    int fCount[kOtherSpecies];
+    long long fTick;
+
+    ThreadPool* fThreadPool;
+
+    //tile given to Birds that died, which sorts after every real tile and is then dropped
+    inline uint32_t const deadTile()const{return fColumns*fRows;}
+
+    //maximum force of a single behaviour, as in Bird
+    static const float kMaxForce;
+
+    //number of tiles handed to a thread at a time
+    static const int kTilesPerChunk = 16;
+};
+
+#endif // COMPACTFLOCK_H
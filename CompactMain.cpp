@@ -0,0 +1,120 @@
+/* CompactMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockCompact, which runs the Birds of a scenario as a CompactFlock, to see how many
+ * Birds fit in memory and how fast they run. Usage:
+ *
+ *     BirdFlockCompact scenario.toml [--birds N,N,...] [--ticks N] [--threads N] [--seed N]
+ *
+ * For each number of Birds given (by default just the number in the scenario), the world is made
+ * bigger or smaller so the Birds are as crowded as in the scenario, each species keeps its share,
+ * and the flock is run for --ticks ticks (10 by default). It then prints the bytes each Bird takes,
+ * between ticks and in all, and how long a tick took. The obstacles of the scenario are left out,
+ * as CompactFlock has none.
+ */
+#include "CompactFlock.h"
+#include "Scenario.h"
+#include "Random.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cmath>
+#include <chrono>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockCompact scenario.toml [--birds N,N,...] [--ticks N] [--threads N] [--seed N]" << std::endl;
+}
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    std::vector<long long> birdCounts;
+    long long ticks = 10;
+    int threads = -1;
+    const char* seed = 0;
+    for(int i=2; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--birds") == 0){
+            std::stringstream list(argv[++i]);
+            std::string count;
+            while(std::getline(list, count, ',')) birdCounts.push_back(atoll(count.c_str()));
+        }
+        else if(hasValue && strcmp(argv[i], "--ticks") == 0) ticks = atoll(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--threads") == 0) threads = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seed") == 0) seed = argv[++i];
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    Scenario scenario;
+    if(!scenario.load(argv[1])){
+        std::cerr << scenario.getError() << std::endl;
+        return 1;
+    }
+    if(threads >= 0) scenario.setThreads(threads);
+    if(seed) scenario.setSeed(strtoull(seed, 0, 10));
+    else if(!scenario.hasSeed()) scenario.setSeed(time(NULL));
+
+    SpeciesParams params[kOtherSpecies];
+    long long scenarioBirds = 0;
+    for(int species=0; species<kOtherSpecies; species++){
+        params[species] = *scenario.getSpeciesParams(species);
+        scenarioBirds += scenario.getSpeciesCount(species);
+    }
+    if(scenarioBirds == 0){
+        std::cerr << "the scenario has no birds" << std::endl;
+        return 1;
+    }
+    if(birdCounts.empty()) birdCounts.push_back(scenarioBirds);
+    std::cout << "scenario " << argv[1] << ", seed " << scenario.getSeed() << ". A Bird object alone takes "
+              << sizeof(Bird) << " bytes, and a Flock keeps a pointer to each." << std::endl;
+
+    for(int run=0; run<birdCounts.size(); run++){
+        double share = (double)birdCounts[run]/scenarioBirds;
+        int width = std::max(1, (int)std::lround(scenario.getWorldWidth()*std::sqrt(share)));
+        int height = std::max(1, (int)std::lround(scenario.getWorldHeight()*std::sqrt(share)));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        CompactFlock flock(width, height, params, scenario.getThreads());
+        Random random(scenario.getSeed());
+        for(int species=0; species<kOtherSpecies; species++){
+            flock.spawn(species, (int)std::lround(scenario.getSpeciesCount(species)*share), &random);
+        }
+        int birds = flock.getBirdCount();
+        std::cout << birds << " birds in a " << width << " x " << height << " world, " << flock.getColumns() << " x "
+                  << flock.getRows() << " tiles of " << flock.getTileSize() << ", set up in " << secondsSince(start)*1000
+                  << " ms" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        for(long long tick=0; tick<ticks; tick++){
+            flock.simulate();
+        }
+        double runTime = secondsSince(start);
+
+        std::cout << "  " << (double)flock.getStateBytes()/birds << " bytes a bird between ticks, "
+                  << (double)flock.getAllocatedBytes()/birds << " in all" << std::endl;
+        std::cout << "  " << ticks << " ticks in " << runTime << " s (" << (ticks > 0 ? runTime/ticks*1000 : 0)
+                  << " ms per tick, " << (runTime > 0 ? ticks/runTime : 0) << " ticks a second), "
+                  << flock.getCount(kBlue) << " blue, " << flock.getCount(kGreen) << " green, "
+                  << flock.getCount(kRed) << " predators left" << std::endl;
+    }
+    return 0;
+}
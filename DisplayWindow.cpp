@@ -1,117 +1,506 @@
-/* DisplayWindow.cpp
- * Author: Max Elliott
- * Created On: 2017-12-12
- *
- * .cpp file for DisplayWindow, the window used to visually display the flock
- * as the simulation runs. Uses QT GUI libraries.
- */
-#include "DisplayWindow.h"
-#include "ui_DisplayWindow.h"
-#include "Bird.h"
-#include "Flock.h"
-#include <cstdlib>
-#include <QPainter>
-#include <QTimer>
-#include <QPen>
-#include <QPoint>
-#include <QSize>
-#include <QPolygon>
-#include <iostream>
-
-/* Constructor. Sets up the window, intialises the data members, creates a timer
- * that calls the classes update method every 20ms. The update method comes from
- * the QWidget class, which DisplayWindow inherits from.
- */
-DisplayWindow::DisplayWindow(Flock* flock, QWidget *parent) :
-    QWidget(parent),
-    ui(new Ui::DisplayWindow)
-{
-    ui->setupUi(this);
-    setStyleSheet("background-color:whit"
-                  " e");
-    setAutoFillBackground(false);
-    setWindowTitle(std::string("Bird Flock Display").c_str());
-
-    fFlock = flock;
-    fPause = false;
-
-    //Timers and connect explained in MainWindow.cpp constructor
-    QTimer *timer = new QTimer(this);
-    connect(timer, SIGNAL(timeout()), this, SLOT(update())); //update() calls the paintEvent slot, so the Flock is redrawn every 20ms
-    timer->start(20);
-    show();
-
-}
-
-//Destructor
-DisplayWindow::~DisplayWindow()
-{
-    delete ui;
-}
-
-/* paintEvent slot for DisplayWindow. This is how all flockObjects are drawn, and its is called every 20ms
- * by the QTimer created in the DisplayWindow constructor. It uses the QPainter class defined by the Qt
- * libraries.
- */
-void DisplayWindow::paintEvent(QPaintEvent *){
-    QPainter painter(this);//new painter
-    QPen pen(Qt::green);//new pen, used to define the line thickness/colour when drawing
-    painter.setPen(pen);//set the painter's pen to the one declared above
-
-    //loop to paint all birds in flock
-    for(int i=0; i < fFlock->getBirds()->size(); i++){
-
-        //get all data members needed to draw the bird.
-        int x = (int)fFlock->getBirds()->at(i)->getXPos();
-        int y = (int)fFlock->getBirds()->at(i)->getYPos();
-        double heading = fFlock->getBirds()->at(i)->getHeading();
-        std::string colour = fFlock->getBirds()->at(i)->getColour();
-
-        //creates an isosceles triangle around the bird's position, using the heading to rotate in the right direction
-
-        QPolygon shape;
-        shape << QPoint(x+8*cos(heading),y+8*sin(heading)) <<
-                QPoint(x-4*sin(heading), y+4*cos(heading)) <<
-                QPoint(x+4*sin(heading), y-4*cos(heading)) <<
-                QPoint(x+8*cos(heading),y+8*sin(heading));
-
-        //setting pen colour based on bird colour
-        if(colour.compare("blue")==0){
-            pen.setColor(Qt::blue);
-            painter.setPen(pen);
-        }
-        else if(colour.compare("green")==0){
-            pen.setColor(Qt::green);
-            painter.setPen(pen);
-        }
-        else if(colour.compare("red")==0){
-            pen.setColor(Qt::red);
-            QColor c = Qt::red;
-            painter.setPen(pen);
-        }
-
-        //draws the bird
-        painter.drawPolyline(shape);
-        //painter.drawPolygon(shape);
-    }
-
-    //loop to paint all obstacles
-    pen.setColor(Qt::black);
-    painter.setPen(pen);
-    for(int i=0;i<fFlock->getObstacles()->size();i++){
-        Obstacle* o = fFlock->getObstacles()->at(i);
-        int radius = o->getRadius();
-        painter.drawEllipse(QPoint(o->getXPos(),o->getYPos()),radius, radius);
-    }
-
-    //adds the pause label if fPause is true, to indicate the simulation is paused.
-    ui->Pause_label->setVisible(fPause);
-
-
-}
-
-//When the window is resized, the pause label is repositioned so that it is always central
-void DisplayWindow::resizeEvent(QResizeEvent *E){
-    QSize size = E->size();
-    ui->Pause_label->setGeometry(size.width()*0.5-50,size.height()*0.5-25,100,50);
-}
+/* DisplayWindow.cpp
+ * Author: Max Elliott
+ * Created On: 2017-12-12
+ *
+ * .cpp file for DisplayWindow, the window used to visually display the flock
+ * as the simulation runs. Uses QT GUI libraries.
+ */
+#include "DisplayWindow.h"
+#include "ui_DisplayWindow.h"
+#include "Bird.h"
+#include "Flock.h"
+#include <cstdlib>
+#include <QPainter>
+#include <QTimer>
+#include <QPen>
+#include <QPoint>
+#include <QSize>
+#include <QPolygon>
+#include <QColor>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include "Parallel.h"
+#include "FastMath.h"
+
+/* Constructor. Sets up the window, intialises the data members, creates a timer
+ * that calls the classes update method every 20ms. The update method comes from
+ * the QWidget class, which DisplayWindow inherits from.
+ */
+DisplayWindow::DisplayWindow(Flock* flock, QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::DisplayWindow)
+{
+    ui->setupUi(this);
+    setStyleSheet("background-color:whit"
+                  " e");
+    setAutoFillBackground(false);
+    setWindowTitle(std::string("Bird Flock Display").c_str());
+
+    fFlock = flock;
+    fPause = false;
+    fZoom = 1;
+    fFitWorld = true;
+    fDragging = false;
+    fReplayPosition = 0;
+    fReplaySpeed = 1;
+    fReplayPlaying = true;
+    setFocusPolicy(Qt::StrongFocus);//so the window receives key presses
+
+    //Timers and connect explained in MainWindow.cpp constructor
+    QTimer *timer = new QTimer(this);
+    connect(timer, SIGNAL(timeout()), this, SLOT(update())); //update() calls the paintEvent slot, so the Flock is redrawn every 20ms
+    timer->start(20);
+    show();
+
+}
+
+//Destructor
+DisplayWindow::~DisplayWindow()
+{
+    delete ui;
+}
+
+/* paintEvent slot for DisplayWindow. This is how all flockObjects are drawn, and its is called every 20ms
+ * by the QTimer created in the DisplayWindow constructor. It uses the QPainter class defined by the Qt
+ * libraries. Only the objects the camera can see are drawn, and very large or very zoomed out flocks
+ * are drawn as a density map rather than as individual birds, so the cost of a frame depends on the
+ * size of the window rather than the number of birds. While replaying, the current recorded frame is
+ * drawn instead of the live Flock.
+ */
+void DisplayWindow::paintEvent(QPaintEvent *){
+    QPainter painter(this);//new painter
+
+    if(fFitWorld) fitWorld();
+
+    const TrajectoryFrame* frame = 0;
+    if(isReplaying()){
+        advanceReplay();
+        frame = fReplay.readFrame(getReplayFrame());
+        findVisibleReplay(frame);
+    }
+    else{
+        findVisible();
+    }
+
+    if(fVisibleBirds.size() > kLodBirdThreshold || (fZoom < kLodMinZoom && !fVisibleBirds.empty())){
+        paintDensity(painter);
+    }
+    else{
+        paintBirds(painter);
+    }
+
+    //loop to paint all visible obstacles
+    QPen pen(Qt::black);
+    painter.setPen(pen);
+    for(int i=0;i<fVisibleObstacles.size();i++){
+        Obstacle* o = fFlock->getObstacles()->at(fVisibleObstacles[i]);
+        double radius = o->getRadius()*fZoom;
+        painter.drawEllipse(worldToScreen((double)o->getXPos(),(double)o->getYPos()),radius, radius);
+    }
+
+    //outline of the world, so the edges can be seen when zoomed out
+    pen.setColor(Qt::gray);
+    painter.setPen(pen);
+    QPointF topLeft = worldToScreen(0, 0);
+    painter.drawRect(QRectF(topLeft.x(), topLeft.y(), worldWidth()*fZoom, worldHeight()*fZoom));
+
+    //shows where the replay is up to
+    if(isReplaying()){
+        pen.setColor(Qt::black);
+        painter.setPen(pen);
+        QString status = QString("Replay: tick %1, frame %2 of %3, speed %4x%5")
+                .arg(frame ? (double)frame->tick : 0.).arg(getReplayFrame()+1).arg(getReplayFrameCount())
+                .arg(fReplaySpeed).arg(fReplayPlaying ? QString("") : QString(" (paused)"));
+        painter.drawText(10, 20, status);
+    }
+
+    //adds the pause label if fPause is true, to indicate the simulation is paused.
+    ui->Pause_label->setVisible(fPause && !isReplaying());
+
+}
+
+//size of the world being shown
+int DisplayWindow::worldWidth()const{
+    return isReplaying() ? fReplay.getHeader()->worldWidth : fFlock->getWorldWidth();
+}
+
+int DisplayWindow::worldHeight()const{
+    return isReplaying() ? fReplay.getHeader()->worldHeight : fFlock->getWorldHeight();
+}
+
+/* findVisible
+ *
+ * Finds the Birds and Obstacles inside the area of the world the camera can see, using the spatial
+ * grids the Flock built at the start of the last tick. The search area is made slightly bigger than
+ * the window, so that birds that have moved since the grid was built, triangles that poke in from
+ * the edge, and obstacles whose centres are off screen are still drawn.
+ */
+void DisplayWindow::findVisible(){
+    BasicTwoVector<double> topLeft = screenToWorld(QPoint(0, 0));
+    BasicTwoVector<double> bottomRight = screenToWorld(QPoint(width(), height()));
+    std::vector<Bird*>* birds = fFlock->getBirds();
+
+    //birds move up to their max speed after the grid is built, and are drawn 8 pixels long
+    double birdMargin = 10 + 8/fZoom;
+    fVisibleIndices.clear();
+    fFlock->getBirdGrid()->query(topLeft.x()-birdMargin, topLeft.y()-birdMargin,
+                                 bottomRight.x()+birdMargin, bottomRight.y()+birdMargin, &fVisibleIndices);
+
+    /* Birds added since the grid was built aren't in it yet, and removing the dead ones only happens
+     * when the grid is rebuilt, so indices are always valid unless the Flock was shrunk by something
+     * else in between. Skip any that are out of range just in case. */
+    fVisibleBirds.clear();
+    for(int i=0; i<fVisibleIndices.size(); i++){
+        if(fVisibleIndices[i] >= birds->size()) continue;
+
+        Bird* b = birds->at(fVisibleIndices[i]);
+        VisibleBird visible;
+        visible.x = (double)b->getXPos();
+        visible.y = (double)b->getYPos();
+        visible.vx = (double)b->getVelocity().x();
+        visible.vy = (double)b->getVelocity().y();
+        visible.heading = (double)b->getHeading();
+        visible.species = b->getSpecies();
+        fVisibleBirds.push_back(visible);
+    }
+
+    double obstacleMargin = fFlock->getMaxObstacleRadius();
+    fVisibleObstacles.clear();
+    fFlock->getObstacleGrid()->query(topLeft.x()-obstacleMargin, topLeft.y()-obstacleMargin,
+                                     bottomRight.x()+obstacleMargin, bottomRight.y()+obstacleMargin, &fVisibleObstacles);
+    int obstacleCount = fFlock->getObstacles()->size();
+    fVisibleObstacles.erase(std::remove_if(fVisibleObstacles.begin(), fVisibleObstacles.end(), [=](int i){return i >= obstacleCount;}), fVisibleObstacles.end());
+}
+
+/* findVisibleReplay
+ *
+ * Finds the birds in a recorded frame that the camera can see, converting them back from the
+ * quantised values in the recording. Recordings don't store obstacles or headings, so no obstacles
+ * are shown and the heading is worked out from the velocity.
+ *
+ * inputs:
+ * - frame: the decoded frame, or 0 if it couldn't be read
+ */
+void DisplayWindow::findVisibleReplay(const TrajectoryFrame* frame){
+    fVisibleBirds.clear();
+    fVisibleObstacles.clear();
+    if(!frame) return;
+
+    BasicTwoVector<double> topLeft = screenToWorld(QPoint(0, 0));
+    BasicTwoVector<double> bottomRight = screenToWorld(QPoint(width(), height()));
+    double margin = 8/fZoom;
+    double positionScale = 1./fReplay.getHeader()->positionScale;
+    double velocityScale = 1./fReplay.getHeader()->velocityScale;
+
+    for(int i=0; i<frame->size(); i++){
+        VisibleBird visible;
+        visible.x = frame->x[i]*positionScale;
+        visible.y = frame->y[i]*positionScale;
+        if(visible.x < topLeft.x()-margin || visible.x > bottomRight.x()+margin ||
+           visible.y < topLeft.y()-margin || visible.y > bottomRight.y()+margin){
+            continue;
+        }
+        visible.vx = frame->vx[i]*velocityScale;
+        visible.vy = frame->vy[i]*velocityScale;
+        visible.heading = angleOf(visible.vx, visible.vy);
+        visible.species = frame->species[i];
+        fVisibleBirds.push_back(visible);
+    }
+}
+
+/* paintBirds
+ *
+ * Draws each visible bird as a triangle pointing along its heading, coloured by the
+ * colour of the bird. Birds are always the same size on screen, whatever the zoom.
+ *
+ * inputs:
+ * - painter: painter for this window
+ */
+void DisplayWindow::paintBirds(QPainter& painter){
+    QPen pen(Qt::green);//new pen, used to define the line thickness/colour when drawing
+    painter.setPen(pen);//set the painter's pen to the one declared above
+
+    //loop to paint all visible birds
+    for(int i=0; i < fVisibleBirds.size(); i++){
+        const VisibleBird& b = fVisibleBirds[i];
+
+        //get all data members needed to draw the bird.
+        QPointF position = worldToScreen(b.x, b.y);
+        int x = (int)position.x();
+        int y = (int)position.y();
+        double sine, cosine;
+        sinCos(b.heading, &sine, &cosine);
+
+        //creates an isosceles triangle around the bird's position, using the heading to rotate in the right direction
+
+        QPolygon shape;
+        shape << QPoint(x+8*cosine,y+8*sine) <<
+                QPoint(x-4*sine, y+4*cosine) <<
+                QPoint(x+4*sine, y-4*cosine) <<
+                QPoint(x+8*cosine,y+8*sine);
+
+        //setting pen colour based on bird colour
+        if(b.species == kBlue){
+            pen.setColor(Qt::blue);
+            painter.setPen(pen);
+        }
+        else if(b.species == kGreen){
+            pen.setColor(Qt::green);
+            painter.setPen(pen);
+        }
+        else if(b.species == kRed){
+            pen.setColor(Qt::red);
+            painter.setPen(pen);
+        }
+
+        //draws the bird
+        painter.drawPolyline(shape);
+        //painter.drawPolygon(shape);
+    }
+}
+
+/* paintDensity
+ *
+ * Level of detail version of paintBirds for very large flocks. The window is split into square tiles
+ * kLodTileSize pixels wide, and every visible bird adds itself and its velocity to the tile it is in.
+ * Each thread fills its own copy of the tile buffer, and the copies are then summed. Every tile becomes
+ * one pixel of fDensityImage: the hue shows the average direction the birds in it are flying, and the
+ * saturation shows how many birds there are (log scaled, so sparse regions are still visible). The
+ * image is then stretched over the whole window in a single draw call.
+ *
+ * inputs:
+ * - painter: painter for this window
+ */
+void DisplayWindow::paintDensity(QPainter& painter){
+    const VisibleBird* visible = fVisibleBirds.data();
+    int tilesX = width()/kLodTileSize + 1;
+    int tilesY = height()/kLodTileSize + 1;
+    int tileCount = tilesX*tilesY;
+    int threadCount = parallelThreadCount();
+
+    //camera transform, copied so the threads don't need to touch the widget
+    double zoom = fZoom;
+    double offsetX = width()/2. - fCameraCentre.x()*zoom;
+    double offsetY = height()/2. - fCameraCentre.y()*zoom;
+
+    //count, x velocity sum and y velocity sum for every tile, one copy per thread
+    fDensityBuffer.assign(3*tileCount*threadCount, 0.f);
+    float* buffer = fDensityBuffer.data();
+
+    //bin the birds into tiles
+    parallelFor(fVisibleBirds.size(), [=](int begin, int end, int thread){
+        float* tiles = buffer + 3*tileCount*thread;
+        for(int i=begin; i<end; i++){
+            const VisibleBird& b = visible[i];
+            double sx = b.x*zoom + offsetX;
+            double sy = b.y*zoom + offsetY;
+            if(sx < 0 || sy < 0) continue;
+
+            int tx = (int)sx/kLodTileSize;
+            int ty = (int)sy/kLodTileSize;
+            if(tx >= tilesX || ty >= tilesY) continue;
+
+            float* tile = tiles + 3*(ty*tilesX + tx);
+            tile[0] += 1;
+            tile[1] += b.vx;
+            tile[2] += b.vy;
+        }
+    });
+    //sum the per-thread copies into the first one, each thread summing a different block of tiles
+    parallelFor(tileCount, [=](int begin, int end, int){
+        for(int t=1; t<threadCount; t++){
+            const float* tiles = buffer + 3*tileCount*t;
+            for(int i=3*begin; i<3*end; i++){
+                buffer[i] += tiles[i];
+            }
+        }
+    });
+
+    float maxCount = 1;
+    for(int i=0; i<tileCount; i++){
+        maxCount = std::max(maxCount, buffer[3*i]);
+    }
+    float logMaxCount = log(1 + maxCount);
+
+    //only reallocate the image when the window has changed size
+    if(fDensityImage.width() != tilesX || fDensityImage.height() != tilesY){
+        fDensityImage = QImage(tilesX, tilesY, QImage::Format_RGB32);
+    }
+    uchar* bits = fDensityImage.bits();//detaches the image here, so the threads below can write to it directly
+    int bytesPerLine = fDensityImage.bytesPerLine();
+
+    //turn the tiles into pixels, one block of rows per thread
+    parallelFor(tilesY, [=](int begin, int end, int){
+        for(int ty=begin; ty<end; ty++){
+            QRgb* line = (QRgb*)(bits + ty*bytesPerLine);
+            for(int tx=0; tx<tilesX; tx++){
+                const float* tile = buffer + 3*(ty*tilesX + tx);
+                if(tile[0] == 0){
+                    line[tx] = qRgb(255, 255, 255);//empty tiles are the same as the background
+                    continue;
+                }
+                double hue = (atan2(tile[2], tile[1]) + M_PI)/(2*M_PI);
+                double level = log(1 + tile[0])/logMaxCount;
+                line[tx] = QColor::fromHsvF(std::min(hue, 1.), std::min(0.25 + 0.75*level, 1.), 1.).rgb();
+            }
+        }
+    });
+
+    painter.drawImage(QRect(0, 0, tilesX*kLodTileSize, tilesY*kLodTileSize), fDensityImage);
+}
+
+//When the window is resized, the pause label is repositioned so that it is always central
+void DisplayWindow::resizeEvent(QResizeEvent *E){
+    QSize size = E->size();
+    ui->Pause_label->setGeometry(size.width()*0.5-50,size.height()*0.5-25,100,50);
+}
+
+/* fitWorld
+ *
+ * Centres the camera on the world and zooms so the whole world fits in the window. The camera
+ * then keeps doing this every frame (so it follows changes to the world size and window size)
+ * until the user pans or zooms.
+ */
+void DisplayWindow::fitWorld(){
+    double shownWidth = std::max(1, worldWidth());
+    double shownHeight = std::max(1, worldHeight());
+    fCameraCentre = BasicTwoVector<double>(shownWidth/2., shownHeight/2.);
+    fZoom = std::min(width()/shownWidth, height()/shownHeight);
+    if(fZoom <= 0) fZoom = 1;
+    fFitWorld = true;
+}
+
+//Pressing a mouse button starts dragging the camera
+void DisplayWindow::mousePressEvent(QMouseEvent *E){
+    fDragging = true;
+    fLastMousePos = E->pos();
+}
+
+//While dragging, the world moves with the mouse
+void DisplayWindow::mouseMoveEvent(QMouseEvent *E){
+    if(!fDragging) return;
+
+    QPoint moved = E->pos() - fLastMousePos;
+    fCameraCentre -= BasicTwoVector<double>(moved.x()/fZoom, moved.y()/fZoom);
+    fLastMousePos = E->pos();
+    fFitWorld = false;
+}
+
+void DisplayWindow::mouseReleaseEvent(QMouseEvent *){
+    fDragging = false;
+}
+
+/* The mouse wheel zooms in and out around the mouse pointer, so the point of the world under
+ * the pointer stays where it is. Each notch of the wheel (120 units) zooms by about 20%. */
+void DisplayWindow::wheelEvent(QWheelEvent *E){
+    BasicTwoVector<double> before = screenToWorld(E->pos());
+
+    fZoom *= pow(1.0015, E->angleDelta().y());
+    fZoom = std::max(0.001, std::min(fZoom, 50.));
+
+    BasicTwoVector<double> after = screenToWorld(E->pos());
+    fCameraCentre += before - after;
+    fFitWorld = false;
+}
+
+//Home fits the whole world back into the window. Other keys control the replay.
+void DisplayWindow::keyPressEvent(QKeyEvent *E){
+    if(E->key() == Qt::Key_Home){
+        fitWorld();
+    }
+    else if(isReplaying()){
+        replayKeyPressed(E->key());
+    }
+}
+
+/* startReplay
+ *
+ * Opens a recording and starts playing it from the first frame, fitting the camera to the
+ * recorded world.
+ *
+ * inputs:
+ * - path: trajectory file to play
+ *
+ * return: true if the file was opened
+ */
+bool DisplayWindow::startReplay(std::string path){
+    if(!fReplay.open(path) || fReplay.getFrameCount() == 0){
+        fReplay.close();
+        return false;
+    }
+    fReplayPosition = 0;
+    fReplaySpeed = 1;
+    fReplayPlaying = true;
+    fitWorld();
+    return true;
+}
+
+//goes back to showing the live Flock
+void DisplayWindow::stopReplay(){
+    fReplay.close();
+    fitWorld();
+}
+
+//jumps to a frame of the replay
+void DisplayWindow::seekReplay(int frame){
+    fReplayPosition = std::max(0, std::min(frame, getReplayFrameCount()-1));
+}
+
+/* advanceReplay
+ *
+ * Called every redraw. Moves the replay on by fReplaySpeed frames if it is playing, and pauses
+ * it when it reaches the start or end of the recording.
+ */
+void DisplayWindow::advanceReplay(){
+    if(!fReplayPlaying) return;
+
+    fReplayPosition += fReplaySpeed;
+    if(fReplayPosition < 0){
+        fReplayPosition = 0;
+        fReplayPlaying = false;
+    }
+    else if(fReplayPosition > getReplayFrameCount()-1){
+        fReplayPosition = getReplayFrameCount()-1;
+        fReplayPlaying = false;
+    }
+}
+
+/* replayKeyPressed
+ *
+ * Keyboard controls for the replay:
+ * - Space: play/pause
+ * - R: reverse direction
+ * - Up/Down: double/halve the speed
+ * - Left/Right: pause and step back/forward one frame
+ *
+ * inputs:
+ * - key: the Qt::Key that was pressed
+ *
+ * return: true if the key controls the replay
+ */
+bool DisplayWindow::replayKeyPressed(int key){
+    switch(key){
+    case Qt::Key_Space:
+        fReplayPlaying = !fReplayPlaying;
+        return true;
+    case Qt::Key_R:
+        fReplaySpeed = -fReplaySpeed;
+        return true;
+    case Qt::Key_Up:
+        fReplaySpeed = std::max(-256., std::min(fReplaySpeed*2, 256.));
+        return true;
+    case Qt::Key_Down:
+        fReplaySpeed /= 2;
+        return true;
+    case Qt::Key_Left:
+        fReplayPlaying = false;
+        seekReplay(getReplayFrame()-1);
+        return true;
+    case Qt::Key_Right:
+        fReplayPlaying = false;
+        seekReplay(getReplayFrame()+1);
+        return true;
+    }
+    return false;
+}
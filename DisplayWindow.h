@@ -1,52 +1,161 @@
-/* DisplayWindow.h
- * Author: Max Elliott
- * Created On: 2017-12-12
- *
- * Header file for DisplayWindow, the window used to visually display the flock
- * as the simulation runs. Uses QT GUI libraries.
- */
-#ifndef DISPLAYWINDOW_H
-#define DISPLAYWINDOW_H
-
-#include <QWidget>
-#include <Flock.h>
-#include "QResizeEvent"
-
-namespace Ui {
-class DisplayWindow;
-}
-
-class DisplayWindow : public QWidget
-{
-    Q_OBJECT
-
-public:
-
-    //Constructors
-    explicit DisplayWindow(QWidget *parent = 0);
-
-    //Constructor that takes in a Flock pointer. This is the Flock it will draw on the window.
-    explicit DisplayWindow(Flock* flock, QWidget *parent = 0);
-
-    //Destructor
-    ~DisplayWindow();
-
-    //Simple method to toggle fPause
-    inline void togglePause(){fPause = !fPause;}
-
-
-private slots:
-
-    //Paint event slot, used to draw the flock on the display screen
-    void paintEvent(QPaintEvent *);
-
-    //slot for when window is resized.
-    void resizeEvent(QResizeEvent* E);
-
-private:
-    Ui::DisplayWindow *ui; //instance of DisplayWindow.ui to generate the interface
-    Flock* fFlock;//pointer to Flock used in simulation
-    bool fPause;
-};
-
-#endif // DISPLAYWINDOW_H
+/* DisplayWindow.h
+ * Author: Max Elliott
+ * Created On: 2017-12-12
+ *
+ * Header file for DisplayWindow, the window used to visually display the flock
+ * as the simulation runs. Uses QT GUI libraries.
+ */
+#ifndef DISPLAYWINDOW_H
+#define DISPLAYWINDOW_H
+
+#include <QWidget>
+#include <QImage>
+#include <QPainter>
+#include <QPoint>
+#include <QPointF>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QKeyEvent>
+#include <vector>
+#include <string>
+#include <Flock.h>
+#include "QResizeEvent"
+#include "TwoVector.h"
+#include "TrajectoryReader.h"
+
+namespace Ui {
+class DisplayWindow;
+}
+
+class DisplayWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+
+    //Constructors
+    explicit DisplayWindow(QWidget *parent = 0);
+
+    //Constructor that takes in a Flock pointer. This is the Flock it will draw on the window.
+    explicit DisplayWindow(Flock* flock, QWidget *parent = 0);
+
+    //Destructor
+    ~DisplayWindow();
+
+    //Simple method to toggle fPause
+    inline void togglePause(){fPause = !fPause;}
+
+    //moves the camera so the whole world fits in the window, and keeps it fitted until the user moves it
+    void fitWorld();
+
+    /* Replay mode. While replaying, the window shows a recorded trajectory file instead of the live
+     * Flock. The recording plays at one frame per redraw, and can be paused, reversed, sped up,
+     * slowed down and moved to any frame without re-running the simulation. */
+    bool startReplay(std::string path);
+    void stopReplay();
+    void seekReplay(int frame);
+    inline bool const isReplaying()const{return fReplay.isOpen();}
+    inline int const getReplayFrame()const{return (int)fReplayPosition;}
+    inline int const getReplayFrameCount()const{return fReplay.getFrameCount();}
+
+
+private slots:
+
+    //Paint event slot, used to draw the flock on the display screen
+    void paintEvent(QPaintEvent *);
+
+    //slot for when window is resized.
+    void resizeEvent(QResizeEvent* E);
+
+    //slots for moving the camera. Dragging with the mouse pans, the mouse wheel zooms, and Home fits the whole world.
+    void mousePressEvent(QMouseEvent* E);
+    void mouseMoveEvent(QMouseEvent* E);
+    void mouseReleaseEvent(QMouseEvent* E);
+    void wheelEvent(QWheelEvent* E);
+    void keyPressEvent(QKeyEvent* E);
+
+private:
+
+    //converts between world coordinates and window coordinates using the camera
+    inline QPointF worldToScreen(double x, double y)const{
+        return QPointF((x - fCameraCentre.x())*fZoom + width()/2., (y - fCameraCentre.y())*fZoom + height()/2.);
+    }
+    inline BasicTwoVector<double> screenToWorld(QPoint p)const{
+        return BasicTwoVector<double>((p.x() - width()/2.)/fZoom + fCameraCentre.x(), (p.y() - height()/2.)/fZoom + fCameraCentre.y());
+    }
+
+    //size of the world being shown: the Flock's world, or the recorded world while replaying
+    int worldWidth()const;
+    int worldHeight()const;
+
+    //uses the spatial grids of fFlock to find the Birds and Obstacles the camera can see
+    void findVisible();
+
+    //finds the birds the camera can see in a recorded frame
+    void findVisibleReplay(const TrajectoryFrame* frame);
+
+    //moves the replay on by fReplaySpeed frames, stopping at either end of the recording
+    void advanceReplay();
+
+    //handles key presses that control the replay. Returns true if the key was used.
+    bool replayKeyPressed(int key);
+
+    //draws every bird as a triangle. Used for normal sized flocks.
+    void paintBirds(QPainter& painter);
+
+    //draws the flock as a density map. Used when there are too many birds to draw separately.
+    void paintDensity(QPainter& painter);
+
+    Ui::DisplayWindow *ui; //instance of DisplayWindow.ui to generate the interface
+    Flock* fFlock;//pointer to Flock used in simulation
+    bool fPause;
+
+    /* Camera. fCameraCentre is the world position at the centre of the window, and fZoom is the
+     * number of pixels per unit of world distance. While fFitWorld is true the camera is moved
+     * every frame to show the whole world, which is how the window behaves until the user pans
+     * or zooms. Kept in double whatever Real is, as it is only for drawing. */
+    BasicTwoVector<double> fCameraCentre;
+    double fZoom;
+    bool fFitWorld;
+    bool fDragging;
+    QPoint fLastMousePos;
+
+    /* Everything needed to draw a bird. Filled in every frame for each bird the camera can see,
+     * either from the live Flock or from a recorded frame, so drawing doesn't depend on where the
+     * birds came from. */
+    struct VisibleBird{
+        double x, y;
+        double vx, vy;
+        double heading;
+        int species;
+    };
+
+    //the birds, and indices into the Flock's Obstacles, that the camera can see, found every frame
+    std::vector<VisibleBird> fVisibleBirds;
+    std::vector<int> fVisibleObstacles;
+    std::vector<int> fVisibleIndices;//reused when querying the grids
+
+    /* Replay state. fReplayPosition is the current frame (kept as a double so replays can run at
+     * fractions of a frame per redraw), fReplaySpeed is the number of frames moved per redraw,
+     * negative when playing backwards. */
+    TrajectoryReader fReplay;
+    double fReplayPosition;
+    double fReplaySpeed;
+    bool fReplayPlaying;
+
+    /* Level of detail settings. Once more than kLodBirdThreshold birds are visible, or the camera
+     * is zoomed out past kLodMinZoom, the triangles are just noise and drawing them takes most of
+     * the frame, so the birds are instead binned into square tiles kLodTileSize pixels wide and
+     * drawn as one image. */
+    static const int kLodBirdThreshold = 100000;
+    static const int kLodTileSize = 2;
+    const double kLodMinZoom = 0.25;
+
+    /* Buffers for the density map. fDensityBuffer holds a count, x velocity sum and y velocity
+     * sum for each tile, with a separate copy for every thread. Kept between frames so they
+     * don't need to be reallocated every 20ms. */
+    std::vector<float> fDensityBuffer;
+    QImage fDensityImage;
+};
+
+#endif // DISPLAYWINDOW_H
@@ -0,0 +1,438 @@
+/* DistributedFlock.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for DistributedFlock
+ */
+#include "DistributedFlock.h"
+#include "TileTransport.h"
+#include "Scenario.h"
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//appends the bytes of a plain struct to a message
+template<typename T>
+static void appendRecord(std::vector<uint8_t>* message, const T& record){
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    message->insert(message->end(), bytes, bytes + sizeof(T));
+}
+
+//empties a message and starts it with a header, whose count is filled in by setCount
+static void beginMessage(std::vector<uint8_t>* message, uint32_t kind, long long tick){
+    TileMessageHeader header;
+    header.magic = kTileMessageMagic;
+    header.kind = kind;
+    header.tick = tick;
+    header.count = 0;
+    header.reserved = 0;
+    message->clear();
+    appendRecord(message, header);
+}
+
+//sets the count of records in the header of a message
+static void setCount(std::vector<uint8_t>* message, uint32_t count){
+    TileMessageHeader header;
+    memcpy(&header, message->data(), sizeof(header));
+    header.count = count;
+    memcpy(message->data(), &header, sizeof(header));
+}
+
+//whether a position is in a rectangle grown by margin on every side
+inline static bool isInside(const DistributedTile& tile, double margin, double x, double y){
+    return x >= tile.minX - margin && x < tile.maxX + margin && y >= tile.minY - margin && y < tile.maxY + margin;
+}
+
+//Constructor
+DistributedFlock::DistributedFlock(TileTransport* transport, int tilesX, int tilesY){
+    fTransport = transport;
+    fTilesX = tilesX;
+    fTilesY = tilesY;
+    fTile = getTile(transport->getRank(), tilesX, tilesY, fFlock.getWorldWidth(), fFlock.getWorldHeight());
+    fHalo = 0;
+    fExchangeSeconds = 0;
+    fSimulateSeconds = 0;
+    fBirdsHandedOver = 0;
+    fGhostsReceived = 0;
+    fBirdsLost = 0;
+    fSettleFailed = false;
+    fSettleSeconds = 0;
+}
+
+//Deconstructor
+DistributedFlock::~DistributedFlock(){
+    fFlock.setGhosts(0);
+    for(int i=0; i<fGhosts.size(); i++){
+        delete fGhosts[i];
+    }
+    for(int species=0; species<kOtherSpecies; species++){
+        for(int i=0; i<fSpareGhosts[species].size(); i++){
+            delete fSpareGhosts[species][i];
+        }
+    }
+}
+
+/* getTile
+ *
+ * inputs:
+ * - rank: rank of the process
+ * - tilesX, tilesY: number of columns and rows of tiles
+ * - worldWidth, worldHeight: size of the world
+ *
+ * return: the tile. The edges of tiles on the edge of the grid are moved out to infinity.
+ */
+DistributedTile DistributedFlock::getTile(int rank, int tilesX, int tilesY, int worldWidth, int worldHeight){
+    double far = std::numeric_limits<double>::max();
+    double width = (double)worldWidth/tilesX;
+    double height = (double)worldHeight/tilesY;
+
+    DistributedTile tile;
+    tile.column = rank % tilesX;
+    tile.row = rank / tilesX;
+    tile.minX = tile.column == 0 ? -far : tile.column*width;
+    tile.maxX = tile.column == tilesX-1 ? far : (tile.column+1)*width;
+    tile.minY = tile.row == 0 ? -far : tile.row*height;
+    tile.maxY = tile.row == tilesY-1 ? far : (tile.row+1)*height;
+    return tile;
+}
+
+//ranks of the up to eight tiles touching a rank's tile
+std::vector<int> DistributedFlock::getNeighbourRanks(int rank, int tilesX, int tilesY){
+    std::vector<int> ranks;
+    int column = rank % tilesX, row = rank / tilesX;
+    for(int y=std::max(0, row-1); y<=std::min(tilesY-1, row+1); y++){
+        for(int x=std::max(0, column-1); x<=std::min(tilesX-1, column+1); x++){
+            if(x != column || y != row) ranks.push_back(y*tilesX + x);
+        }
+    }
+    return ranks;
+}
+
+//the largest detection or separation distance of any species the scenario has Birds of
+double DistributedFlock::getHalo(const Scenario& scenario){
+    double halo = 0;
+    for(int species=0; species<kOtherSpecies; species++){
+        if(scenario.getSpeciesCount(species) <= 0) continue;
+        const SpeciesParams* params = scenario.getSpeciesParams(species);
+        halo = std::max(halo, (double)std::max(params->detectionDistance, params->separationDistance));
+    }
+    return halo;
+}
+
+/* setup
+ *
+ * Sets up the whole scenario, exactly as every other process does, then deletes the Birds outside
+ * this tile, leaving them to the processes whose tiles they are in.
+ *
+ * inputs:
+ * - scenario: the scenario to run
+ *
+ * return: true if the scenario can be split into these tiles
+ */
+bool DistributedFlock::setup(const Scenario& scenario){
+    scenario.apply(&fFlock);
+    fFlock.setGhosts(&fGhosts);
+
+    //every tile has the same scenario, so they all agree on whether there are claims to settle
+    if(scenario.getSpeciesCount(kRed) > 0){
+        fFlock.setClaimSettler([this](){
+            if(!fSettleFailed && !settleClaims()) fSettleFailed = true;
+        });
+    }
+    fHalo = getHalo(scenario);
+    if(fHalo > (double)fFlock.getWorldWidth()/fTilesX || fHalo > (double)fFlock.getWorldHeight()/fTilesY){
+        fError = "the tiles are smaller than the furthest a Bird can see (" + std::to_string((int)fHalo) + "): use fewer tiles";
+        return false;
+    }
+
+    int rank = fTransport->getRank();
+    fTile = getTile(rank, fTilesX, fTilesY, fFlock.getWorldWidth(), fFlock.getWorldHeight());
+    const std::vector<int>* peers = fTransport->getPeers();
+    fPeerTiles.clear();
+    for(int i=0; i<peers->size(); i++){
+        fPeerTiles.push_back(getTile(peers->at(i), fTilesX, fTilesY, fFlock.getWorldWidth(), fFlock.getWorldHeight()));
+    }
+    fOutgoing.resize(peers->size());
+
+    fFlock.releaseBirds(fTile.minX, fTile.minY, fTile.maxX, fTile.maxY, &fLeaving);
+    for(int i=0; i<fLeaving.size(); i++){
+        delete fLeaving[i];
+    }
+    fLeaving.clear();
+    return true;
+}
+
+/* simulate
+ *
+ * Runs one tick: hands over the Birds that left the tile in the last one, swaps halos with the
+ * neighbours, and simulates the Flock with the ghosts, settling the claims on them part way
+ * through (see settleClaims). The time spent settling counts as exchanging.
+ *
+ * return: true if the neighbours could be reached
+ */
+bool DistributedFlock::simulate(){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(!handOver() || !exchangeHalo()) return false;
+    fExchangeSeconds += secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    fSettleSeconds = 0;
+    fFlock.simulateFlock();
+    fSimulateSeconds += secondsSince(start) - fSettleSeconds;
+    fExchangeSeconds += fSettleSeconds;
+    return !fSettleFailed;
+}
+
+//the index of the peer whose tile holds a position, or -1 if none does
+int DistributedFlock::findPeer(double x, double y)const{
+    for(int i=0; i<fPeerTiles.size(); i++){
+        if(isInside(fPeerTiles[i], 0, x, y)) return i;
+    }
+    return -1;
+}
+
+/* handOver
+ *
+ * Takes the Birds that have moved out of the tile out of the Flock, and sends each one whole to
+ * the neighbour it moved to. Adopts the Birds that have moved in.
+ *
+ * return: true if the exchange worked
+ */
+bool DistributedFlock::handOver(){
+    int peerCount = fPeerTiles.size();
+    std::vector<uint32_t> counts(peerCount, 0);
+    for(int i=0; i<peerCount; i++){
+        beginMessage(&fOutgoing[i], kTileHandover, fFlock.getTick());
+    }
+
+    fFlock.releaseBirds(fTile.minX, fTile.minY, fTile.maxX, fTile.maxY, &fLeaving);
+    for(int i=0; i<fLeaving.size(); i++){
+        Bird* b = fLeaving[i];
+        int peer = findPeer((double)b->getXPos(), (double)b->getYPos());
+        if(peer >= 0){
+            CheckpointBird saved;
+            Flock::saveBird(b, &saved);
+            appendRecord(&fOutgoing[peer], saved);
+            counts[peer]++;
+        }
+        else{
+            fBirdsLost++;
+        }
+        delete b;
+    }
+    fBirdsHandedOver += fLeaving.size();
+    fLeaving.clear();
+    for(int i=0; i<peerCount; i++){
+        setCount(&fOutgoing[i], counts[i]);
+    }
+
+    if(!fTransport->exchange(fOutgoing, &fIncoming)){
+        fError = fTransport->getError();
+        return false;
+    }
+
+    for(int i=0; i<peerCount; i++){
+        const TileMessageHeader* header = readMessage(i, kTileHandover, sizeof(CheckpointBird));
+        if(!header) return false;
+        const uint8_t* records = reinterpret_cast<const uint8_t*>(header + 1);
+        for(int j=0; j<header->count; j++){
+            CheckpointBird saved;
+            memcpy(&saved, records + j*sizeof(CheckpointBird), sizeof(saved));
+            fArriving.push_back(Flock::restoreBird(saved));
+        }
+    }
+    fFlock.adoptBirds(&fArriving);
+    fArriving.clear();
+    return true;
+}
+
+/* exchangeHalo
+ *
+ * Sends each neighbour a GhostRecord for every living Bird within the halo of its tile, and turns
+ * the records that come back into the ghosts for this tick, in id order. Ghost Birds are kept
+ * from tick to tick and reused, so only their positions and velocities have to be set.
+ *
+ * return: true if the exchange worked
+ */
+bool DistributedFlock::exchangeHalo(){
+    int peerCount = fPeerTiles.size();
+    std::vector<Bird*>* birds = fFlock.getBirds();
+    for(int i=0; i<peerCount; i++){
+        std::vector<uint8_t>* message = &fOutgoing[i];
+        beginMessage(message, kTileHalo, fFlock.getTick());
+        uint32_t count = 0;
+        for(int j=0; j<birds->size(); j++){
+            Bird* b = birds->at(j);
+            if(b->getIsDead() || !isInside(fPeerTiles[i], fHalo, (double)b->getXPos(), (double)b->getYPos())) continue;
+            GhostRecord record;
+            record.id = b->getId();
+            record.species = b->getSpecies();
+            record.x = (double)b->getXPos();
+            record.y = (double)b->getYPos();
+            record.vx = (double)b->getVelocity().x();
+            record.vy = (double)b->getVelocity().y();
+            appendRecord(message, record);
+            count++;
+        }
+        setCount(message, count);
+    }
+
+    if(!fTransport->exchange(fOutgoing, &fIncoming)){
+        fError = fTransport->getError();
+        return false;
+    }
+
+    fGhostRecords.clear();
+    for(int i=0; i<peerCount; i++){
+        const TileMessageHeader* header = readMessage(i, kTileHalo, sizeof(GhostRecord));
+        if(!header) return false;
+        size_t first = fGhostRecords.size();
+        fGhostRecords.resize(first + header->count);
+        memcpy(fGhostRecords.data() + first, header + 1, header->count*sizeof(GhostRecord));
+    }
+    std::sort(fGhostRecords.begin(), fGhostRecords.end(), [](const GhostRecord& a, const GhostRecord& b){return a.id < b.id;});
+
+    for(int i=0; i<fGhosts.size(); i++){
+        fSpareGhosts[fGhosts[i]->getSpecies()].push_back(fGhosts[i]);
+    }
+    fGhosts.clear();
+    for(int i=0; i<fGhostRecords.size(); i++){
+        const GhostRecord& record = fGhostRecords[i];
+        int species = std::min(std::max((int)record.species, 0), kOtherSpecies-1);
+        Bird* ghost;
+        if(fSpareGhosts[species].empty()){
+            ghost = new Bird(TwoVector(), 0, 0, 0, 0, Bird::colourFromSpecies(species), 0, 0, 0, 0);
+        }
+        else{
+            ghost = fSpareGhosts[species].back();
+            fSpareGhosts[species].pop_back();
+        }
+        ghost->setId(record.id);
+        ghost->setXPos(record.x);
+        ghost->setYPos(record.y);
+        ghost->setVelocity(TwoVector(record.vx, record.vy));
+        ghost->setIsDead(false);
+        ghost->setWasEaten(false);
+        fGhosts.push_back(ghost);
+    }
+    fGhostsReceived += fGhosts.size();
+    return true;
+}
+
+/* settleClaims
+ *
+ * Called by the Flock once its Predators have claimed what they caught, before anything is eaten.
+ * Sends the claim on each ghost to the neighbour that owns it, which is the one whose tile the
+ * ghost is in, as nothing has moved since the halo was sent. Each tile adds the claims it is sent
+ * to its own (see Flock::claimBird), then sends back those that are still the smallest, and drops
+ * the claims on its ghosts that didn't come back. So every Bird is eaten by the nearest Predator
+ * that caught it, in whichever tile, and only that one. Every tile sends both messages every tick,
+ * even if they are empty, so they all stay in step.
+ *
+ * return: true if the exchanges worked
+ */
+bool DistributedFlock::settleClaims(){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int peerCount = fPeerTiles.size();
+    std::vector<uint32_t> counts(peerCount, 0);
+    for(int i=0; i<peerCount; i++){
+        beginMessage(&fOutgoing[i], kTileClaims, fFlock.getTick());
+    }
+    fFlock.getGhostClaims(&fGhostClaims);
+    for(int i=0; i<fGhostClaims.size(); i++){
+        Bird* ghost = fGhostClaims[i].first;
+        int peer = findPeer((double)ghost->getXPos(), (double)ghost->getYPos());
+        if(peer < 0) continue;
+        TileClaim record;
+        record.id = ghost->getId();
+        record.reserved = 0;
+        record.claim = fGhostClaims[i].second;
+        appendRecord(&fOutgoing[peer], record);
+        counts[peer]++;
+    }
+    for(int i=0; i<peerCount; i++){
+        setCount(&fOutgoing[i], counts[i]);
+    }
+    if(!fTransport->exchange(fOutgoing, &fIncoming)){
+        fError = fTransport->getError();
+        return false;
+    }
+
+    //every claim is added before any is compared, as two neighbours may claim the same Bird
+    for(int i=0; i<peerCount; i++){
+        const TileMessageHeader* header = readMessage(i, kTileClaims, sizeof(TileClaim));
+        if(!header) return false;
+        const TileClaim* claims = reinterpret_cast<const TileClaim*>(header + 1);
+        for(int j=0; j<header->count; j++){
+            fFlock.claimBird(claims[j].id, claims[j].claim);
+        }
+    }
+    for(int i=0; i<peerCount; i++){
+        const TileMessageHeader* header = reinterpret_cast<const TileMessageHeader*>(fIncoming[i].data());
+        const TileClaim* claims = reinterpret_cast<const TileClaim*>(header + 1);
+        beginMessage(&fOutgoing[i], kTileWinners, fFlock.getTick());
+        uint32_t count = 0;
+        for(int j=0; j<header->count; j++){
+            if(fFlock.getClaim(claims[j].id) != claims[j].claim) continue;
+            appendRecord(&fOutgoing[i], claims[j]);
+            count++;
+        }
+        setCount(&fOutgoing[i], count);
+    }
+    if(!fTransport->exchange(fOutgoing, &fIncoming)){
+        fError = fTransport->getError();
+        return false;
+    }
+
+    fWinners.clear();
+    for(int i=0; i<peerCount; i++){
+        const TileMessageHeader* header = readMessage(i, kTileWinners, sizeof(TileClaim));
+        if(!header) return false;
+        const TileClaim* winners = reinterpret_cast<const TileClaim*>(header + 1);
+        for(int j=0; j<header->count; j++){
+            fWinners.push_back(winners[j].id);
+        }
+    }
+    std::sort(fWinners.begin(), fWinners.end());
+    for(int i=0; i<fGhostClaims.size(); i++){
+        int id = fGhostClaims[i].first->getId();
+        if(!std::binary_search(fWinners.begin(), fWinners.end(), id)) fFlock.loseClaim(id);
+    }
+    fSettleSeconds += secondsSince(start);
+    return true;
+}
+
+/* readMessage
+ *
+ * inputs:
+ * - peer: index of the peer the message came from
+ * - kind: the TileMessageKind expected
+ * - recordSize: size of each record in it
+ *
+ * return: the header of the message, followed by its records, or 0 if it isn't what was expected
+ */
+const TileMessageHeader* DistributedFlock::readMessage(int peer, uint32_t kind, size_t recordSize){
+    const std::vector<uint8_t>& message = fIncoming[peer];
+    std::string from = "rank " + std::to_string(fTransport->getPeers()->at(peer));
+    if(message.size() < sizeof(TileMessageHeader)){
+        fError = "short message from " + from;
+        return 0;
+    }
+    const TileMessageHeader* header = reinterpret_cast<const TileMessageHeader*>(message.data());
+    if(header->magic != kTileMessageMagic || header->kind != kind ||
+       message.size() != sizeof(TileMessageHeader) + header->count*(uint64_t)recordSize){
+        fError = "bad message from " + from;
+        return 0;
+    }
+    if(header->tick != fFlock.getTick()){
+        fError = from + " is at tick " + std::to_string(header->tick) + ", not " + std::to_string(fFlock.getTick());
+        return 0;
+    }
+    return header;
+}
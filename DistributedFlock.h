@@ -0,0 +1,185 @@
+/* DistributedFlock.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for DistributedFlock, which runs one tile of a world that is split between several
+ * processes, so a flock too big for one machine can be spread over many. The world is cut into a
+ * grid of tilesX by tilesY tiles, and the process with rank r simulates tile (r % tilesX, r / tilesX)
+ * in a Flock of its own, which owns the Birds inside the tile. The tiles on the edges of the grid
+ * reach out past the edges of the world, so every Bird is always in a tile.
+ *
+ * Each tick, a process first hands the Birds that moved out of its tile over to the process whose
+ * tile they moved into. It then sends every neighbouring process copies of its Birds within the
+ * halo of that process's tile: the furthest any Bird can see, which is the largest detection or
+ * separation distance of any species. These copies are the ghosts of the neighbour's Flock (see
+ * Flock::setGhosts), which its Birds find as neighbours but which it doesn't move. As the ghosts
+ * are merged in id order, every Bird finds exactly the neighbours it would in one big Flock, in the
+ * same order, and the result is the same to the last bit. A Bird near the edge of a tile can be
+ * caught in the same tick by Predators in several tiles, so before the catches are eaten each
+ * process sends the claims its Predators made on ghosts (see Flock::claimCatch) to the processes
+ * that own them. The owner settles them with its own claims by the same rule, smallest first, kills
+ * the Birds other tiles won, and sends back which claims won, so only the nearest Predator of all
+ * eats each Bird, as in one Flock.
+ *
+ * Every process sets up the whole scenario with the same seed, so they all agree on the obstacles
+ * and the Birds, and then deletes the Birds outside its own tile. Each tile must be at least as
+ * wide and as tall as the halo, so only the eight tiles around a tile can ever matter to it.
+ */
+#ifndef DISTRIBUTEDFLOCK_H
+#define DISTRIBUTEDFLOCK_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Flock.h"
+#include "Checkpoint.h"
+
+class Scenario;
+class TileTransport;
+
+//the part of the world one process simulates, including its top and left edges but not the others
+struct DistributedTile
+{
+    int column;
+    int row;
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+};
+
+//a copy of a Bird sent to a neighbouring tile to be used as a ghost
+struct GhostRecord
+{
+    int32_t id;
+    int32_t species;
+    double x;
+    double y;
+    double vx;
+    double vy;
+};
+
+//the start of every message between tiles
+struct TileMessageHeader
+{
+    uint32_t magic;//kTileMessageMagic
+    uint32_t kind;//a TileMessageKind
+    int64_t tick;//tick of the Flock that sent it, so tiles that have lost step are noticed
+    uint32_t count;//records that follow
+    uint32_t reserved;//always 0, so the records start 8-byte aligned
+};
+
+//a claim on a Bird a Predator caught as a ghost, sent to the tile that owns the Bird (see Flock::claimBird)
+struct TileClaim
+{
+    int32_t id;//of the Bird
+    int32_t reserved;
+    uint64_t claim;
+};
+
+static const uint32_t kTileMessageMagic = 0x54465442;//"BTFT"
+
+//what a message between tiles holds
+enum TileMessageKind{
+    kTileHandover = 1,//CheckpointBirds moving into the tile
+    kTileHalo = 2,//GhostRecords of the Birds near the tile
+    kTileClaims = 3,//TileClaims on Birds the tile owns
+    kTileWinners = 4//the TileClaims of those sent to a tile that won
+};
+
+class DistributedFlock
+{
+public:
+
+    //Constructor. transport must already be connected to the neighbouring tiles (see getNeighbourRanks).
+    DistributedFlock(TileTransport* transport, int tilesX, int tilesY);
+
+    //Deconstructor. Deletes the ghosts, but not the transport.
+    virtual ~DistributedFlock();
+
+    /* sets up this process's tile of a scenario. Returns false, and sets the error, if the tiles are
+     * smaller than the halo the scenario needs. */
+    bool setup(const Scenario& scenario);
+
+    //simulates one tick. Returns false, and sets the error, if a neighbour couldn't be reached.
+    bool simulate();
+
+    //the tile of a rank in a world of the given size, split into tilesX by tilesY tiles
+    static DistributedTile getTile(int rank, int tilesX, int tilesY, int worldWidth, int worldHeight);
+
+    //ranks of the tiles around a rank's tile, in increasing order
+    static std::vector<int> getNeighbourRanks(int rank, int tilesX, int tilesY);
+
+    //largest distance any Bird of a scenario can see other Birds from
+    static double getHalo(const Scenario& scenario);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline Flock* getFlock(){return &fFlock;}
+    inline const DistributedTile* getTile()const{return &fTile;}
+    inline double const getHalo()const{return fHalo;}
+    inline std::string const getError()const{return fError;}
+    inline double const getExchangeSeconds()const{return fExchangeSeconds;}
+    inline double const getSimulateSeconds()const{return fSimulateSeconds;}
+    inline long long const getBirdsHandedOver()const{return fBirdsHandedOver;}
+    inline long long const getGhostsReceived()const{return fGhostsReceived;}
+    inline long long const getBirdsLost()const{return fBirdsLost;}
+
+private:
+
+    //hands over the Birds that have left the tile. Returns false if the exchange fails.
+    bool handOver();
+
+    //sends the Birds near each neighbour to it, and makes the ghosts from what comes back. Returns false if the exchange fails.
+    bool exchangeHalo();
+
+    //settles the claims on ghosts with the tiles that own them, while the Flock is simulating. Returns false if the exchange fails.
+    bool settleClaims();
+
+    //checks a message from a neighbour and finds the records that follow its header. Returns 0, and sets the error, if it isn't valid.
+    const TileMessageHeader* readMessage(int peer, uint32_t kind, size_t recordSize);
+
+    //the index in the transport's peers of the tile a position is in, or -1 if it isn't next to this one
+    int findPeer(double x, double y)const;
+
+    Flock fFlock;
+    TileTransport* fTransport;
+    int fTilesX;
+    int fTilesY;
+    DistributedTile fTile;
+    double fHalo;
+    std::string fError;
+
+    //tiles of the transport's peers, in the same order
+    std::vector<DistributedTile> fPeerTiles;
+
+    //messages to and from each peer, reused every exchange
+    std::vector<std::vector<uint8_t> > fOutgoing;
+    std::vector<std::vector<uint8_t> > fIncoming;
+
+    //Birds released by the Flock and Birds arriving from the neighbours, reused every tick
+    std::vector<Bird*> fLeaving;
+    std::vector<Bird*> fArriving;
+
+    //ghosts given to the Flock this tick, in id order, and the spare ghost Birds of each species kept for reuse
+    std::vector<Bird*> fGhosts;
+    std::vector<Bird*> fSpareGhosts[kOtherSpecies];
+    std::vector<GhostRecord> fGhostRecords;
+
+    /* Settling claims (see settleClaims). fGhostClaims and fWinners are reused every tick, and
+     * fSettleFailed is set if an exchange failed while the Flock was simulating. */
+    std::vector<std::pair<Bird*, uint64_t> > fGhostClaims;
+    std::vector<int32_t> fWinners;
+    bool fSettleFailed;
+    double fSettleSeconds;
+
+    //time spent exchanging and simulating, and totals of Birds moved
+    double fExchangeSeconds;
+    double fSimulateSeconds;
+    long long fBirdsHandedOver;
+    long long fGhostsReceived;
+    long long fBirdsLost;//Birds that moved further than a whole tile in one tick, so couldn't be handed over
+};
+
+#endif // DISTRIBUTEDFLOCK_H
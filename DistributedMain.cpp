@@ -0,0 +1,457 @@
+/* DistributedMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockDistributed, which runs a scenario split into tiles, one process per tile (see
+ * DistributedFlock.h). Usage:
+ *
+ *     BirdFlockDistributed scenario.toml --tiles CxR [--ticks N] [--seed N] [--threads N]
+ *                          [--set name=value] [--transport spec] [--rank r] [--verify]
+ *     BirdFlockDistributed scenario.toml --weak-scaling CxR,CxR,... [--ticks N] [--transport spec]
+ *
+ * --tiles splits the world into C columns and R rows of tiles. With --rank, this process runs only
+ * that tile and connects to the others through the transport, which is how a run is spread over
+ * several machines: start one process per tile, each with its own rank and the same scenario,
+ * options and a tcp: transport (see TileTransport.h). Without --rank, one process is started on
+ * this machine for each tile, connected by Unix sockets unless --transport says otherwise, and
+ * their results are gathered and printed.
+ *
+ * --verify also runs the scenario in a single Flock in this process, and checks that every Bird
+ * ends up exactly the same in both. Returns 1 if any is different, so it can be used as a test of
+ * the whole distributed path, transports included.
+ *
+ * --weak-scaling runs the scenario once for each tiling in the list, with the world and every count
+ * in it grown by the number of tiles, so every process always has the same amount of work. Ideally
+ * the time per tick stays the same; the efficiency printed is the time of the first tiling over the
+ * time of each. The processes share this machine's cores, so the tilings are only fair up to the
+ * number of cores.
+ *
+ * --set changes any number setting of the scenario, e.g. --set species.red.count=10. --threads is
+ * the threads each process uses, by default the cores shared out between the processes.
+ */
+#include "DistributedFlock.h"
+#include "TileTransport.h"
+#include "Scenario.h"
+#include "Checkpoint.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//ticks run if neither the scenario nor --ticks says
+static const long long kDefaultTicks = 200;
+
+//what each tile's process reports when it finishes, followed by its Birds if they are wanted
+struct TileResult
+{
+    int32_t rank;
+    int32_t succeeded;
+    int32_t birdCount;//Birds owned at the end
+    int32_t savedBirds;//CheckpointBirds that follow
+    int64_t ticks;
+    double seconds;//time to run all the ticks
+    double simulateSeconds;
+    double exchangeSeconds;
+    int64_t handedOver;
+    int64_t ghosts;
+    int64_t lost;
+    int64_t bytesSent;
+};
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockDistributed scenario.toml --tiles CxR [--ticks N] [--seed N] [--threads N]" << std::endl
+              << "                            [--set name=value] [--transport spec] [--rank r] [--verify]" << std::endl
+              << "       BirdFlockDistributed scenario.toml --weak-scaling CxR,CxR,... [--ticks N] [--transport spec]" << std::endl
+              << "transports: unix:path, tcp:host[,host...]:port, shm:name" << std::endl;
+}
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//reads a tiling such as "3x2". Returns false if it isn't one.
+static bool parseTiles(const std::string& text, int* tilesX, int* tilesY){
+    return sscanf(text.c_str(), "%dx%d", tilesX, tilesY) == 2 && *tilesX > 0 && *tilesY > 0;
+}
+
+/* runTile
+ *
+ * Runs one tile of a scenario in this process.
+ *
+ * inputs:
+ * - scenario: the whole scenario
+ * - tilesX, tilesY: the tiling
+ * - rank: the tile to run
+ * - spec: the transport to the other tiles
+ * - birds: if not 0, filled with every Bird the tile owns at the end, in id order
+ * - result: filled in with what happened
+ *
+ * return: true if every tick was run
+ */
+static bool runTile(const Scenario& scenario, int tilesX, int tilesY, int rank, const std::string& spec,
+                    std::vector<CheckpointBird>* birds, TileResult* result){
+    memset(result, 0, sizeof(*result));
+    result->rank = rank;
+
+    std::string error;
+    TileTransport* transport = TileTransport::create(spec, rank, tilesX*tilesY, DistributedFlock::getNeighbourRanks(rank, tilesX, tilesY), &error);
+    if(!transport){
+        std::cerr << "rank " << rank << ": " << error << std::endl;
+        return false;
+    }
+
+    DistributedFlock* tile = new DistributedFlock(transport, tilesX, tilesY);
+    bool succeeded = tile->setup(scenario);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(long long tick=0; succeeded && tick<scenario.getTicks(); tick++){
+        succeeded = tile->simulate();
+        result->ticks++;
+    }
+    result->seconds = secondsSince(start);
+    if(!succeeded) std::cerr << "rank " << rank << ": " << tile->getError() << std::endl;
+
+    Flock* flock = tile->getFlock();
+    for(int i=0; i<flock->getBirds()->size(); i++){
+        Bird* b = flock->getBirds()->at(i);
+        if(b->getIsDead()) continue;
+        result->birdCount++;
+        if(!birds) continue;
+        CheckpointBird saved;
+        Flock::saveBird(b, &saved);
+        birds->push_back(saved);
+    }
+    result->succeeded = succeeded;
+    result->savedBirds = birds ? birds->size() : 0;
+    result->simulateSeconds = tile->getSimulateSeconds();
+    result->exchangeSeconds = tile->getExchangeSeconds();
+    result->handedOver = tile->getBirdsHandedOver();
+    result->ghosts = tile->getGhostsReceived();
+    result->lost = tile->getBirdsLost();
+    result->bytesSent = transport->getBytesSent();
+
+    delete tile;
+    delete transport;
+    return succeeded;
+}
+
+//writes all of data to a pipe
+static void writeAll(int pipe, const void* data, size_t size){
+    const char* bytes = static_cast<const char*>(data);
+    while(size > 0){
+        ssize_t n = write(pipe, bytes, size);
+        if(n <= 0) return;
+        bytes += n;
+        size -= n;
+    }
+}
+
+//reads size bytes from a pipe. Returns false if it ends first.
+static bool readAll(int pipe, void* data, size_t size){
+    char* bytes = static_cast<char*>(data);
+    while(size > 0){
+        ssize_t n = read(pipe, bytes, size);
+        if(n <= 0) return false;
+        bytes += n;
+        size -= n;
+    }
+    return true;
+}
+
+/* runLocal
+ *
+ * Starts a process for every tile on this machine, and gathers what each reports through a pipe.
+ * Nothing here has started a thread yet, so forking is safe.
+ *
+ * inputs:
+ * - scenario, tilesX, tilesY, spec: as for runTile
+ * - birds: if not 0, filled with the Birds of every tile
+ * - results: filled with the result of each tile, in rank order
+ *
+ * return: true if every tile ran every tick
+ */
+static bool runLocal(const Scenario& scenario, int tilesX, int tilesY, const std::string& spec,
+                     std::vector<CheckpointBird>* birds, std::vector<TileResult>* results){
+    int tileCount = tilesX*tilesY;
+    std::vector<pid_t> children;
+    std::vector<int> pipes;
+    std::cout.flush();
+    for(int rank=0; rank<tileCount; rank++){
+        int ends[2];
+        if(pipe(ends) != 0) break;
+        pid_t child = fork();
+        if(child == 0){
+            ::close(ends[0]);
+            std::vector<CheckpointBird> tileBirds;
+            TileResult result;
+            runTile(scenario, tilesX, tilesY, rank, spec, birds ? &tileBirds : 0, &result);
+            writeAll(ends[1], &result, sizeof(result));
+            if(!tileBirds.empty()) writeAll(ends[1], tileBirds.data(), tileBirds.size()*sizeof(CheckpointBird));
+            ::close(ends[1]);
+            _exit(0);
+        }
+        ::close(ends[1]);
+        if(child < 0){
+            ::close(ends[0]);
+            break;
+        }
+        children.push_back(child);
+        pipes.push_back(ends[0]);
+    }
+
+    //a tile only writes once it has finished every tick, so reading them in order can't hold any up
+    bool succeeded = children.size() == tileCount;
+    results->assign(children.size(), TileResult());
+    for(int i=0; i<pipes.size(); i++){
+        TileResult& result = results->at(i);
+        if(!readAll(pipes[i], &result, sizeof(result))){
+            memset(&result, 0, sizeof(result));
+            result.rank = i;
+        }
+        succeeded &= result.succeeded != 0;
+        if(birds && result.savedBirds > 0){
+            size_t first = birds->size();
+            birds->resize(first + result.savedBirds);
+            succeeded &= readAll(pipes[i], birds->data() + first, result.savedBirds*sizeof(CheckpointBird));
+        }
+        ::close(pipes[i]);
+    }
+    for(int i=0; i<children.size(); i++){
+        int status;
+        waitpid(children[i], &status, 0);
+    }
+    return succeeded;
+}
+
+/* verify
+ *
+ * Runs the scenario in one Flock, and compares every Bird with those the tiles ended with.
+ *
+ * inputs:
+ * - scenario: the scenario the tiles ran
+ * - birds: the Birds of every tile
+ *
+ * return: true if they are all exactly the same
+ */
+static bool verify(const Scenario& scenario, std::vector<CheckpointBird>* birds){
+    Flock flock;
+    scenario.apply(&flock);
+    for(long long tick=0; tick<scenario.getTicks(); tick++){
+        flock.simulateFlock();
+    }
+    std::vector<CheckpointBird> expected;
+    for(int i=0; i<flock.getBirds()->size(); i++){
+        Bird* b = flock.getBirds()->at(i);
+        if(b->getIsDead()) continue;
+        CheckpointBird saved;
+        Flock::saveBird(b, &saved);
+        expected.push_back(saved);
+    }
+
+    std::sort(birds->begin(), birds->end(), [](const CheckpointBird& a, const CheckpointBird& b){return a.id < b.id;});
+    int different = 0;
+    size_t compared = std::min(birds->size(), expected.size());
+    for(size_t i=0; i<compared; i++){
+        const CheckpointBird& got = birds->at(i);
+        const CheckpointBird& want = expected[i];
+        if(memcmp(&got, &want, sizeof(got)) == 0) continue;
+        if(different++ < 5){
+            std::cout << "bird " << want.id << ": expected (" << want.x << ", " << want.y << ") got bird " << got.id
+                      << " at (" << got.x << ", " << got.y << ")" << std::endl;
+        }
+    }
+    if(birds->size() != expected.size()){
+        std::cout << "expected " << expected.size() << " birds, the tiles have " << birds->size() << std::endl;
+    }
+    bool same = different == 0 && birds->size() == expected.size();
+    std::cout << "verify: " << (same ? "all " : "") << expected.size() << " birds " << (same ? "match" : "expected")
+              << " a single flock after " << scenario.getTicks() << " ticks";
+    if(!same) std::cout << ", " << different << " differ";
+    std::cout << std::endl;
+    return same;
+}
+
+//prints one line for each tile, and returns the time per tick of the slowest
+static double printResults(const std::vector<TileResult>& results){
+    double slowest = 0;
+    for(int i=0; i<results.size(); i++){
+        const TileResult& result = results[i];
+        double ticks = std::max<int64_t>(1, result.ticks);
+        std::cout << "rank " << result.rank << ": " << result.birdCount << " birds, " << result.seconds/ticks*1000
+                  << " ms per tick (" << result.simulateSeconds/ticks*1000 << " simulating, "
+                  << result.exchangeSeconds/ticks*1000 << " exchanging), " << result.ghosts/ticks << " ghosts and "
+                  << result.handedOver/ticks << " handed over per tick, " << result.bytesSent/ticks/1024 << " kB sent per tick";
+        if(result.lost > 0) std::cout << ", " << result.lost << " lost";
+        std::cout << std::endl;
+        slowest = std::max(slowest, result.seconds/ticks);
+    }
+    return slowest;
+}
+
+/* weakScaling
+ *
+ * Runs the scenario once for each tiling, grown so each tile has the same size and number of Birds
+ * as the original scenario, and prints the time per tick of each.
+ *
+ * inputs:
+ * - scenario: the scenario for one tile
+ * - tilings: list of tilings, e.g. "1x1,2x1,2x2"
+ * - spec: transport, or "" for Unix sockets
+ *
+ * return: the exit code of the program
+ */
+static int weakScaling(const Scenario& scenario, const std::string& tilings, const std::string& spec, int threads){
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "weak scaling of " << scenario.getTicks() << " ticks on " << cores << " cores" << std::endl;
+
+    double baseline = 0;
+    size_t start = 0;
+    for(int run=0; start < tilings.size(); run++){
+        size_t comma = tilings.find(',', start);
+        if(comma == std::string::npos) comma = tilings.size();
+        std::string tiling = tilings.substr(start, comma - start);
+        start = comma + 1;
+        int tilesX, tilesY;
+        if(!parseTiles(tiling, &tilesX, &tilesY)){
+            std::cerr << "not a tiling: " << tiling << std::endl;
+            return 1;
+        }
+
+        int tileCount = tilesX*tilesY;
+        Scenario grown = scenario;
+        grown.setSetting("world.width", scenario.getWorldWidth()*tilesX);
+        grown.setSetting("world.height", scenario.getWorldHeight()*tilesY);
+        grown.setSetting("obstacles.count", scenario.getObstacleCount()*tileCount);
+        const char* names[kOtherSpecies] = {"blue", "green", "red"};
+        for(int species=0; species<kOtherSpecies; species++){
+            grown.setSetting(std::string("species.") + names[species] + ".count", (double)scenario.getSpeciesCount(species)*tileCount);
+        }
+        grown.setThreads(threads >= 0 ? threads : std::max(1, cores/tileCount));
+
+        std::string runSpec = spec.empty() ? "unix:/tmp/birdflock-" + std::to_string(getpid()) + "-" + std::to_string(run) : spec;
+        std::vector<TileResult> results;
+        if(!runLocal(grown, tilesX, tilesY, runSpec, 0, &results)){
+            std::cerr << tiling << " failed" << std::endl;
+            return 1;
+        }
+        double perTick = printResults(results);
+        if(run == 0) baseline = perTick;
+        std::cout << tiling << ": " << tileCount << " tiles, " << grown.getWorldWidth() << " x " << grown.getWorldHeight()
+                  << " world, " << perTick*1000 << " ms per tick, efficiency " << (perTick > 0 ? baseline/perTick : 0)
+                  << (tileCount > cores ? " (more processes than cores)" : "") << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    int tilesX = 0, tilesY = 0;
+    int rank = -1;
+    int threads = -1;
+    long long ticks = -1;
+    const char* seed = 0;
+    bool check = false;
+    std::string spec, tilings;
+    std::vector<std::string> settings;
+    for(int i=2; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--tiles") == 0){
+            if(!parseTiles(argv[++i], &tilesX, &tilesY)){
+                printUsage();
+                return 1;
+            }
+        }
+        else if(hasValue && strcmp(argv[i], "--rank") == 0) rank = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--ticks") == 0) ticks = atoll(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seed") == 0) seed = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--threads") == 0) threads = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--set") == 0) settings.push_back(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--transport") == 0) spec = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--weak-scaling") == 0) tilings = argv[++i];
+        else if(strcmp(argv[i], "--verify") == 0) check = true;
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+    if(tilesX == 0 && tilings.empty()){
+        printUsage();
+        return 1;
+    }
+
+    Scenario scenario;
+    if(!scenario.load(argv[1])){
+        std::cerr << scenario.getError() << std::endl;
+        return 1;
+    }
+    for(int i=0; i<settings.size(); i++){
+        size_t equals = settings[i].find('=');
+        double number;
+        if(equals == std::string::npos || !Scenario::parseNumber(settings[i].substr(equals + 1), &number) ||
+           !scenario.setSetting(settings[i].substr(0, equals), number)){
+            std::cerr << "can't set " << settings[i] << std::endl;
+            return 1;
+        }
+    }
+    if(ticks >= 0) scenario.setTicks(ticks);
+    if(scenario.getTicks() <= 0) scenario.setTicks(kDefaultTicks);
+
+    //every process must start from the same Birds, so a seed is always picked here
+    if(seed) scenario.setSeed(strtoull(seed, 0, 10));
+    else if(!scenario.hasSeed()) scenario.setSeed(time(NULL));
+
+    if(!tilings.empty()) return weakScaling(scenario, tilings, spec, threads);
+
+    //checked here as well as by each tile, so a bad tiling gives one message rather than one per tile
+    double halo = DistributedFlock::getHalo(scenario);
+    if(halo > (double)scenario.getWorldWidth()/tilesX || halo > (double)scenario.getWorldHeight()/tilesY){
+        std::cerr << "the tiles are smaller than the furthest a Bird can see (" << halo << "): use fewer tiles" << std::endl;
+        return 1;
+    }
+
+    int tileCount = tilesX*tilesY;
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    scenario.setThreads(threads >= 0 ? threads : rank >= 0 ? 0 : std::max(1, cores/tileCount));
+    if(spec.empty()) spec = "unix:/tmp/birdflock-" + std::to_string(getpid());
+
+    //one tile of a run spread over several machines
+    if(rank >= 0){
+        if(rank >= tileCount){
+            std::cerr << "rank " << rank << " is not one of the " << tileCount << " tiles" << std::endl;
+            return 1;
+        }
+        TileResult result;
+        bool succeeded = runTile(scenario, tilesX, tilesY, rank, spec, 0, &result);
+        printResults(std::vector<TileResult>(1, result));
+        return succeeded ? 0 : 1;
+    }
+
+    std::cout << "seed " << scenario.getSeed() << ", " << tilesX << " x " << tilesY << " tiles over " << spec << ", "
+              << scenario.getTicks() << " ticks" << std::endl;
+    std::vector<CheckpointBird> birds;
+    std::vector<TileResult> results;
+    bool succeeded = runLocal(scenario, tilesX, tilesY, spec, check ? &birds : 0, &results);
+    double perTick = printResults(results);
+    long long total = 0;
+    for(int i=0; i<results.size(); i++) total += results[i].birdCount;
+    std::cout << total << " birds, " << perTick*1000 << " ms per tick" << std::endl;
+    if(!succeeded) return 1;
+    if(check && !verify(scenario, &birds)) return 1;
+    return 0;
+}
@@ -0,0 +1,219 @@
+/* DriftMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockDrift, which compares two recordings of the same scenario, usually one made by
+ * the normal build and one by the float or fixed build (see TwoVector.h), or one made with some
+ * behaviours worked out less often than every tick (see Flock::setBehaviourInterval):
+ *
+ *     BirdFlockHeadless scenario.toml --seed 1 --ticks 10000 --record double.bftr
+ *     BirdFlockHeadlessFloat scenario.toml --seed 1 --ticks 10000 --record float.bftr
+ *     BirdFlockDrift double.bftr float.bftr [--every N]
+ *
+ * Flocking is chaotic, so the two runs soon stop agreeing about where each Bird is, however close
+ * they start; what matters is that the flock still behaves the same way. So every N ticks (500 by
+ * default) it prints, for each recording, the number of Birds left, how well each species is
+ * aligned (its polarisation: the length of the average of its Birds' directions, 1 when they all fly
+ * the same way) and how far each Bird is from the nearest Bird of its species on average. It also
+ * prints the drift: how far apart the same Bird is in the two recordings, on average. At the end it
+ * prints how long it took for the drift to pass one unit of distance, and the averages of the
+ * polarisation and nearest distances of each recording over the whole run. Any one sample of a
+ * small flock swings a lot, so it is the averages that should agree; two runs of the same build
+ * with different seeds show how closely they can be expected to.
+ */
+#include "TrajectoryReader.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+//what is measured about one recording at one tick
+struct DriftSample
+{
+    int birds;
+    double polarisation[2];//of blue and green
+    double nearest[2];//mean distance to the nearest Bird of the same species, of blue and green
+};
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockDrift reference.bftr other.bftr [--every N]" << std::endl;
+}
+
+/* measure
+ *
+ * Works out the polarisation and nearest neighbour distances of a frame. The nearest Birds are
+ * found with a grid of cells as wide as the search, searched outwards ring by ring.
+ *
+ * inputs:
+ * - frame: the frame
+ * - header: header of its recording, for the scales and size of the world
+ *
+ * return: the measurements
+ */
+static DriftSample measure(const TrajectoryFrame& frame, const TrajectoryHeader* header){
+    DriftSample sample;
+    sample.birds = frame.size();
+    const double cellSize = 50;
+    int columns = std::max(1, (int)std::ceil(header->worldWidth/cellSize));
+    int rows = std::max(1, (int)std::ceil(header->worldHeight/cellSize));
+
+    for(int species=0; species<2; species++){
+        std::vector<std::vector<int> > cells(columns*rows);
+        double sumX = 0, sumY = 0;
+        int count = 0;
+        for(int i=0; i<frame.size(); i++){
+            if(frame.species[i] != species) continue;
+            double vx = frame.vx[i], vy = frame.vy[i];
+            double speed = std::sqrt(vx*vx + vy*vy);
+            if(speed > 0){
+                sumX += vx/speed;
+                sumY += vy/speed;
+            }
+            int column = std::min(std::max((int)(frame.x[i]/header->positionScale/cellSize), 0), columns-1);
+            int row = std::min(std::max((int)(frame.y[i]/header->positionScale/cellSize), 0), rows-1);
+            cells[row*columns + column].push_back(i);
+            count++;
+        }
+        sample.polarisation[species] = count > 0 ? std::sqrt(sumX*sumX + sumY*sumY)/count : 0;
+
+        double totalNearest = 0;
+        int found = 0;
+        for(int i=0; i<frame.size() && count > 1; i++){
+            if(frame.species[i] != species) continue;
+            double x = (double)frame.x[i]/header->positionScale, y = (double)frame.y[i]/header->positionScale;
+            int column = std::min(std::max((int)(x/cellSize), 0), columns-1);
+            int row = std::min(std::max((int)(y/cellSize), 0), rows-1);
+
+            //search rings of cells until the ring is further away than the nearest Bird found
+            double best = -1;
+            for(int ring=0; ring<std::max(columns, rows); ring++){
+                if(best >= 0 && (ring-1)*cellSize > best) break;
+                for(int r=row-ring; r<=row+ring; r++){
+                    for(int c=column-ring; c<=column+ring; c++){
+                        if(r < 0 || r >= rows || c < 0 || c >= columns) continue;
+                        if(std::max(std::abs(r-row), std::abs(c-column)) != ring) continue;
+                        const std::vector<int>& cell = cells[r*columns + c];
+                        for(int k=0; k<cell.size(); k++){
+                            if(cell[k] == i) continue;
+                            double dx = (double)frame.x[cell[k]]/header->positionScale - x;
+                            double dy = (double)frame.y[cell[k]]/header->positionScale - y;
+                            double distance = std::sqrt(dx*dx + dy*dy);
+                            if(best < 0 || distance < best) best = distance;
+                        }
+                    }
+                }
+            }
+            if(best >= 0){
+                totalNearest += best;
+                found++;
+            }
+        }
+        sample.nearest[species] = found > 0 ? totalNearest/found : 0;
+    }
+    return sample;
+}
+
+//the mean distance between the Birds in both frames, matched by id
+static double drift(const TrajectoryFrame& a, const TrajectoryFrame& b, double scaleA, double scaleB){
+    std::vector<std::pair<int, int> > idsA, idsB;
+    for(int i=0; i<a.size(); i++) idsA.push_back(std::make_pair(a.ids[i], i));
+    for(int i=0; i<b.size(); i++) idsB.push_back(std::make_pair(b.ids[i], i));
+    std::sort(idsA.begin(), idsA.end());
+    std::sort(idsB.begin(), idsB.end());
+
+    double total = 0;
+    int matched = 0;
+    int i = 0, j = 0;
+    while(i < idsA.size() && j < idsB.size()){
+        if(idsA[i].first < idsB[j].first) i++;
+        else if(idsB[j].first < idsA[i].first) j++;
+        else{
+            int p = idsA[i].second, q = idsB[j].second;
+            double dx = a.x[p]/scaleA - b.x[q]/scaleB;
+            double dy = a.y[p]/scaleA - b.y[q]/scaleB;
+            total += std::sqrt(dx*dx + dy*dy);
+            matched++;
+            i++;
+            j++;
+        }
+    }
+    return matched > 0 ? total/matched : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    long long every = 500;
+    for(int i=3; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--every") == 0) every = std::max(1LL, atoll(argv[++i]));
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    TrajectoryReader readers[2];
+    for(int r=0; r<2; r++){
+        if(!readers[r].open(argv[1 + r]) || readers[r].getFrameCount() == 0){
+            std::cerr << "can't read " << argv[1 + r] << std::endl;
+            return 1;
+        }
+    }
+    unsigned long long lastTick = std::min(readers[0].getTick(readers[0].getFrameCount() - 1),
+                                           readers[1].getTick(readers[1].getFrameCount() - 1));
+
+    //frames are copied, as each reader's frame is only valid until it reads the next
+    double totalPolarisation[2][2] = {{0, 0}, {0, 0}}, totalNearest[2][2] = {{0, 0}, {0, 0}};
+    int samples = 0;
+    long long driftedAt = -1;
+    for(unsigned long long tick=0; tick<=lastTick; tick+=every){
+        TrajectoryFrame frames[2];
+        DriftSample measured[2];
+        bool found = true;
+        for(int r=0; r<2 && found; r++){
+            int index = readers[r].findFrame(tick);
+            const TrajectoryFrame* frame = index >= 0 ? readers[r].readFrame(index) : 0;
+            found = frame != 0;
+            if(!found) break;
+            frames[r] = *frame;
+            measured[r] = measure(frames[r], readers[r].getHeader());
+        }
+        if(!found) continue;
+
+        double apart = drift(frames[0], frames[1], readers[0].getHeader()->positionScale, readers[1].getHeader()->positionScale);
+        if(driftedAt < 0 && apart > 1) driftedAt = tick;
+        std::cout << "tick " << tick << ": birds " << measured[0].birds << " / " << measured[1].birds
+                  << ", polarisation blue " << measured[0].polarisation[0] << " / " << measured[1].polarisation[0]
+                  << ", green " << measured[0].polarisation[1] << " / " << measured[1].polarisation[1]
+                  << ", nearest blue " << measured[0].nearest[0] << " / " << measured[1].nearest[0]
+                  << ", green " << measured[0].nearest[1] << " / " << measured[1].nearest[1]
+                  << ", drift " << apart << std::endl;
+        for(int r=0; r<2; r++){
+            for(int species=0; species<2; species++){
+                totalPolarisation[r][species] += measured[r].polarisation[species];
+                totalNearest[r][species] += measured[r].nearest[species];
+            }
+        }
+        samples++;
+    }
+
+    if(driftedAt >= 0) std::cout << "the same Birds were over a unit apart by tick " << driftedAt << std::endl;
+    else std::cout << "the same Birds stayed within a unit of each other" << std::endl;
+    const char* names[2] = {"blue", "green"};
+    for(int species=0; species<2 && samples > 0; species++){
+        std::cout << "average " << names[species] << " polarisation " << totalPolarisation[0][species]/samples << " / "
+                  << totalPolarisation[1][species]/samples << ", nearest " << totalNearest[0][species]/samples << " / "
+                  << totalNearest[1][species]/samples << std::endl;
+    }
+    return 0;
+}
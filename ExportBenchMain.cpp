@@ -0,0 +1,161 @@
+/* ExportBenchMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockExportBench, which measures how fast a Flock can be published into shared memory
+ * and read back out. Usage:
+ *
+ *     BirdFlockExportBench scenario.toml [--ticks N] [--seconds S] [--readers N]
+ *
+ * First the scenario is simulated for --ticks ticks (100 by default), publishing every tick, to
+ * show what exporting adds to a tick. Then the last tick is published over and over for --seconds
+ * seconds (1 by default), to find the most the writer can publish. Throughout, --readers threads
+ * (1 by default) copy out the newest frame as fast as they can, and count how many frames they got,
+ * how many they skipped, and how many reads the writer overwrote.
+ */
+#include "Flock.h"
+#include "Scenario.h"
+#include "SharedFlockWriter.h"
+#include "SharedFlockReader.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockExportBench scenario.toml [--ticks N] [--seconds S] [--readers N]" << std::endl;
+}
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//what one reader thread managed
+struct ReaderResult
+{
+    uint64_t framesRead;
+    uint64_t framesSkipped;
+    uint64_t tornReads;
+    uint64_t bytesRead;
+};
+
+/* readFrames
+ *
+ * Copies out the newest frame over and over until told to stop.
+ *
+ * inputs:
+ * - name: name of the region
+ * - stop: set when the reader should finish
+ * - result: set to what the reader managed
+ */
+static void readFrames(std::string name, const std::atomic<bool>* stop, ReaderResult* result){
+    SharedFlockReader reader;
+    SharedFlockFrame frame;
+    uint64_t bytes = 0;
+    if(reader.open(name)){
+        while(!stop->load(std::memory_order_relaxed)){
+            if(reader.readLatest(&frame)){
+                bytes += frame.x.size()*(4*sizeof(float) + sizeof(int32_t) + sizeof(uint8_t));
+            }
+        }
+    }
+    result->framesRead = reader.getFramesRead();
+    result->framesSkipped = reader.getFramesSkipped();
+    result->tornReads = reader.getTornReads();
+    result->bytesRead = bytes;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    long long ticks = 100;
+    double seconds = 1;
+    int readerCount = 1;
+    for(int i=2; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--ticks") == 0) ticks = atoll(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seconds") == 0) seconds = atof(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--readers") == 0) readerCount = atoi(argv[++i]);
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    Scenario scenario;
+    if(!scenario.load(argv[1])){
+        std::cerr << scenario.getError() << std::endl;
+        return 1;
+    }
+    Flock flock;
+    scenario.apply(&flock);
+    int birdCount = flock.getBirds()->size();
+
+    //named after the process, so two benchmarks at once don't share a region
+    std::string name = "/birdflock-bench-" + std::to_string(getpid());
+    SharedFlockWriter writer;
+    if(!writer.open(name, birdCount)){
+        std::cerr << "can't create shared memory " << name << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> stop(false);
+    std::vector<ReaderResult> results(readerCount);
+    std::vector<std::thread> readers;
+    for(int i=0; i<readerCount; i++){
+        readers.push_back(std::thread(readFrames, name, &stop, &results[i]));
+    }
+
+    //simulate, timing the ticks and the publishing separately
+    double simulateTime = 0;
+    double publishTime = 0;
+    for(long long t=0; t<ticks; t++){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        flock.simulateFlock();
+        simulateTime += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        writer.publish(&flock);
+        publishTime += secondsSince(start);
+    }
+
+    //publish the same tick as fast as possible
+    long long publishes = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double floodTime = 0;
+    while(floodTime < seconds){
+        writer.publish(&flock);
+        publishes++;
+        floodTime = secondsSince(start);
+    }
+
+    stop.store(true);
+    for(int i=0; i<readerCount; i++) readers[i].join();
+    writer.close();
+
+    double frameMB = sharedFlockSlotBytes(birdCount)/1e6;
+    std::cout << birdCount << " birds, " << frameMB*1000 << " kB per frame" << std::endl;
+    std::cout << "simulating: " << (ticks > 0 ? simulateTime/ticks*1000 : 0) << " ms per tick, publishing "
+              << (ticks > 0 ? publishTime/ticks*1000 : 0) << " ms per tick ("
+              << (simulateTime > 0 ? publishTime/simulateTime*100 : 0) << "% extra)" << std::endl;
+    std::cout << "publishing only: " << publishes/floodTime << " frames/s, " << publishes*frameMB/floodTime << " MB/s" << std::endl;
+    for(int i=0; i<readerCount; i++){
+        double readTime = simulateTime + publishTime + floodTime;
+        std::cout << "reader " << i << ": " << results[i].framesRead << " frames read (" << results[i].framesRead/readTime
+                  << " frames/s, " << results[i].bytesRead/1e6/readTime << " MB/s), " << results[i].framesSkipped
+                  << " skipped, " << results[i].tornReads << " reads overwritten" << std::endl;
+    }
+    return 0;
+}
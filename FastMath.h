@@ -0,0 +1,127 @@
+/* FastMath.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for the few transcendental functions the simulation and the drawing use over and over:
+ * one over a square root (for unit vectors), the angle of a vector (for headings), and the sine and
+ * cosine of an angle together (for drawing birds). Each comes in an exact version, which is what
+ * the standard library gives, and a fast version, which is a few multiplications and is accurate
+ * to well under what the screen can show:
+ *
+ * - fastInverseSqrt: relative error below 5e-7 for float (5e-6 without SSE) and 1e-10 for double
+ * - fastAtan2: error below 2e-6 radians
+ * - fastSinCos: error below 4e-7 for double and 2e-6 for float
+ *
+ * inverseSqrt, angleOf and sinCos are the ones the rest of the code calls. They are the exact
+ * versions, unless built with BIRDFLOCK_FAST_MATH defined (qmake "DEFINES+=BIRDFLOCK_FAST_MATH"),
+ * in which case they are the fast ones. Runs of the fast build only match other runs of the fast
+ * build.
+ */
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "Fixed.h"
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+//1/sqrt(x), as the standard library gives it
+template<typename T>
+inline T exactInverseSqrt(T x){return (T)1/std::sqrt(x);}
+
+/* 1/sqrt(x) from a guess improved with Newton's method, each step of which roughly doubles the
+ * number of correct digits. For float the guess is the processor's own estimate where there is
+ * one (SSE), which is good to 12 bits; otherwise, and for double, it is made by treating the bits
+ * of x as an integer, which halves and negates the exponent. x must be positive. */
+inline float fastInverseSqrt(float x){
+#ifdef __SSE__
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y*(1.5f - 0.5f*x*y*y);
+#else
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f375a86 - (bits >> 1);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    y = y*(1.5f - 0.5f*x*y*y);
+    y = y*(1.5f - 0.5f*x*y*y);
+    return y;
+#endif
+}
+inline double fastInverseSqrt(double x){
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5fe6eb50c7b537a9ULL - (bits >> 1);
+    double y;
+    memcpy(&y, &bits, sizeof(y));
+    y = y*(1.5 - 0.5*x*y*y);
+    y = y*(1.5 - 0.5*x*y*y);
+    y = y*(1.5 - 0.5*x*y*y);
+    return y;
+}
+
+//angle of the vector (x, y) from the x axis, in radians between -pi and pi
+template<typename T>
+inline T exactAtan2(T y, T x){return std::atan2(y, x);}
+
+/* Angle of the vector (x, y) from the x axis, in radians between -pi and pi. Works out the angle of
+ * whichever of y/x or x/y is at most 1 with a polynomial, then moves it into the right octant. 0 for
+ * the zero vector. */
+template<typename T>
+inline T fastAtan2(T y, T x){
+    T ax = std::fabs(x), ay = std::fabs(y);
+    T largest = ax > ay ? ax : ay;
+    if(largest == 0) return 0;
+    T a = (ax > ay ? ay : ax)/largest;
+    T s = a*a;
+    T angle = a*((T)0.99997726 + s*((T)-0.33262347 + s*((T)0.19354346 + s*((T)-0.11643287 + s*((T)0.05265332 + s*(T)-0.01172120)))));
+    if(ay > ax) angle = (T)1.5707963267948966 - angle;
+    if(x < 0) angle = (T)3.141592653589793 - angle;
+    return y < 0 ? -angle : angle;
+}
+
+//sine and cosine of an angle in radians, as the standard library gives them
+template<typename T>
+inline void exactSinCos(T angle, T* sine, T* cosine){
+    *sine = std::sin(angle);
+    *cosine = std::cos(angle);
+}
+
+/* Sine and cosine of an angle in radians. The angle is moved to within pi/4 of 0 by taking off a
+ * whole number of quarter turns, where short Taylor series of both are accurate, and the quarter
+ * turns then say which one is which and their signs. */
+template<typename T>
+inline void fastSinCos(T angle, T* sine, T* cosine){
+    T turns = std::floor(angle*(T)0.6366197723675814 + (T)0.5);//quarter turns, rounded
+    T r = angle - turns*(T)1.5707963267948966;
+    T r2 = r*r;
+    T s = r*((T)1 + r2*((T)-1/6 + r2*((T)1/120 + r2*((T)-1/5040))));
+    T c = (T)1 + r2*((T)-0.5 + r2*((T)1/24 + r2*((T)-1/720 + r2*((T)1/40320))));
+    switch((int)((long long)turns & 3)){
+    case 0: *sine = s; *cosine = c; break;
+    case 1: *sine = c; *cosine = -s; break;
+    case 2: *sine = -s; *cosine = -c; break;
+    default: *sine = -c; *cosine = s; break;
+    }
+}
+
+//the versions used by the rest of the code, chosen when it is built
+#ifdef BIRDFLOCK_FAST_MATH
+template<typename T> inline T inverseSqrt(T x){return fastInverseSqrt(x);}
+template<typename T> inline T angleOf(T x, T y){return fastAtan2(y, x);}
+template<typename T> inline void sinCos(T angle, T* sine, T* cosine){fastSinCos(angle, sine, cosine);}
+#else
+template<typename T> inline T inverseSqrt(T x){return exactInverseSqrt(x);}
+template<typename T> inline T angleOf(T x, T y){return exactAtan2(y, x);}
+template<typename T> inline void sinCos(T angle, T* sine, T* cosine){exactSinCos(angle, sine, cosine);}
+#endif
+
+/* Fixed has only the one version of each, worked out with integer arithmetic (see Fixed.h), so the
+ * fixed build gives the same results whether or not BIRDFLOCK_FAST_MATH is defined. */
+inline Fixed inverseSqrt(Fixed x){return Fixed(1)/sqrt(x);}
+inline Fixed angleOf(Fixed x, Fixed y){return atan2(y, x);}
+
+#endif // FASTMATH_H
@@ -0,0 +1,215 @@
+/* Fixed.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for Fixed, a number stored as a 64 bit integer counting 2^-24ths: 40 bits before the
+ * point and 24 after. It is what Real is when built with BIRDFLOCK_FIXED defined (qmake
+ * "DEFINES+=BIRDFLOCK_FIXED", see TwoVector.h), so every position, velocity and force of the Birds
+ * is worked out with integer arithmetic only.
+ *
+ * Floating point results can change with the compiler, its options (such as whether a*b + c may be
+ * done as one fused instruction) and the processor, so two builds of the same code can drift apart.
+ * Integer arithmetic can't: every operation here is defined to the last bit, so the fixed build
+ * gives the same flock on every machine and with every compiler, and the same with any number of
+ * threads, as the double build does.
+ *
+ * - + and - wrap around, as integers do.
+ * - * rounds down, and / rounds towards zero. Both saturate to the largest or smallest Fixed instead
+ *   of overflowing, and dividing by zero gives the largest or smallest Fixed (like an infinity).
+ * - sqrt rounds down. Its first guess comes from the processor's square root, but it is then fixed
+ *   up with integer arithmetic, so the result doesn't depend on it.
+ * - sin, cos and atan2 are short polynomials worked out in Fixed, accurate to about 1e-6.
+ *
+ * Any Fixed smaller than 2^29 in size converts to a double and back exactly, so checkpoints,
+ * trajectories and the Birds handed between processes keep every bit.
+ */
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cstdint>
+#include <cmath>
+
+class Fixed
+{
+public:
+
+    //number of bits after the point
+    static const int kFractionBits = 24;
+
+    //Constructors. Converting from a double rounds to the nearest 2^-24th.
+    Fixed(): fRaw(0){}
+    Fixed(int value): fRaw((int64_t)value*kOne){}
+    Fixed(double value): fRaw((int64_t)(value*kOne + (value < 0 ? -0.5 : 0.5))){}
+
+    //a Fixed with the given integer representation
+    static inline Fixed fromRaw(int64_t raw){Fixed f; f.fRaw = raw; return f;}
+
+    //largest and smallest Fixed
+    static inline Fixed max(){return fromRaw(INT64_MAX);}
+    static inline Fixed min(){return fromRaw(INT64_MIN);}
+
+    //conversions, which must be asked for so floating point can't creep back into the simulation
+    explicit inline operator double()const{return (double)fRaw/kOne;}
+    explicit inline operator float()const{return (float)((double)fRaw/kOne);}
+    explicit inline operator int()const{return (int)(fRaw >> kFractionBits);}
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline int64_t const raw()const{return fRaw;}
+
+    inline Fixed operator - ()const{return fromRaw((int64_t)(0 - (uint64_t)fRaw));}
+    inline Fixed& operator += (Fixed other){fRaw = (int64_t)((uint64_t)fRaw + (uint64_t)other.fRaw); return *this;}
+    inline Fixed& operator -= (Fixed other){fRaw = (int64_t)((uint64_t)fRaw - (uint64_t)other.fRaw); return *this;}
+    inline Fixed& operator *= (Fixed other);
+    inline Fixed& operator /= (Fixed other);
+
+private:
+
+    static const int64_t kOne = (int64_t)1 << kFractionBits;
+
+    int64_t fRaw;
+};
+
+/* the 128 bit product of two unsigned 64 bit integers, as its high and low halves. Done with the
+ * compiler's 128 bit integers where it has them, else from 32 bit halves. */
+inline void multiplyWide(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low){
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = (unsigned __int128)a*b;
+    *high = (uint64_t)(product >> 64);
+    *low = (uint64_t)product;
+#else
+    uint64_t aLow = a & 0xffffffff, aHigh = a >> 32;
+    uint64_t bLow = b & 0xffffffff, bHigh = b >> 32;
+    uint64_t lowLow = aLow*bLow;
+    uint64_t highLow = aHigh*bLow;
+    uint64_t lowHigh = aLow*bHigh;
+    uint64_t middle = (lowLow >> 32) + (highLow & 0xffffffff) + (lowHigh & 0xffffffff);
+    *low = (middle << 32) | (lowLow & 0xffffffff);
+    *high = aHigh*bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+}
+
+inline Fixed operator + (Fixed a, Fixed b){return a += b;}
+inline Fixed operator - (Fixed a, Fixed b){return a -= b;}
+
+/* product of two Fixed, rounded down. The signed 128 bit product is the unsigned one of the same
+ * bits, less each number times 2^64 if the other is negative. */
+inline Fixed operator * (Fixed a, Fixed b){
+    uint64_t high, low;
+    multiplyWide((uint64_t)a.raw(), (uint64_t)b.raw(), &high, &low);
+    if(a.raw() < 0) high -= (uint64_t)b.raw();
+    if(b.raw() < 0) high -= (uint64_t)a.raw();
+
+    //the result fits if the bits above it are all copies of its sign bit
+    int64_t top = (int64_t)high >> (Fixed::kFractionBits + 63 - 64);
+    if(top != 0 && top != -1) return top < 0 ? Fixed::min() : Fixed::max();
+    return Fixed::fromRaw((int64_t)((high << (64 - Fixed::kFractionBits)) | (low >> Fixed::kFractionBits)));
+}
+
+/* quotient of two Fixed, rounded towards zero. Done with the compiler's 128 bit integers where it
+ * has them, else by long division one bit at a time. */
+inline Fixed operator / (Fixed a, Fixed b){
+    if(b.raw() == 0) return a.raw() < 0 ? Fixed::min() : Fixed::max();
+    bool negative = (a.raw() < 0) != (b.raw() < 0);
+    uint64_t numerator = a.raw() < 0 ? 0 - (uint64_t)a.raw() : (uint64_t)a.raw();
+    uint64_t denominator = b.raw() < 0 ? 0 - (uint64_t)b.raw() : (uint64_t)b.raw();
+    uint64_t quotient;
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 wide = ((unsigned __int128)numerator << Fixed::kFractionBits)/denominator;
+    if(wide >> 63) return negative ? Fixed::min() : Fixed::max();
+    quotient = (uint64_t)wide;
+#else
+    quotient = numerator/denominator;
+    if(quotient >> (63 - Fixed::kFractionBits)) return negative ? Fixed::min() : Fixed::max();
+    uint64_t remainder = numerator%denominator;
+    for(int i=0; i<Fixed::kFractionBits; i++){
+        //remainder < denominator <= 2^63, so doubling it can't overflow
+        remainder <<= 1;
+        quotient <<= 1;
+        if(remainder >= denominator){
+            remainder -= denominator;
+            quotient |= 1;
+        }
+    }
+#endif
+    return Fixed::fromRaw(negative ? (int64_t)(0 - quotient) : (int64_t)quotient);
+}
+
+inline Fixed& Fixed::operator *= (Fixed other){return *this = *this*other;}
+inline Fixed& Fixed::operator /= (Fixed other){return *this = *this/other;}
+
+inline bool operator == (Fixed a, Fixed b){return a.raw() == b.raw();}
+inline bool operator != (Fixed a, Fixed b){return a.raw() != b.raw();}
+inline bool operator < (Fixed a, Fixed b){return a.raw() < b.raw();}
+inline bool operator <= (Fixed a, Fixed b){return a.raw() <= b.raw();}
+inline bool operator > (Fixed a, Fixed b){return a.raw() > b.raw();}
+inline bool operator >= (Fixed a, Fixed b){return a.raw() >= b.raw();}
+
+/* The maths functions of <cmath> the simulation uses, for Fixed. They are found by argument
+ * dependent lookup, so code that calls sqrt(x) unqualified, after using std::sqrt, works on Fixed
+ * as well as on float and double. */
+
+inline Fixed fabs(Fixed x){return x.raw() < 0 ? -x : x;}
+
+/* floor(sqrt(x)) to the nearest 2^-24th below, or 0 for x <= 0: the integer square root of
+ * x.raw()*2^24. The guess from the floating point square root is moved up or down until it is
+ * exactly right, so it is the same on every machine. */
+inline Fixed sqrt(Fixed x){
+    if(x.raw() <= 0) return Fixed();
+    uint64_t targetHigh = (uint64_t)x.raw() >> (64 - Fixed::kFractionBits);
+    uint64_t targetLow = (uint64_t)x.raw() << Fixed::kFractionBits;
+    uint64_t root = (uint64_t)std::sqrt((double)x.raw()*(double)((int64_t)1 << Fixed::kFractionBits));
+
+    //whether root*root is above the target
+    uint64_t high, low;
+    multiplyWide(root, root, &high, &low);
+    while(high > targetHigh || (high == targetHigh && low > targetLow)){
+        root--;
+        multiplyWide(root, root, &high, &low);
+    }
+    while(true){
+        multiplyWide(root + 1, root + 1, &high, &low);
+        if(high > targetHigh || (high == targetHigh && low > targetLow)) break;
+        root++;
+    }
+    return Fixed::fromRaw((int64_t)root);
+}
+
+/* Sine and cosine of an angle in radians, together. As fastSinCos in FastMath.h: the angle is moved
+ * to within pi/4 of 0 by taking off whole quarter turns, where short Taylor series are accurate. */
+inline void sinCos(Fixed angle, Fixed* sine, Fixed* cosine){
+    const Fixed kHalfPi = 1.5707963267948966;
+    const Fixed kTwoOverPi = 0.6366197723675814;
+    Fixed scaled = angle*kTwoOverPi + Fixed(0.5);
+    int64_t turns = scaled.raw() >> Fixed::kFractionBits;//rounded down
+    Fixed r = angle - Fixed::fromRaw(turns*kHalfPi.raw());
+    Fixed r2 = r*r;
+    Fixed s = r*(Fixed(1) + r2*(Fixed(-1/6.) + r2*(Fixed(1/120.) + r2*Fixed(-1/5040.))));
+    Fixed c = Fixed(1) + r2*(Fixed(-0.5) + r2*(Fixed(1/24.) + r2*(Fixed(-1/720.) + r2*Fixed(1/40320.))));
+    switch(turns & 3){
+    case 0: *sine = s; *cosine = c; break;
+    case 1: *sine = c; *cosine = -s; break;
+    case 2: *sine = -s; *cosine = -c; break;
+    default: *sine = -c; *cosine = s; break;
+    }
+}
+inline Fixed sin(Fixed angle){Fixed s, c; sinCos(angle, &s, &c); return s;}
+inline Fixed cos(Fixed angle){Fixed s, c; sinCos(angle, &s, &c); return c;}
+
+/* Angle of the vector (x, y) from the x axis, in radians between -pi and pi, and 0 for the zero
+ * vector. The same polynomial as fastAtan2 in FastMath.h. */
+inline Fixed atan2(Fixed y, Fixed x){
+    Fixed ax = fabs(x), ay = fabs(y);
+    Fixed largest = ax > ay ? ax : ay;
+    if(largest == 0) return Fixed();
+    Fixed a = (ax > ay ? ay : ax)/largest;
+    Fixed s = a*a;
+    Fixed angle = a*(Fixed(0.99997726) + s*(Fixed(-0.33262347) + s*(Fixed(0.19354346) + s*(Fixed(-0.11643287) +
+                  s*(Fixed(0.05265332) + s*Fixed(-0.01172120))))));
+    if(ay > ax) angle = Fixed(1.5707963267948966) - angle;
+    if(x < 0) angle = Fixed(3.141592653589793) - angle;
+    return y < 0 ? -angle : angle;
+}
+
+#endif // FIXED_H
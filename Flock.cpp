@@ -1,231 +1,1335 @@
-/* Flock.cpp
- * Author: Max Elliott
- * Created On: 2017-12-12
- *
- * .cpp file for Flock. Used to store all FlockObjects currently in the simulation.
- * It has runs the simulation by calling the update method and move method of all the Birds. It also
- * removes any dead Birds. It has methods to add and remove each type of FlockObject, and to alter
- * the data members of them.
- *
- */
-#include "Flock.h"
-#include <iostream>
-#include <vector>
-#include <string>
-#include <cmath>
-#include "Bird.h"
-#include "Predator.h"
-#include "Obstacle.h"
-#include <TwoVector.h>
-
-//Constructor: When a Flock is created, it creates a new vector on the heap to store the Birds and Obstacles.
-Flock::Flock()
-{
-    fBirds = new std::vector<Bird*>;
-    fObstacles = new std::vector<Obstacle*>;
-
-}
-
-//Deconstructor
-Flock::~Flock(){}
-
-/*simulateFlock
- *
- * The method that updates the entire simulation for each frame. It cycles through all Birds (including
- * Predators) and calls their update method. It also checks whether the Bird is dead, and removes it if
- * so. It then cycles through all Obstacles to check whether they're dead, and rmeoves them if so. Once
- * everything is updated, the move method for each Bird is called to update their positions.
- *
- * inputs:
- * - xdim: current x dimension of display window
- * - ydim: current y dimension of display window
- */
-void Flock::simulateFlock(int xdim, int ydim){
-
-    //cycle through all birds
-    for(int i=0; i < fBirds->size(); i++){
-
-        //if bird is dead, remove it, else call its update method
-        Bird* b = fBirds->at(i);
-        if(b->getIsDead()){
-            removeBird(b->getColour(), i);//remove using custom method, passes index of dead bird
-            i--;//so all birds are still checked
-        }
-        else{
-            //update bird, passing fBirds and fFlock pointers to improve runtime performance
-            fBirds->at(i)->update(fBirds,fObstacles, xdim, ydim);
-        }
-    }
-
-    //cycle through all obstacles to remove them if they are dead.
-    for(int i=0; i<fObstacles->size(); i++){
-        Obstacle* o = fObstacles->at(i);
-        if(o->getIsDead()){
-            fObstacles->erase(fObstacles->begin()+i);
-        }
-    }
-
-    //cycle through all birds and move them
-    for(int i=0; i<fBirds->size(); i++){
-        fBirds->at(i)->move();
-    }
-}
-
-/* addBird
- *
- * adds a new bird to the flock, if and only if its position is not inside an obstacle.
- *
- * inputs:
- * - b: Bird object to be added
- *
- * return: true if Bird added, false if not
- */
-bool Flock::addBird(Bird* b){
-
-    bool checkPos = checkPositionFree(b->getPosition()); //check if position is clear
-
-    //if position is clear, add the bird to the flock, increment appropiate birdCount
-    if(checkPos){
-        fBirds->push_back(b);
-
-        if(b->getColour().compare("blue")==0){fBlueCount++;}
-        else if(b->getColour().compare("green")==0){fGreenCount++;}
-        else if(b->getColour().compare("red")==0){fPredCount++;}
-    }
-    return checkPos;//returns whether Bird was successfully added or not
-
-
-}
-
-/* Helper method for addBird. Checks whether Bird position is inside an obstacle
- *
- * inputs:
- * - position: position to be checks
- *
- * return: true if position is not in an obstacles
- */
-bool Flock::checkPositionFree(TwoVector position){
-
-    for(int i=0; i<getObstacles()->size(); i++){
-
-        Obstacle* o = getObstacles()->at(i);
-
-        //finds distance between position and centre of obstacle (i.e. it's position)
-        double distance = (o->getPosition()-  position).mag();
-
-        //if distance is smaller than the obstacle radius, then the position is inside the obstacle
-        if(distance <= o->getRadius()){
-            return false;
-        }
-    }
-    return true;
-}
-
-/* removeBird
- * Method used to remove any bird that has fIsDead = true.
- *
- * input:
- * - colour: colour of bird to be removed
- * - index: position in the vector fBirds of the Bird to be removed
- */
-void Flock::removeBird(std::string colour, int index){
-    fBirds->erase(fBirds->begin() + index);//delete Bird
-
-    //decrement appropriate birdCount
-    if(colour.compare("blue")==0){fBlueCount--;}
-    else if(colour.compare("green")==0){fGreenCount--;}
-    else if(colour.compare("red")==0){fPredCount--;}
-}
-
-//adds obstacles to fObstacle
-void Flock::addObstacle(Obstacle* o){
-    fObstacles->push_back(o);
-}
-
-//changes radius of all obstacles
-void Flock::changeObstacleRadius(int newRadius){
-    for(int i=0; i<fObstacles->size(); i++){
-        fObstacles->at(i)->setRadius(newRadius);
-    }
-}
-
-//changes maxSpeed of a specific colour of Bird (blue, green or red)
-void Flock::changeMaxSpeed(std::string colour, int newSpeed){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setMaxSpeed(newSpeed);
-        }
-    }
-}
-
-//changes separation distance of a specific colour of Bird (blue, green or red)
-void Flock::changeSepDistance(std::string colour, int newSep){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setSeparationDistance(newSep);
-        }
-    }
-}
-
-//changes detection distance of a specific colour of Bird (blue, green or red)
-void Flock::changeDetDistance(std::string colour, int newDet){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setDetectionDistance(newDet);
-        }
-    }
-}
-
-//changes hunger of Predators
-void Flock::changeHunger(int newHunger){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare("red")==0){
-            Predator* p = dynamic_cast<Predator*>(fBirds->at(i));//need to specifically cast to Predator to call Predator-specific method.
-            p->setHunger(newHunger);
-        }
-    }
-}
-
-//changes separation force weighting of a specific colour of Bird (blue, green or red)
-void Flock::changeSeparationStrength(std::string colour, double newStrength){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setSeperationStrength(newStrength);
-        }
-    }
-}
-
-//changes cohesion force weighting of a specific colour of Bird (blue or green)
-void Flock::changeCohesionStrength(std::string colour, double newStrength){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setCohesionstrength(newStrength);
-        }
-    }
-}
-
-//changes alignment force weighting of a specific colour of Bird (blue or green)
-void Flock::changeAlignmentStrength(std::string colour, double newStrength){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setAlignmentStrength(newStrength);
-        }
-    }
-}
-
-//changes avoidPredator force weighting of a specific colour of Bird (blue, green or red)
-void Flock::changeAvoidPredatorStrength(std::string colour, double newStrength){
-    for(int i=0; i<fBirds->size(); i++){
-        if(fBirds->at(i)->getColour().compare(colour) == 0){
-            fBirds->at(i)->setAvoidPredatorStrength(newStrength);
-        }
-    }
-}
-
-//removes all FlockObjects from the vectors
-void Flock::clearFlock(){
-    fBirds->clear();
-    fObstacles->clear();
-}
-
-
+/* Flock.cpp
+ * Author: Max Elliott
+ * Created On: 2017-12-12
+ *
+ * .cpp file for Flock. Used to store all FlockObjects currently in the simulation.
+ * It has runs the simulation by calling the update method and move method of all the Birds. It also
+ * removes any dead Birds. It has methods to add and remove each type of FlockObject, and to alter
+ * the data members of them.
+ *
+ */
+#include "Flock.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "Bird.h"
+#include "Predator.h"
+#include "Obstacle.h"
+#include <TwoVector.h>
+#include "TrajectoryRecorder.h"
+#include "FlockAnalytics.h"
+#include "SharedFlockWriter.h"
+#include "StreamServer.h"
+#include "Checkpoint.h"
+#include "ThreadPool.h"
+#include "RadixSort.h"
+#include "Numa.h"
+
+//Constructor: When a Flock is created, it creates a new vector on the heap to store the Birds and Obstacles.
+Flock::Flock() :
+    fBirdGrid(kGridCellSize), fObstacleGrid(kGridCellSize)
+{
+    fBirds = new std::vector<Bird*>;
+    fObstacles = new std::vector<Obstacle*>;
+
+    resetCounters();
+    fObstacleCount = 0;
+    fWorldWidth = 1200;
+    fWorldHeight = 800;
+    fMaxObstacleRadius = 0;
+    fTick = 0;
+    fNextId = 0;
+    fRecorder = 0;
+    fAnalytics = 0;
+    fAnalysing = false;
+    fExporter = 0;
+    fStreamServer = 0;
+    fGhosts = 0;
+    fThreadPool = 0;
+    fThreadCount = 0;
+    fReorderInterval = kDefaultReorderInterval;
+    fLastReorderCheck = 0;
+    fReorderCount = 0;
+    fScatter = 0;
+    fReorderDue = false;
+    fFarField = false;
+    fSkipIsolated = true;
+    fPinThreads = false;
+    fMeasurePlacement = false;
+    fMortonColumns = 0;
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        fBehaviourIntervals[behaviour] = 1;
+    }
+    fIsolatedCount = 0;
+    fCoastingCount = 0;
+    fObstaclesVersion = 0;
+    fClaims = 0;
+    fClaimCapacity = 0;
+    setSeed(0);
+}
+
+//Deconstructor
+Flock::~Flock(){
+    clearFlock();
+    delete fBirds;
+    delete fObstacles;
+    delete fThreadPool;
+    delete[] fClaims;
+}
+
+//sets the size of the world. The grids are rebuilt so they cover the new size straight away.
+void Flock::setWorldSize(int width, int height){
+    fWorldWidth = width;
+    fWorldHeight = height;
+    rebuildGrids();
+}
+
+/*simulateFlock
+ *
+ * The method that updates the entire simulation for each frame. It first removes any dead Birds and
+ * Obstacles, puts the Birds in Morton order in memory if the last check found them scattered (see
+ * reorderBirds), rebuilds the spatial grids, and checks how scattered the Birds are if it is time
+ * to. It then works out the new velocity of every Bird, passing each one only the Birds close
+ * enough to matter. The Birds are split between the threads of fThreadPool, in the order of the
+ * grid, so Birds updated one after another have mostly the same neighbours. Predators are updated
+ * along with the rest: each one only claims the Bird it catches, and once every Bird is updated the
+ * claims that won are eaten (see eatCatches). Every Bird reads the others' positions and velocities
+ * from the start of the tick and only writes to itself, and its neighbours are always found in the
+ * same order, so the result is exactly the same whatever the number of threads, and whatever order
+ * they are updated in. If the threads are pinned, the Birds are taken cell by cell in Morton order
+ * instead (see setPinThreads). If fAnalytics is measuring this tick, it is shown the neighbours as
+ * they are found, and then works out its stats. Once everything is updated, the new velocities are
+ * applied and each Bird is moved. Finally the tick is handed to fRecorder, fExporter and
+ * fStreamServer, if there are any, and the counters are published.
+ *
+ * If there are ghosts, they are in fBirds while the Birds are updated, so they are found as
+ * neighbours, but are not updated themselves. Analytics are skipped, as they would only measure
+ * part of the flock. Predators of other Flocks may catch the same Birds, so before the claims are
+ * eaten fClaimSettler, if there is one, settles them with those Flocks.
+ */
+void Flock::simulateFlock(){
+
+    removeDeadObjects();
+    if(fReorderDue) reorderBirds();
+    mergeGhosts();
+    rebuildGrids();
+
+    //scatter only changes slowly, so it is only measured every fReorderInterval ticks
+    if(fReorderInterval > 0 && fTick - fLastReorderCheck >= fReorderInterval){
+        measureScatter();
+        fLastReorderCheck = fTick;
+        fReorderDue = fScatter*100 > kReorderScatterPercent;
+    }
+    if(fFarField) sumCells();
+
+    fAnalysing = fAnalytics && !fGhosts && fAnalytics->isDue(fTick);
+    if(fAnalysing) fAnalytics->beginTick(fBirds->size());
+
+    //every Bird is alive at this point, as the dead ones were just removed
+    prepareClaims();
+    const int* order = fBirdGrid.cellBegin(0);
+    if(fPinThreads){
+        orderByMorton();
+        order = fUpdateOrder.data();
+    }
+    parallelFor(fBirds->size(), [this, order](int begin, int end, int thread){
+        if(fMeasurePlacement) measurePlacement(order + begin, end - begin, thread);
+        for(int k=begin; k<end; k++){
+            int i = order[k];
+            if(!fIsGhost.empty() && fIsGhost[i]) continue;
+            updateBird(i, thread);
+        }
+    });
+    if(fClaimSettler) fClaimSettler();
+    eatCatches();
+    fIsolatedCount = 0;
+    fCoastingCount = 0;
+    fCounters.placed = 0;
+    fCounters.remote = 0;
+    for(int t=0; t<fIsolated.size(); t++){
+        fIsolatedCount += fIsolated[t];
+        fCoastingCount += fCoasting[t];
+        fCounters.placed += fPlaced[t];
+        fCounters.remote += fRemote[t];
+        fIsolated[t] = 0;
+        fCoasting[t] = 0;
+        fPlaced[t] = 0;
+        fRemote[t] = 0;
+    }
+
+    //measured before anything moves, while the positions still match the neighbours found
+    if(fAnalysing) fAnalytics->finishTick(this);
+    unmergeGhosts();
+
+    //apply the new velocities and move all birds
+    parallelFor(fBirds->size(), [this](int begin, int end, int){
+        for(int i=begin; i<end; i++){
+            Bird* b = fBirds->at(i);
+            b->finishUpdate();
+            b->move();
+        }
+    });
+
+    fTick++;
+    if(fRecorder) fRecorder->record(this);
+    if(fExporter) fExporter->publish(this);
+    if(fStreamServer) fStreamServer->publish(this);
+    fDeaths.clear();
+
+    fCounters.tick = fTick;
+    fCounterChannel.publish(fCounters);
+}
+
+/* updateBird
+ *
+ * Finds the neighbours of a Bird and calls its update method. The neighbours are also shown to
+ * fAnalytics when it is measuring this tick, so it doesn't have to find them again. If far away
+ * neighbours are being summed up, and fAnalytics isn't measuring, they are handed over that way.
+ * A Bird with no other Bird near it (see setSkipIsolated) skips the neighbour search. A
+ * Bird with no slow behaviour due (see setBehaviourInterval) only needs the Birds it might separate
+ * from, so it only looks as far as its separation distance.
+ *
+ * inputs:
+ * - index: index in fBirds of the Bird to update
+ * - thread: index of the thread doing the update, which chooses the neighbour buffers to use
+ */
+void Flock::updateBird(int index, int thread){
+    Bird* b = fBirds->at(index);
+    std::vector<Bird*>* neighbours = &fNeighbours[thread];
+
+    //every behaviour ignores birds further away than the detection or separation distance
+    int due = dueBehaviours(b);
+    double range = std::max(b->getDetectionDistance(), b->getSeparationDistance());
+    if(due == 0 && !fAnalysing && b->getSpecies() != kRed) range = b->getSeparationDistance();
+
+    /* an isolated Bird would only find itself, which every behaviour skips, so it is given no
+     * neighbours. Its own cell is always searched, so it is isolated if it is the only Bird counted.
+     * Unless it is a Predator, it coasts if it can tell no other force acts on it either, until the
+     * grid puts another Bird near it. */
+    double x = (double)b->getXPos(), y = (double)b->getYPos();
+    if(fSkipIsolated && !fAnalysing && fBirdGrid.count(x-range, y-range, x+range, y+range) <= 1){
+        fIsolated[thread]++;
+        if(b->getSpecies() != kRed && b->coast(fObstacles, fWorldWidth, fWorldHeight, due, fObstaclesVersion)){
+            fCoasting[thread]++;
+            return;
+        }
+        neighbours->clear();
+        b->update(neighbours, fObstacles, fWorldWidth, fWorldHeight, 0, due);
+        return;
+    }
+
+    /* analytics need every neighbour, and Predators don't flock, so only other Birds have theirs summed
+     * up, and only when they are working out cohesion */
+    if(fFarField && !fAnalysing && b->getSpecies() != kRed && (due & (1 << kCohesion))){
+        NeighbourSums far;
+        findFarNeighbours(b, neighbours, &fNeighbourIndices[thread], &far);
+        b->update(neighbours, fObstacles, fWorldWidth, fWorldHeight, &far, due);
+        return;
+    }
+
+    findNeighbours(b->getPosition(), range, neighbours, &fNeighbourIndices[thread]);
+    if(fAnalysing) fAnalytics->observe(index, b, range, neighbours, &fNeighbourIndices[thread]);
+
+    //update bird, passing its neighbours and fObstacles pointers to improve runtime performance
+    b->update(neighbours, fObstacles, fWorldWidth, fWorldHeight, 0, due);
+    if(b->getSpecies() == kRed) claimCatch(index, thread);
+}
+
+/* dueBehaviours
+ *
+ * Works out which slow behaviours a Bird works out this tick. A behaviour with an interval of n is
+ * due every n ticks, on the ticks where the tick plus the Bird's id is a multiple of n, so each
+ * tick about one Bird in n works it out, rather than all of them on the same tick. A behaviour the
+ * Bird has never worked out, as it was only just added, is always due, so the Bird is given every
+ * neighbour it needs for it.
+ *
+ * inputs:
+ * - b: the Bird
+ *
+ * return: mask of the SlowBehaviours that are due
+ */
+int Flock::dueBehaviours(const Bird* b)const{
+    int due = 0;
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        int interval = fBehaviourIntervals[behaviour];
+        if(interval <= 1 || (fTick + b->getId()) % interval == 0) due |= 1 << behaviour;
+    }
+    return due | (kEverySlowBehaviour & ~b->getKnownForces());
+}
+
+//makes fClaims big enough for every Bird. Claims are cleared by eatCatches, so only new ones need setting.
+void Flock::prepareClaims(){
+    if(fBirds->size() <= fClaimCapacity) return;
+
+    //atomics can't be moved, so the array is only made again when it needs to grow
+    delete[] fClaims;
+    fClaimCapacity = std::max((int)fBirds->size(), 2*fClaimCapacity);
+    fClaims = new std::atomic<uint64_t>[fClaimCapacity];
+    for(int i=0; i<fClaimCapacity; i++){
+        fClaims[i].store(kUnclaimed, std::memory_order_relaxed);
+    }
+}
+
+/* claimCatch
+ *
+ * Claims the Bird a Predator caught in its last update, if it caught one. A claim is the distance
+ * to the Bird as a float in the top 32 bits and the Predator's id in the bottom 32: distances are
+ * never negative, so their bits sort in the same order as the distances, and the smallest claim
+ * is the nearest Predator, or the one with the lowest id if two are as near. Each claim is only
+ * written if it is smaller than the one already there, with a compare and swap, so whichever
+ * order the Predators claim in, on whichever threads, the nearest Predator ends up with the claim.
+ *
+ * inputs:
+ * - index: index in fBirds of the Predator, just updated
+ * - thread: thread that updated it, whose neighbour buffers still hold what the Predator saw
+ */
+void Flock::claimCatch(int index, int thread){
+    Predator* p = dynamic_cast<Predator*>(fBirds->at(index));
+    if(!p || !p->getCatch()) return;
+
+    //the caught Bird is one of the neighbours, which gives its index
+    const std::vector<Bird*>& neighbours = fNeighbours[thread];
+    int prey = -1;
+    for(int j=0; j<neighbours.size() && prey < 0; j++){
+        if(neighbours[j] == p->getCatch()) prey = fNeighbourIndices[thread][j];
+    }
+    if(prey < 0) return;
+
+    float distance = (float)p->getCatchDistance();
+    uint32_t distanceBits;
+    memcpy(&distanceBits, &distance, sizeof(distanceBits));
+    uint64_t claim = ((uint64_t)distanceBits << 32) | (uint32_t)p->getId();
+
+    uint64_t current = fClaims[prey].load(std::memory_order_relaxed);
+    while(claim < current && !fClaims[prey].compare_exchange_weak(current, claim, std::memory_order_relaxed)){}
+    fHunters[thread].push_back(std::make_pair(index, prey));
+}
+
+/* eatCatches
+ *
+ * Runs once every Bird is updated. Each Predator that caught a Bird eats it if its claim is the one
+ * left, and then every claim made is cleared for the next tick. Only the Predators that caught
+ * something are looked at, so this takes time in proportion to them rather than to the flock.
+ * Whether a Predator eats only depends on the claims, so the order they are looked at in doesn't
+ * matter. A Bird won by a Predator of another Flock (see claimBird) is killed here as eaten, as
+ * that Predator eats it in its own Flock.
+ */
+void Flock::eatCatches(){
+    for(int t=0; t<fHunters.size(); t++){
+        for(int h=0; h<fHunters[t].size(); h++){
+            Predator* p = static_cast<Predator*>(fBirds->at(fHunters[t][h].first));
+            int prey = fHunters[t][h].second;
+            if((uint32_t)fClaims[prey].load(std::memory_order_relaxed) == (uint32_t)p->getId()){
+                p->eat(fBirds->at(prey));
+            }
+        }
+    }
+    for(int i=0; i<fRemoteClaims.size(); i++){
+        int prey = fRemoteClaims[i].first;
+        if(fClaims[prey].load(std::memory_order_relaxed) == fRemoteClaims[i].second){
+            fBirds->at(prey)->setIsDead(true);
+            fBirds->at(prey)->setWasEaten(true);
+        }
+    }
+    for(int t=0; t<fHunters.size(); t++){
+        for(int h=0; h<fHunters[t].size(); h++){
+            fClaims[fHunters[t][h].second].store(kUnclaimed, std::memory_order_relaxed);
+        }
+        fHunters[t].clear();
+    }
+    for(int i=0; i<fRemoteClaims.size(); i++){
+        fClaims[fRemoteClaims[i].first].store(kUnclaimed, std::memory_order_relaxed);
+    }
+    fRemoteClaims.clear();
+}
+
+/* getGhostClaims
+ *
+ * inputs:
+ * - claims: emptied, then filled with each ghost a Predator of this Flock caught and the smallest
+ *   claim on it, in id order
+ */
+void Flock::getGhostClaims(std::vector<std::pair<Bird*, uint64_t> >* claims){
+    claims->clear();
+    if(fIsGhost.empty()) return;
+    for(int t=0; t<fHunters.size(); t++){
+        for(int h=0; h<fHunters[t].size(); h++){
+            int prey = fHunters[t][h].second;
+            if(fIsGhost[prey]) claims->push_back(std::make_pair(fBirds->at(prey), fClaims[prey].load(std::memory_order_relaxed)));
+        }
+    }
+
+    //two Predators may have caught the same ghost, and both have the smallest claim by now
+    std::sort(claims->begin(), claims->end(), [](const std::pair<Bird*, uint64_t>& a, const std::pair<Bird*, uint64_t>& b){
+        return a.first->getId() < b.first->getId();
+    });
+    claims->erase(std::unique(claims->begin(), claims->end()), claims->end());
+}
+
+/* claimBird
+ *
+ * Claims a Bird for a Predator of another Flock that caught it as a ghost, with the same rule as
+ * claimCatch, so the nearest Predator wins whichever Flock it is in.
+ *
+ * inputs:
+ * - id: id of the Bird
+ * - claim: the other Flock's claim, made as claimCatch makes them
+ *
+ * return: true if this Flock owns the Bird
+ */
+bool Flock::claimBird(int id, uint64_t claim){
+    int index = findIndex(id);
+    if(index < 0 || (!fIsGhost.empty() && fIsGhost[index])) return false;
+    if(claim < fClaims[index].load(std::memory_order_relaxed)) fClaims[index].store(claim, std::memory_order_relaxed);
+    fRemoteClaims.push_back(std::make_pair(index, claim));
+    return true;
+}
+
+//the smallest claim on the Bird or ghost with an id, or kUnclaimed if there is none
+uint64_t Flock::getClaim(int id){
+    int index = findIndex(id);
+    return index < 0 ? kUnclaimed : fClaims[index].load(std::memory_order_relaxed);
+}
+
+//drops the claims on a ghost, so none of this Flock's Predators eat it
+void Flock::loseClaim(int id){
+    int index = findIndex(id);
+    if(index >= 0 && !fIsGhost.empty() && fIsGhost[index]) fClaims[index].store(kUnclaimed, std::memory_order_relaxed);
+}
+
+//runs function(begin, end, thread) over [0, count) on fThreadPool, making the pool if needed
+void Flock::parallelFor(int count, std::function<void(int, int, int)> function){
+    if(!fThreadPool){
+        fThreadPool = new ThreadPool(fThreadCount, fPinThreads);
+        fNeighbours.resize(fThreadPool->getThreadCount());
+        fNeighbourIndices.resize(fThreadPool->getThreadCount());
+        fHunters.resize(fThreadPool->getThreadCount());
+        fIsolated.resize(fThreadPool->getThreadCount());
+        fCoasting.resize(fThreadPool->getThreadCount());
+        fPlaced.resize(fThreadPool->getThreadCount());
+        fRemote.resize(fThreadPool->getThreadCount());
+    }
+    fThreadPool->parallelFor(count, kBirdsPerChunk, function);
+}
+
+/* setThreadCount
+ *
+ * Sets the number of threads used to simulate the flock. The result of the simulation is
+ * the same for any number of threads.
+ *
+ * inputs:
+ * - threadCount: number of threads, or 0 for one per core
+ */
+void Flock::setThreadCount(int threadCount){
+    if(threadCount == fThreadCount) return;
+    fThreadCount = threadCount;
+    delete fThreadPool;
+    fThreadPool = 0;
+}
+
+//sets whether the threads are pinned, making the thread pool again if it changes
+void Flock::setPinThreads(bool pinThreads){
+    if(pinThreads == fPinThreads) return;
+    fPinThreads = pinThreads;
+    delete fThreadPool;
+    fThreadPool = 0;
+}
+
+/* setSeed
+ *
+ * Sets the seed all random numbers of the Flock are made from, and restarts the spawning
+ * stream. Two Flocks with the same seed and the same settings always run the same way.
+ *
+ * inputs:
+ * - seed: the new seed
+ */
+void Flock::setSeed(uint64_t seed){
+    fSeed = seed;
+    fRandom = Random(fSeed, kSpawnStream);
+}
+
+/* birdRandom
+ *
+ * Random numbers for a single Bird. Every Bird has its own stream, and every tick starts at a new
+ * place in it, so the numbers a Bird gets only depend on the seed, its id and the tick, and not on
+ * which thread updates it or what other Birds have used.
+ *
+ * inputs:
+ * - id: id of the Bird
+ *
+ * return: the random stream for the Bird for the current tick
+ */
+Random Flock::birdRandom(int id)const{
+    return Random(fSeed, kBirdStreams + (uint64_t)id, (uint64_t)fTick << 32);
+}
+
+/* removeDeadObjects
+ *
+ * Removes and deletes every Bird and Obstacle whose fIsDead is true, and counts the deaths.
+ * The ids of the removed Birds are kept in fDeaths until the end of the next tick is recorded.
+ * The living objects keep their order.
+ */
+void Flock::removeDeadObjects(){
+    int alive = 0;
+    for(int i=0; i<fBirds->size(); i++){
+        Bird* b = fBirds->at(i);
+        if(b->getIsDead()){
+            countDeath(b);
+            fDeaths.push_back(b->getId());
+            delete b;
+        }
+        else{
+            fBirds->at(alive++) = b;
+        }
+    }
+    fBirds->resize(alive);
+
+    alive = 0;
+    for(int i=0; i<fObstacles->size(); i++){
+        Obstacle* o = fObstacles->at(i);
+        if(o->getIsDead()){
+            delete o;
+        }
+        else{
+            fObstacles->at(alive++) = o;
+        }
+    }
+    fObstacles->resize(alive);
+}
+
+/* mergeGhosts
+ *
+ * Puts the ghosts into fBirds, keeping it in id order, so every Bird finds its neighbours in the
+ * same order as it would if the whole flock were in one Flock. Does nothing if there are none.
+ */
+void Flock::mergeGhosts(){
+    fIsGhost.clear();
+    if(!fGhosts || fGhosts->empty()) return;
+
+    fOwnBirds.swap(*fBirds);
+    fBirds->clear();
+    fBirds->reserve(fOwnBirds.size() + fGhosts->size());
+    fIsGhost.reserve(fOwnBirds.size() + fGhosts->size());
+    int own = 0, ghost = 0;
+    while(own < fOwnBirds.size() || ghost < fGhosts->size()){
+        bool takeGhost = own == fOwnBirds.size() ||
+                         (ghost < fGhosts->size() && fGhosts->at(ghost)->getId() < fOwnBirds[own]->getId());
+        fBirds->push_back(takeGhost ? fGhosts->at(ghost++) : fOwnBirds[own++]);
+        fIsGhost.push_back(takeGhost);
+    }
+}
+
+//takes the ghosts back out of fBirds, leaving the Flock's own Birds in their order
+void Flock::unmergeGhosts(){
+    if(fIsGhost.empty()) return;
+    fBirds->swap(fOwnBirds);
+    fOwnBirds.clear();
+    fIsGhost.clear();
+}
+
+//rebuilds both spatial grids, and finds the largest obstacle radius
+void Flock::rebuildGrids(){
+    fBirdGrid.build(fBirds, fWorldWidth, fWorldHeight);
+    rebuildObstacleGrid();
+}
+
+//rebuilds fObstacleGrid on its own, and finds the largest obstacle radius
+void Flock::rebuildObstacleGrid(){
+    fObstacleGrid.build(fObstacles, fWorldWidth, fWorldHeight);
+
+    fMaxObstacleRadius = 0;
+    for(int i=0; i<fObstacles->size(); i++){
+        fMaxObstacleRadius = std::max(fMaxObstacleRadius, fObstacles->at(i)->getRadius());
+    }
+}
+
+/* reorderBirds
+ *
+ * Birds are made one at a time as they are added, so Birds that are near each other in the world
+ * are usually far apart in memory, and finding and reading the neighbours of each Bird misses the
+ * cache all the time. This sorts the Birds by the Morton code of the grid cell they are in, and then
+ * moves them between the Bird objects the Flock already has, so that the objects in order of
+ * address hold the Birds in Morton order, and the Birds in and around each cell are close together
+ * in memory. No Bird is made or deleted.
+ *
+ * Every Bird keeps its id and its place in fBirds, so nothing about the simulation changes. A
+ * pointer to a Bird kept from before the call still points to one of the Flock's Birds, but usually
+ * another one, so Birds should be followed by id (see findBird). Predators are few, and of another
+ * class, so they aren't moved. Only the Flock's own Birds are moved, never ghosts.
+ */
+void Flock::reorderBirds(){
+    fReorderDue = false;
+    fScatter = 0;
+    fSlots.clear();
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getSpecies() != kRed) fSlots.push_back(fBirds->at(i));
+    }
+    int count = fSlots.size();
+    if(count == 0) return;
+
+    //the Morton code in the top half of each value, and the index in fBirds in the bottom half
+    fSortValues.resize(count);
+    parallelFor(count, [this](int begin, int end, int){
+        for(int k=begin; k<end; k++){
+            const Bird* b = fSlots[k];
+            uint32_t code = SpatialGrid::mortonCode(fBirdGrid.column((double)b->getXPos()), fBirdGrid.row((double)b->getYPos()));
+            fSortValues[k] = (uint64_t)code << 32;
+        }
+    });
+    for(int i=0, k=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getSpecies() != kRed) fSortValues[k++] |= (uint32_t)i;
+    }
+    radixSortByKey(&fSortValues, &fSortBuffer, fThreadPool);
+
+    //the Birds are copied out in Morton order, then back into the objects in order of address
+    std::sort(fSlots.begin(), fSlots.end());
+    fMoved.clear();
+    fMoved.reserve(count);
+    for(int k=0; k<count; k++){
+        fMoved.push_back(*fBirds->at((uint32_t)fSortValues[k]));
+    }
+    parallelFor(count, [this](int begin, int end, int){
+        for(int k=begin; k<end; k++){
+            *fSlots[k] = fMoved[k];
+            fBirds->at((uint32_t)fSortValues[k]) = fSlots[k];
+        }
+
+        /* pinned threads update the Birds in about this same order, with the same share each, so
+         * the pages of each share are moved to the node of the thread that will update it */
+        if(fPinThreads) moveToNode(reinterpret_cast<void* const*>(&fSlots[begin]), end - begin, currentNode());
+    });
+    fMoved.clear();
+    fReorderCount++;
+}
+
+/* orderByMorton
+ *
+ * Lists the Birds in fBirdGrid cell by cell, with the cells in Morton order, the same order
+ * reorderBirds puts them in. The cells are only sorted again when the grid changes shape.
+ */
+void Flock::orderByMorton(){
+    int columns = fBirdGrid.getColumns(), cellCount = fBirdGrid.getCellCount();
+    if(fMortonCells.size() != cellCount || fMortonColumns != columns){
+        fMortonColumns = columns;
+        fMortonCells.resize(cellCount);
+        std::vector<uint64_t> keys(cellCount);
+        for(int cell=0; cell<cellCount; cell++){
+            keys[cell] = ((uint64_t)SpatialGrid::mortonCode(cell % columns, cell / columns) << 32) | (uint32_t)cell;
+        }
+        std::sort(keys.begin(), keys.end());
+        for(int k=0; k<cellCount; k++) fMortonCells[k] = (uint32_t)keys[k];
+    }
+
+    fUpdateOrder.resize(fBirds->size());
+    int* out = fUpdateOrder.data();
+    for(int k=0; k<cellCount; k++){
+        int cell = fMortonCells[k];
+        out = std::copy(fBirdGrid.cellBegin(cell), fBirdGrid.cellEnd(cell), out);
+    }
+}
+
+/* measurePlacement
+ *
+ * Asks the kernel which node the memory of each of some Birds is on, and counts those on another
+ * node than the one the calling thread is running on. Ghosts are left out, as they aren't updated.
+ *
+ * inputs:
+ * - indices: indices in fBirds of the Birds
+ * - count: number of indices
+ * - thread: the calling thread, whose counts in fPlaced and fRemote are added to
+ */
+void Flock::measurePlacement(const int* indices, int count, int thread){
+    std::vector<const void*> addresses;
+    addresses.reserve(count);
+    for(int k=0; k<count; k++){
+        if(!fIsGhost.empty() && fIsGhost[indices[k]]) continue;
+        addresses.push_back(fBirds->at(indices[k]));
+    }
+    std::vector<int> nodes(addresses.size());
+    nodesOfAddresses(addresses.data(), addresses.size(), nodes.data());
+
+    int node = currentNode();
+    for(int k=0; k<nodes.size(); k++){
+        if(nodes[k] < 0) continue;
+        fPlaced[thread]++;
+        if(nodes[k] != node) fRemote[thread]++;
+    }
+}
+
+/* measureScatter
+ *
+ * Works out how scattered the Birds are in memory, from fBirdGrid: the fraction of the Birds in
+ * each cell, other than the first, that are more than kNearbyBytes away in memory from the one
+ * before them. Just after reorderBirds this is close to 0, and it goes up as Birds fly to other
+ * cells and new ones are added. Ghosts are left out, as they aren't the Flock's to move.
+ */
+void Flock::measureScatter(){
+    int pairs = 0, scattered = 0;
+    for(int cell=0; cell<fBirdGrid.getCellCount(); cell++){
+        const int* end = fBirdGrid.cellEnd(cell);
+        const int* previous = 0;
+        for(const int* entry=fBirdGrid.cellBegin(cell); entry!=end; entry++){
+            if(!fIsGhost.empty() && fIsGhost[*entry]) continue;
+            if(previous){
+                const char* a = reinterpret_cast<const char*>(fBirds->at(*previous));
+                const char* b = reinterpret_cast<const char*>(fBirds->at(*entry));
+                pairs++;
+                if(std::abs(a - b) > kNearbyBytes) scattered++;
+            }
+            previous = entry;
+        }
+    }
+    fScatter = pairs > 0 ? (double)scattered/pairs : 0;
+}
+
+/* findNeighbours
+ *
+ * Uses fBirdGrid to find the Birds in the cells within range of a position. Some of the
+ * Birds found may be slightly further away than range, but the behaviour methods all
+ * check distances themselves.
+ *
+ * inputs:
+ * - position: position to search around
+ * - range: distance to search
+ * - neighbours: emptied, then filled with the Birds found
+ * - indices: emptied, then used to hold the indices of the Birds found
+ */
+void Flock::findNeighbours(TwoVector position, double range, std::vector<Bird*>* neighbours, std::vector<int>* indices){
+    indices->clear();
+    double x = (double)position.x(), y = (double)position.y();
+    fBirdGrid.query(x-range, y-range, x+range, y+range, indices);
+
+    neighbours->clear();
+    for(int i=0; i<indices->size(); i++){
+        neighbours->push_back(fBirds->at(indices->at(i)));
+    }
+}
+
+/* sumCells
+ *
+ * Adds up the number and positions of the Birds of each species in every cell of fBirdGrid, for
+ * findFarNeighbours. The cells are split between the threads, as each one only writes its own sums.
+ */
+void Flock::sumCells(){
+    int cellCount = fBirdGrid.getCellCount();
+    fCellSums.resize((size_t)cellCount*kOtherSpecies);
+    parallelFor(cellCount, [this](int begin, int end, int){
+        for(int cell=begin; cell<end; cell++){
+            NeighbourSums* sums = &fCellSums[(size_t)cell*kOtherSpecies];
+            for(int s=0; s<kOtherSpecies; s++){
+                sums[s].count = 0;
+                sums[s].x = 0;
+                sums[s].y = 0;
+            }
+            for(const int* entry=fBirdGrid.cellBegin(cell); entry!=fBirdGrid.cellEnd(cell); entry++){
+                const Bird* b = fBirds->at(*entry);
+                NeighbourSums& sum = sums[b->getSpecies()];
+                sum.count++;
+                sum.x += (double)b->getXPos();
+                sum.y += (double)b->getYPos();
+            }
+        }
+    });
+}
+
+/* findFarNeighbours
+ *
+ * Goes through the same cells as findNeighbours, in the same order. A cell is summed up into far,
+ * rather than having its Birds put in neighbours, if every Bird in it must be further away than
+ * the separation distance, so it can't matter to separation or alignment, and nearer than the
+ * detection distance, so every Bird of the same species in it counts towards cohesion. Cells with
+ * a Predator in them are never summed up, so avoidPredators still sees every Predator, and neither
+ * are the cells around the edge of the grid, as Birds just outside the world are put in them.
+ *
+ * inputs:
+ * - b: the Bird to find the neighbours of
+ * - neighbours: emptied, then filled with the Birds in the cells not summed up
+ * - indices: emptied, then used to hold the indices of those Birds
+ * - far: set to the sums of the Birds of b's species in the cells summed up
+ */
+void Flock::findFarNeighbours(const Bird* b, std::vector<Bird*>* neighbours, std::vector<int>* indices, NeighbourSums* far){
+    double x = (double)b->getXPos(), y = (double)b->getYPos();
+    double detection = b->getDetectionDistance(), separation = b->getSeparationDistance();
+    double range = std::max(detection, separation);
+    double cellSize = fBirdGrid.getCellSize();
+    int columns = fBirdGrid.getColumns(), rows = fBirdGrid.getRows();
+
+    far->count = 0;
+    far->x = 0;
+    far->y = 0;
+    indices->clear();
+    neighbours->clear();
+
+    //nothing to find if the search is completely outside the grid, just as in SpatialGrid::query
+    if(x+range < 0 || y+range < 0 || x-range > columns*cellSize || y-range > rows*cellSize){
+        return;
+    }
+
+    int firstColumn = fBirdGrid.column(x-range), lastColumn = fBirdGrid.column(x+range);
+    int firstRow = fBirdGrid.row(y-range), lastRow = fBirdGrid.row(y+range);
+    for(int r=firstRow; r<=lastRow; r++){
+        double top = r*cellSize, bottom = top + cellSize;
+        double nearY = std::max(0.0, std::max(top - y, y - bottom));
+        double farY = std::max(std::abs(y - top), std::abs(y - bottom));
+        for(int c=firstColumn; c<=lastColumn; c++){
+            int cell = r*columns + c;
+            const NeighbourSums* sums = &fCellSums[(size_t)cell*kOtherSpecies];
+
+            double left = c*cellSize, right = left + cellSize;
+            double nearX = std::max(0.0, std::max(left - x, x - right));
+            double farX = std::max(std::abs(x - left), std::abs(x - right));
+            bool inside = c > 0 && c < columns-1 && r > 0 && r < rows-1 && sums[kRed].count == 0 &&
+                          nearX*nearX + nearY*nearY > separation*separation &&
+                          farX*farX + farY*farY < detection*detection;
+            if(inside){
+                const NeighbourSums& sum = sums[b->getSpecies()];
+                far->count += sum.count;
+                far->x += sum.x;
+                far->y += sum.y;
+                continue;
+            }
+            indices->insert(indices->end(), fBirdGrid.cellBegin(cell), fBirdGrid.cellEnd(cell));
+        }
+    }
+
+    for(int i=0; i<indices->size(); i++){
+        neighbours->push_back(fBirds->at(indices->at(i)));
+    }
+}
+
+/* addBird
+ *
+ * adds a new bird to the flock, if and only if its position is not inside an obstacle.
+ *
+ * inputs:
+ * - b: Bird object to be added
+ *
+ * return: true if Bird added, false if not
+ */
+bool Flock::addBird(Bird* b){
+
+    bool checkPos = checkPositionFree(b->getPosition()); //check if position is clear
+
+    //if position is clear, give the bird its id, add it to the flock, and increment appropiate birdCount
+    if(checkPos){
+        b->setId(fNextId++);
+        fBirds->push_back(b);
+        countBirth(b->getSpecies());
+    }
+    return checkPos;//returns whether Bird was successfully added or not
+
+
+}
+
+/* releaseBirds
+ *
+ * Takes every living Bird whose position is outside a rectangle out of the flock, without deleting
+ * it or counting it as a death, so it can be handed over to the Flock that simulates the part of
+ * the world it has moved into. The Birds left keep their order.
+ *
+ * inputs:
+ * - minX, minY, maxX, maxY: the rectangle, including its top and left edges but not the others
+ * - released: emptied, then filled with the Birds taken out, in id order
+ */
+void Flock::releaseBirds(double minX, double minY, double maxX, double maxY, std::vector<Bird*>* released){
+    released->clear();
+    int kept = 0;
+    for(int i=0; i<fBirds->size(); i++){
+        Bird* b = fBirds->at(i);
+        double x = (double)b->getXPos(), y = (double)b->getYPos();
+        if(!b->getIsDead() && (x < minX || x >= maxX || y < minY || y >= maxY)){
+            fCounters.alive[b->getSpecies()]--;
+            released->push_back(b);
+        }
+        else{
+            fBirds->at(kept++) = b;
+        }
+    }
+    fBirds->resize(kept);
+}
+
+/* adoptBirds
+ *
+ * Adds Birds taken out of another Flock by releaseBirds. They keep the ids they already have, and
+ * are merged in so that fBirds stays in id order. They aren't counted as births.
+ *
+ * inputs:
+ * - birds: the Birds to add, which the Flock now owns. Sorted into id order.
+ */
+void Flock::adoptBirds(std::vector<Bird*>* birds){
+    if(birds->empty()) return;
+    std::sort(birds->begin(), birds->end(), [](const Bird* a, const Bird* b){return a->getId() < b->getId();});
+
+    int middle = fBirds->size();
+    fBirds->insert(fBirds->end(), birds->begin(), birds->end());
+    std::inplace_merge(fBirds->begin(), fBirds->begin() + middle, fBirds->end(),
+                       [](const Bird* a, const Bird* b){return a->getId() < b->getId();});
+    for(int i=0; i<birds->size(); i++){
+        fCounters.alive[birds->at(i)->getSpecies()]++;
+        fNextId = std::max(fNextId, birds->at(i)->getId() + 1);
+    }
+}
+
+/* findBird
+ *
+ * Finds a Bird from its id. fBirds is always in id order, as ids are given out in increasing order
+ * and Birds are removed without changing the order of the rest, so this is a binary search.
+ *
+ * inputs:
+ * - id: id of the Bird
+ *
+ * return: the Bird, or 0 if none has that id
+ */
+Bird* Flock::findBird(int id){
+    int index = findIndex(id);
+    return index < 0 ? 0 : fBirds->at(index);
+}
+
+//index in fBirds of the Bird with an id, found as findBird does, or -1. Ghosts are found too while they are merged in.
+int Flock::findIndex(int id)const{
+    std::vector<Bird*>::const_iterator found = std::lower_bound(fBirds->begin(), fBirds->end(), id,
+                                                                [](const Bird* b, int id){return b->getId() < id;});
+    return found != fBirds->end() && (*found)->getId() == id ? found - fBirds->begin() : -1;
+}
+
+/* Helper method for addBird. Checks whether Bird position is inside an obstacle
+ *
+ * inputs:
+ * - position: position to be checks
+ *
+ * return: true if position is not in an obstacles
+ */
+bool Flock::checkPositionFree(TwoVector position){
+
+    for(int i=0; i<getObstacles()->size(); i++){
+
+        Obstacle* o = getObstacles()->at(i);
+
+        //finds distance between position and centre of obstacle (i.e. it's position)
+        double distance = (double)(o->getPosition()-  position).mag();
+
+        //if distance is smaller than the obstacle radius, then the position is inside the obstacle
+        if(distance <= o->getRadius()){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* spawnBatch
+ *
+ * Adds many Birds of one species at once, at random positions that aren't inside an obstacle.
+ * Rather than creating a Bird and calling addBird for each one until it fits, it picks positions
+ * and headings for every Bird still to be placed, then checks them all at once, split between
+ * threads, each against only the obstacles fObstacleGrid finds near it. Positions that are free
+ * become Birds, added straight to fBirds; new positions are picked for the rest. If the world is
+ * so full of obstacles that some Birds still can't be placed after kSpawnRounds tries, fewer Birds
+ * are added. All random numbers come from the spawning stream, so the same seed always gives the
+ * same Birds. The grids are rebuilt at the end, so the new Birds are drawn and found straight
+ * away, even while the simulation is paused.
+ *
+ * inputs:
+ * - species: Species of the Birds. kRed adds Predators.
+ * - n: number of Birds to add
+ * - params: settings for the new Birds
+ *
+ * return: the number of Birds added
+ */
+int Flock::spawnBatch(int species, int n, const SpeciesParams& params){
+    if(n <= 0) return 0;
+
+    std::string colour = Bird::colourFromSpecies(species);
+    fBirds->reserve(fBirds->size() + n);
+    int added = 0;
+
+    //obstacles may have been added since the grid was last built
+    rebuildObstacleGrid();
+
+    for(int round=0; round<kSpawnRounds && added<n; round++){
+        int count = n - added;
+
+        //candidate positions and headings. Drawn in a fixed order so the result only depends on the seed.
+        fSpawnX.resize(count);
+        fSpawnY.resize(count);
+        fSpawnHeading.resize(count);
+        fSpawnBlocked.assign(count, 0);
+        for(int i=0; i<count; i++){
+            fSpawnX[i] = fRandom.uniform(0, fWorldWidth);
+            fSpawnY[i] = fRandom.uniform(0, fWorldHeight);
+            fSpawnHeading[i] = fRandom.uniformInt(360);
+        }
+
+        /* reject candidates inside obstacles. The search is widened by the largest radius, as an
+         * obstacle can cover a candidate from a cell its centre isn't in. */
+        if(!fObstacles->empty()){
+            parallelFor(count, [this](int begin, int end, int thread){
+                std::vector<int>* near = &fNeighbourIndices[thread];
+                double reach = fMaxObstacleRadius;
+                for(int i=begin; i<end; i++){
+                    Real x = fSpawnX[i], y = fSpawnY[i];
+                    near->clear();
+                    fObstacleGrid.query((double)x-reach, (double)y-reach, (double)x+reach, (double)y+reach, near);
+                    for(int j=0; j<near->size() && !fSpawnBlocked[i]; j++){
+                        Obstacle* o = fObstacles->at(near->at(j));
+                        Real dx = x - o->getXPos(), dy = y - o->getYPos();
+                        Real radius2 = (Real)o->getRadius()*o->getRadius();
+                        fSpawnBlocked[i] = dx*dx + dy*dy <= radius2;
+                    }
+                }
+            });
+        }
+
+        //create the Birds at the free positions
+        for(int i=0; i<count; i++){
+            if(fSpawnBlocked[i]) continue;
+
+            TwoVector position(fSpawnX[i], fSpawnY[i]);
+            Bird* b;
+            if(species == kRed){
+                b = new Predator(position, params.maxSpeed, (int)fSpawnHeading[i], params.separationDistance,
+                                 params.detectionDistance, params.hunger);
+            }
+            else{
+                b = new Bird(position, params.maxSpeed, fSpawnHeading[i], params.separationDistance, params.detectionDistance,
+                             colour, params.separationStrength, params.cohesionStrength, params.alignmentStrength,
+                             params.avoidPredatorStrength);
+            }
+            b->setId(fNextId++);
+            fBirds->push_back(b);
+            added++;
+        }
+    }
+
+    countBirth(species, added);
+    rebuildGrids();
+    fCounterChannel.publish(fCounters);
+    return added;
+}
+
+/* removeBirds
+ *
+ * Removes living Birds of a species straight away, rather than at the start of the next tick, so
+ * the counts are right even while the simulation is paused. The first Birds of the species in
+ * fBirds are removed, as the count boxes in MainWindow have always done. Any other Birds that died
+ * in the last tick are removed at the same time.
+ *
+ * inputs:
+ * - species: species of the Birds to remove
+ * - n: number of Birds to remove
+ *
+ * return: the number of Birds removed, which is less than n if there weren't enough
+ */
+int Flock::removeBirds(int species, int n){
+    int removed = 0;
+    for(int i=0; i<fBirds->size() && removed < n; i++){
+        Bird* b = fBirds->at(i);
+        if(b->getSpecies() == species && !b->getIsDead()){
+            b->setIsDead(true);
+            removed++;
+        }
+    }
+    removeDeadObjects();
+    rebuildGrids();
+    fCounterChannel.publish(fCounters);
+    return removed;
+}
+
+//counts Birds of a species being added to the flock
+void Flock::countBirth(int species, int count){
+    fCounters.alive[species] += count;
+    fCounters.born[species] += count;
+}
+
+//counts a Bird being removed from the flock, and whether it was eaten
+void Flock::countDeath(const Bird* b){
+    int species = b->getSpecies();
+    fCounters.alive[species]--;
+    fCounters.died[species]++;
+    if(b->getWasEaten()) fCounters.eaten[species]++;
+}
+
+//zeroes all of the counters
+void Flock::resetCounters(){
+    fCounters.tick = fTick;
+    for(int species=0; species<kOtherSpecies; species++){
+        fCounters.alive[species] = 0;
+        fCounters.born[species] = 0;
+        fCounters.died[species] = 0;
+        fCounters.eaten[species] = 0;
+    }
+    fCounters.placed = 0;
+    fCounters.remote = 0;
+}
+
+//adds obstacles to fObstacle
+void Flock::addObstacle(Obstacle* o){
+    fObstacles->push_back(o);
+    fObstaclesVersion++;
+}
+
+//changes radius of all obstacles
+void Flock::changeObstacleRadius(int newRadius){
+    for(int i=0; i<fObstacles->size(); i++){
+        fObstacles->at(i)->setRadius(newRadius);
+    }
+    fObstaclesVersion++;
+}
+
+//changes maxSpeed of a specific colour of Bird (blue, green or red)
+void Flock::changeMaxSpeed(std::string colour, int newSpeed){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setMaxSpeed(newSpeed);
+        }
+    }
+}
+
+//changes separation distance of a specific colour of Bird (blue, green or red)
+void Flock::changeSepDistance(std::string colour, int newSep){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setSeparationDistance(newSep);
+        }
+    }
+}
+
+//changes detection distance of a specific colour of Bird (blue, green or red)
+void Flock::changeDetDistance(std::string colour, int newDet){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setDetectionDistance(newDet);
+        }
+    }
+}
+
+//changes hunger of Predators
+void Flock::changeHunger(int newHunger){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare("red")==0){
+            Predator* p = dynamic_cast<Predator*>(fBirds->at(i));//need to specifically cast to Predator to call Predator-specific method.
+            p->setHunger(newHunger);
+        }
+    }
+}
+
+//changes separation force weighting of a specific colour of Bird (blue, green or red)
+void Flock::changeSeparationStrength(std::string colour, double newStrength){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setSeperationStrength(newStrength);
+        }
+    }
+}
+
+//changes cohesion force weighting of a specific colour of Bird (blue or green)
+void Flock::changeCohesionStrength(std::string colour, double newStrength){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setCohesionstrength(newStrength);
+        }
+    }
+}
+
+//changes alignment force weighting of a specific colour of Bird (blue or green)
+void Flock::changeAlignmentStrength(std::string colour, double newStrength){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setAlignmentStrength(newStrength);
+        }
+    }
+}
+
+//changes avoidPredator force weighting of a specific colour of Bird (blue, green or red)
+void Flock::changeAvoidPredatorStrength(std::string colour, double newStrength){
+    for(int i=0; i<fBirds->size(); i++){
+        if(fBirds->at(i)->getColour().compare(colour) == 0){
+            fBirds->at(i)->setAvoidPredatorStrength(newStrength);
+        }
+    }
+}
+
+//removes and deletes all FlockObjects from the vectors
+void Flock::clearFlock(){
+    for(int i=0; i<fBirds->size(); i++){
+        delete fBirds->at(i);
+    }
+    for(int i=0; i<fObstacles->size(); i++){
+        delete fObstacles->at(i);
+    }
+    fBirds->clear();
+    fObstacles->clear();
+    fObstaclesVersion++;
+    resetCounters();
+    fObstacleCount = 0;
+    rebuildGrids();
+}
+
+/* saveCheckpoint
+ *
+ * Copies the whole state of the Flock into a Checkpoint. Birds killed since the start of the
+ * tick are left out, as they would be removed before anything else happened to them, and are
+ * counted in the saved totals as if they had been removed already. This only
+ * copies plain data into arrays that are reused between saves, so it is quick enough to do
+ * between two ticks.
+ *
+ * inputs:
+ * - checkpoint: Checkpoint to fill in
+ */
+void Flock::saveCheckpoint(Checkpoint* checkpoint){
+    checkpoint->header.worldWidth = fWorldWidth;
+    checkpoint->header.worldHeight = fWorldHeight;
+    checkpoint->header.tick = fTick;
+    checkpoint->header.nextId = fNextId;
+    checkpoint->header.seed = fSeed;
+    checkpoint->header.randomCounter = fRandom.getCounter();
+    for(int species=0; species<kOtherSpecies; species++){
+        checkpoint->header.born[species] = fCounters.born[species];
+        checkpoint->header.died[species] = fCounters.died[species];
+        checkpoint->header.eaten[species] = fCounters.eaten[species];
+    }
+
+    checkpoint->birds.clear();
+    checkpoint->birds.reserve(fBirds->size());
+    for(int i=0; i<fBirds->size(); i++){
+        Bird* b = fBirds->at(i);
+        if(b->getIsDead()){
+            checkpoint->header.died[b->getSpecies()]++;
+            if(b->getWasEaten()) checkpoint->header.eaten[b->getSpecies()]++;
+            continue;
+        }
+
+        CheckpointBird saved;
+        saveBird(b, &saved);
+        checkpoint->birds.push_back(saved);
+    }
+
+    checkpoint->obstacles.clear();
+    checkpoint->obstacles.reserve(fObstacles->size());
+    for(int i=0; i<fObstacles->size(); i++){
+        Obstacle* o = fObstacles->at(i);
+        if(o->getIsDead()) continue;
+
+        CheckpointObstacle saved;
+        saved.x = (double)o->getXPos();
+        saved.y = (double)o->getYPos();
+        saved.radius = o->getRadius();
+        saved.reserved = 0;
+        checkpoint->obstacles.push_back(saved);
+    }
+}
+
+/* restoreCheckpoint
+ *
+ * Replaces everything in the Flock with the contents of a Checkpoint. Unlike addBird, the Birds
+ * are not checked against the obstacles (they were already valid when saved), the vectors are
+ * allocated once, the counts are worked out in a single pass and the grids are only rebuilt at
+ * the end, so restoring a large flock is much faster than adding it one Bird at a time. The born,
+ * died and eaten totals carry on from the saved ones, so they match the run that was saved.
+ *
+ * inputs:
+ * - checkpoint: Checkpoint to restore
+ */
+void Flock::restoreCheckpoint(const Checkpoint* checkpoint){
+    clearFlock();
+
+    fWorldWidth = checkpoint->header.worldWidth;
+    fWorldHeight = checkpoint->header.worldHeight;
+    fTick = checkpoint->header.tick;
+    fNextId = checkpoint->header.nextId;
+    fDeaths.clear();
+    setSeed(checkpoint->header.seed);
+    fRandom.setCounter(checkpoint->header.randomCounter);
+
+    fBirds->reserve(checkpoint->birds.size());
+    for(int i=0; i<checkpoint->birds.size(); i++){
+        Bird* b = restoreBird(checkpoint->birds[i]);
+        fBirds->push_back(b);
+        countBirth(b->getSpecies());
+    }
+
+    fObstacles->reserve(checkpoint->obstacles.size());
+    for(int i=0; i<checkpoint->obstacles.size(); i++){
+        const CheckpointObstacle& saved = checkpoint->obstacles[i];
+        addObstacle(new Obstacle(TwoVector(saved.x, saved.y), saved.radius));
+    }
+    fObstacleCount = fObstacles->size();
+    for(int species=0; species<kOtherSpecies; species++){
+        fCounters.born[species] = checkpoint->header.born[species];
+        fCounters.died[species] = checkpoint->header.died[species];
+        fCounters.eaten[species] = checkpoint->header.eaten[species];
+    }
+
+    rebuildGrids();
+    fCounters.tick = fTick;
+    fCounterChannel.publish(fCounters);
+}
+
+/* saveBird
+ *
+ * Copies everything about a Bird, or a Predator, into a CheckpointBird.
+ *
+ * inputs:
+ * - b: the Bird
+ * - saved: set to the copy
+ */
+void Flock::saveBird(Bird* b, CheckpointBird* saved){
+    saved->id = b->getId();
+    saved->species = b->getSpecies();
+    Predator* p = dynamic_cast<Predator*>(b);
+    saved->hunger = p ? p->getHunger() : -1;
+    saved->separationDistance = b->getSeparationDistance();
+    saved->detectionDistance = b->getDetectionDistance();
+    saved->knownForces = b->getKnownForces();
+    saved->x = (double)b->getXPos();
+    saved->y = (double)b->getYPos();
+    saved->vx = (double)b->getVelocity().x();
+    saved->vy = (double)b->getVelocity().y();
+    saved->heading = (double)b->getHeading();
+    saved->maxSpeed = (double)b->getMaxSpeed();
+    saved->separationStrength = (double)b->getSeperationStrength();
+    saved->cohesionStrength = (double)b->getCohesionstrength();
+    saved->alignmentStrength = (double)b->getAlignmentStrength();
+    saved->avoidPredatorStrength = (double)b->getAvoidPredatorStrength();
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        saved->slowForces[behaviour][0] = (double)b->getSlowForce(behaviour).x();
+        saved->slowForces[behaviour][1] = (double)b->getSlowForce(behaviour).y();
+    }
+}
+
+/* restoreBird
+ *
+ * Makes a new Bird, or Predator, from a CheckpointBird made by saveBird. It has the id it was
+ * saved with, but isn't added to any Flock.
+ *
+ * inputs:
+ * - saved: the saved Bird
+ *
+ * return: the new Bird, which the caller owns
+ */
+Bird* Flock::restoreBird(const CheckpointBird& saved){
+    TwoVector position(saved.x, saved.y);
+    Bird* b;
+    if(saved.hunger >= 0){
+        b = new Predator(position, saved.maxSpeed, 0, saved.separationDistance, saved.detectionDistance, saved.hunger);
+        b->setSeperationStrength(saved.separationStrength);
+        b->setCohesionstrength(saved.cohesionStrength);
+        b->setAlignmentStrength(saved.alignmentStrength);
+        b->setAvoidPredatorStrength(saved.avoidPredatorStrength);
+    }
+    else{
+        b = new Bird(position, saved.maxSpeed, 0, saved.separationDistance, saved.detectionDistance,
+                     Bird::colourFromSpecies(saved.species), saved.separationStrength, saved.cohesionStrength,
+                     saved.alignmentStrength, saved.avoidPredatorStrength);
+    }
+    b->setVelocity(TwoVector(saved.vx, saved.vy));
+    b->setHeading(saved.heading);
+    b->setId(saved.id);
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        if(saved.knownForces & (1 << behaviour)) b->setSlowForce(behaviour, TwoVector(saved.slowForces[behaviour][0], saved.slowForces[behaviour][1]));
+    }
+    return b;
+}
@@ -1,96 +1,479 @@
-/* Flock.cpp
- * Author: Max Elliott
- * Created On: 2017-12-12
- *
- * Header file to Flock. Used to store all FlockObjects currently in the simulation.
- * It has runs the simulation by calling the update method and move method of all the Birds. It also
- * removes any dead Birds. It has methods to add and remove each type of FlockObject, and to alter
- * the data members of them.
- *
- */
-#ifndef FLOCK_H
-#define FLOCK_H
-
-#include <vector>
-#include <string>
-#include "Bird.h"
-#include "Obstacle.h"
-
-class Flock
-{
-public:
-
-    //Constructor
-    Flock();
-
-    //Deconstructor
-    virtual ~Flock();
-
-    /* Getter methods for data members. Declared inline for faster execution time,
-     * at the cost of more memory usage. Declared const so compiler can perform
-     * some optimisation */
-    inline std::vector<Bird*>* getBirds(){return fBirds;}
-    inline std::vector<Obstacle*>* getObstacles(){return fObstacles;}
-
-    inline const int getBlueCount()const{return fBlueCount;}
-    inline const int getGreenCount()const{return fGreenCount;}
-    inline const int getPredCount()const{return fPredCount;}
-    inline const int getObstacleCount()const{return fObstacleCount;}
-
-    //Setters for data memebers
-    inline void setBlueCount(int newVal){fBlueCount =newVal;}
-    inline void setGreenCount(int newVal){ fGreenCount=newVal;}
-    inline void setPredCount(int newVal){ fPredCount=newVal;}
-    inline void setObstacleCount(int newVal){fObstacleCount=newVal;}
-
-    //Method that runs all the actual simulating of the Birds
-    void simulateFlock(int xdim, int ydim);
-
-    //add bird to fBirds
-    bool addBird(Bird* b);
-
-    //helper method for addBird: checks position isn't blocked by obstacles
-    bool checkPositionFree(TwoVector position);
-
-    //remove a FlockObject whose fIsDead==true
-    void removeBird(std::string colour, int index);
-
-    //add an obstacle
-    void addObstacle(Obstacle* o);
-
-    /* Methods to change the data members of FlockObjects. The data memers of
-     * specific colours cn be changed separately to allow different behaviour
-     * for different coloured birds. */
-    void changeObstacleRadius(int newRadius);
-    void changeMaxSpeed(std::string colour, int newSpeed);
-    void changeSepDistance(std::string colour, int newSep);
-    void changeDetDistance(std::string colour, int newDet);
-    void changeHunger(int newHunger);
-    void changeSeparationStrength(std::string colour, double newStrength);
-    void changeCohesionStrength(std::string colour, double newStrength);
-    void changeAlignmentStrength(std::string colour, double newStrength);
-    void changeAvoidPredatorStrength(std::string colour, double newStrength);
-
-    //removes all FlockObjects from flock.
-    void clearFlock();
-
-private:
-
-    /* Two vectors are used to store all Flock objects, one for all Birds and Predators,
-     * and one for all Obstacles. The vectors are declared as pointers so that they can
-     * be passed as arguments in methods between classes without having to recreate the
-     * vector each time, which would be slow and heavy on memory usage. Each object in
-     * the vectors must also be declared as a pointer for the same reasons.
-     */
-    std::vector<Bird*>* fBirds;
-    std::vector<Obstacle*>* fObstacles;
-
-    /* integer counts to keep track of how many of each FlockObject there is. Used by
-     * MainWindow to add/remove the right amount of objects when controls are changed.*/
-    int fBlueCount;
-    int fGreenCount;
-    int fPredCount;
-    int fObstacleCount;
-};
-
-#endif // FLOCK_H
+/* Flock.cpp
+ * Author: Max Elliott
+ * Created On: 2017-12-12
+ *
+ * Header file to Flock. Used to store all FlockObjects currently in the simulation.
+ * It has runs the simulation by calling the update method and move method of all the Birds. It also
+ * removes any dead Birds. It has methods to add and remove each type of FlockObject, and to alter
+ * the data members of them.
+ *
+ */
+#ifndef FLOCK_H
+#define FLOCK_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include "Bird.h"
+#include "Obstacle.h"
+#include "SpatialGrid.h"
+#include "Random.h"
+#include "StatsChannel.h"
+
+class TrajectoryRecorder;
+class FlockAnalytics;
+class SharedFlockWriter;
+class StreamServer;
+
+/* Counts of the Birds of each species, kept up to date by Flock as Birds are added and removed.
+ * born, died and eaten are totals since the Flock was last cleared, so a reader that misses some
+ * ticks can still tell how many happened in between by taking the difference. */
+struct FlockCounters
+{
+    long long tick;
+    int alive[kOtherSpecies];//Birds in the flock now
+    long long born[kOtherSpecies];//Birds added
+    long long died[kOtherSpecies];//Birds removed, for any reason
+    long long eaten[kOtherSpecies];//Birds removed because a Predator ate them
+    long long placed;//Birds updated in the last tick whose memory was found on a NUMA node, if measured (see setMeasurePlacement)
+    long long remote;//those of them updated by a thread on another node
+};
+class Checkpoint;
+struct CheckpointBird;
+class ThreadPool;
+
+class Flock
+{
+public:
+
+    //Constructor
+    Flock();
+
+    //Deconstructor
+    virtual ~Flock();
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline std::vector<Bird*>* getBirds(){return fBirds;}
+    inline std::vector<Obstacle*>* getObstacles(){return fObstacles;}
+    inline SpatialGrid* getBirdGrid(){return &fBirdGrid;}
+    inline SpatialGrid* getObstacleGrid(){return &fObstacleGrid;}
+    inline const int getWorldWidth()const{return fWorldWidth;}
+    inline const int getWorldHeight()const{return fWorldHeight;}
+    inline const int getMaxObstacleRadius()const{return fMaxObstacleRadius;}
+    inline const long long getTick()const{return fTick;}
+    inline const std::vector<int>* getDeaths()const{return &fDeaths;}
+    inline const uint64_t getSeed()const{return fSeed;}
+    inline Random* getRandom(){return &fRandom;}
+    inline const int getThreadCount()const{return fThreadCount;}
+    inline const int getReorderInterval()const{return fReorderInterval;}
+    inline const long long getReorderCount()const{return fReorderCount;}
+    inline const double getScatter()const{return fScatter;}//as last measured, or 0 if the Birds have been reordered since
+    inline const bool getFarField()const{return fFarField;}
+    inline const bool getSkipIsolated()const{return fSkipIsolated;}
+    inline const long long getIsolatedCount()const{return fIsolatedCount;}
+    inline const long long getCoastingCount()const{return fCoastingCount;}
+    inline const bool getPinThreads()const{return fPinThreads;}
+    inline const bool getMeasurePlacement()const{return fMeasurePlacement;}
+    inline const int getBehaviourInterval(int behaviour)const{return fBehaviourIntervals[behaviour];}
+
+    inline const int getBlueCount()const{return fCounters.alive[kBlue];}
+    inline const int getGreenCount()const{return fCounters.alive[kGreen];}
+    inline const int getPredCount()const{return fCounters.alive[kRed];}
+    inline const int getSpeciesCount(int species)const{return fCounters.alive[species];}
+    inline const int getObstacleCount()const{return fObstacleCount;}
+    inline const FlockCounters* getCounters()const{return &fCounters;}
+
+    /* The counters are published here at the end of every tick, and by spawnBatch, removeBirds,
+     * clearFlock and restoreCheckpoint, for whatever shows them. Only one thread at a time may run
+     * the Flock, and only one may read the channel. */
+    inline StatsChannel<FlockCounters>* getCounterChannel(){return &fCounterChannel;}
+
+    //Setters for data memebers. The Bird counts are kept by the Flock itself, so can't be set.
+    inline void setObstacleCount(int newVal){fObstacleCount=newVal;}
+
+    //sets the recorder that every tick is recorded into. 0 to stop recording.
+    inline void setRecorder(TrajectoryRecorder* recorder){fRecorder = recorder;}
+
+    //sets the analytics that measure the flock as it is simulated. 0 to stop measuring.
+    inline void setAnalytics(FlockAnalytics* analytics){fAnalytics = analytics;}
+
+    //sets the writer that every tick is published to shared memory through. 0 to stop publishing.
+    inline void setExporter(SharedFlockWriter* exporter){fExporter = exporter;}
+
+    //sets the server that every tick is streamed to viewers through. 0 to stop streaming.
+    inline void setStreamServer(StreamServer* server){fStreamServer = server;}
+
+    /* sets the ghosts: Birds simulated by another Flock (see DistributedFlock) that this Flock's Birds
+     * can see, but that it doesn't own, update or move. They must be in id order. Each tick they are
+     * merged into fBirds while the Birds are updated, and taken out again before anything moves.
+     * 0 for none. Not owned by the Flock. */
+    inline void setGhosts(std::vector<Bird*>* ghosts){fGhosts = ghosts;}
+
+    /* sets a function called each tick once every Predator has claimed what it caught, before the
+     * claims are eaten (see eatCatches), so claims on ghosts can be settled with the Flocks that own
+     * them through getGhostClaims, claimBird, getClaim and loseClaim. Empty for none. */
+    inline void setClaimSettler(std::function<void()> settler){fClaimSettler = settler;}
+
+    /* while the claims are being settled: the winning claim this Flock's Predators made on each ghost
+     * they caught, in id order (see claimCatch) */
+    void getGhostClaims(std::vector<std::pair<Bird*, uint64_t> >* claims);
+
+    /* while the claims are being settled: claims one of this Flock's own Birds for a Predator of another
+     * Flock. The claim wins if it is the smallest, and the Bird is then eaten with the rest. Returns
+     * false if the Flock doesn't own a Bird with that id. */
+    bool claimBird(int id, uint64_t claim);
+
+    //while the claims are being settled: the smallest claim on a Bird or ghost so far
+    uint64_t getClaim(int id);
+
+    //while the claims are being settled: drops every claim on a ghost, as a Predator of another Flock won it
+    void loseClaim(int id);
+
+    /* sets how often the Birds are checked for being scattered in memory: every interval ticks, and
+     * if they have become too scattered they are put back into Morton order (see reorderBirds). 0 to
+     * never check. */
+    inline void setReorderInterval(int interval){fReorderInterval = interval;}
+    static const int kDefaultReorderInterval = 100;
+
+    /* Sets whether far away neighbours are summed up cell by cell. With large detection distances
+     * each Bird has a great many neighbours, nearly all of which only matter to cohesion. When this is
+     * on, the grid cells that are entirely inside a Bird's detection distance and entirely outside
+     * its separation distance are handed to it as a count and a position sum for its species,
+     * worked out once per tick, and only the other cells are looked at Bird by Bird. The same Birds
+     * are found either way; only the order they are added up in changes, so the result differs from
+     * the exact one by rounding. Off by default. */
+    inline void setFarField(bool farField){fFarField = farField;}
+
+    /* Sets whether isolated Birds skip the neighbour search. A Bird with no other Bird in the grid
+     * cells it would search is given an empty list of neighbours instead of looking through them,
+     * which is exactly what it would have found. The Birds in those cells are counted every tick, a
+     * row at a time without looking at them. If such a Bird is also away from the walls, kept no
+     * force from a slow behaviour and has no obstacle near the line it is flying along, no force
+     * acts on it, so it coasts (see Bird::coast): it only speeds up along its velocity, as update
+     * would have it, without working out anything else. It carries on coasting until the grid puts
+     * another Bird near it, or it nears a wall. Predators always hunt. The results are exactly the
+     * same either way. In a sparse world where most Birds are alone the search saves about a tenth
+     * of the time per tick and coasting a fifth more, and neither saves anything once they have
+     * flocked together. getIsolatedCount and getCoastingCount are how many were isolated and
+     * coasted in the last tick. On by default. */
+    inline void setSkipIsolated(bool skipIsolated){fSkipIsolated = skipIsolated;}
+
+    /* Sets how often each Bird works out one of the SlowBehaviours: every interval ticks, staggered
+     * by id so the work is spread over the ticks, reusing the force from last time in between. A
+     * Bird with none due only looks for neighbours as far as its separation distance. Predators
+     * don't have these behaviours, so always hunt. A Bird works out every behaviour it never has
+     * on its first tick, whatever the interval, looking as far as it needs to. The forces kept in
+     * between are saved in checkpoints and handed between tiles with the Bird, so a restored or
+     * tiled run ends exactly as one Flock run straight through. 1, every tick, by default. */
+    inline void setBehaviourInterval(int behaviour, int interval){fBehaviourIntervals[behaviour] = std::max(1, interval);}
+
+    /* Sets whether the threads are pinned to cores, filling one NUMA node after another (see
+     * ThreadPool). Each thread then updates the same share of the Birds every tick, with the Birds
+     * taken in the Morton order of their cells so each share is a patch of the world, and when the
+     * Birds are put in Morton order in memory (see reorderBirds) each thread moves the pages of its
+     * share to its own node. The result is the same either way. Off by default. */
+    void setPinThreads(bool pinThreads);
+
+    /* Sets whether Birds are allocated in huge pages, as a HugePages (see Numa.h and BirdArena). This
+     * is for every Flock in the program, and Birds already made stay where they are until they are
+     * next moved. */
+    inline void setHugePages(int hugePages){BirdArena::setHugePages(hugePages);}
+
+    /* Sets whether each tick counts how many Birds are updated by a thread on another NUMA node than
+     * the Bird's memory, into the placed and remote counters. Each thread asks the kernel where the
+     * Birds it is about to update are, a few hundred at a time, which takes a little time. Off by
+     * default. */
+    inline void setMeasurePlacement(bool measure){fMeasurePlacement = measure;}
+
+    //sets the size of the world the birds live in. Birds outside of it die.
+    void setWorldSize(int width, int height);
+
+    //sets the seed of all random numbers used by the flock, and restarts them
+    void setSeed(uint64_t seed);
+
+    //random numbers for one Bird in the current tick, the same whichever thread asks for them
+    Random birdRandom(int id)const;
+
+    //sets the number of threads used to simulate the flock (0 for one per core)
+    void setThreadCount(int threadCount);
+
+    //Method that runs all the actual simulating of the Birds
+    void simulateFlock();
+
+    //add bird to fBirds
+    bool addBird(Bird* b);
+
+    //takes every living Bird outside a rectangle out of the flock, to hand over to another Flock. Not counted as deaths.
+    void releaseBirds(double minX, double minY, double maxX, double maxY, std::vector<Bird*>* released);
+
+    //adds Birds released by another Flock, keeping their ids. Not counted as births.
+    void adoptBirds(std::vector<Bird*>* birds);
+
+    //the Bird with an id, or 0 if there isn't one
+    Bird* findBird(int id);
+
+    //helper method for addBird: checks position isn't blocked by obstacles
+    bool checkPositionFree(TwoVector position);
+
+    //adds n Birds (or Predators) of a species at random free positions. Returns the number added.
+    int spawnBatch(int species, int n, const SpeciesParams& params);
+
+    //removes up to n living Birds of a species straight away. Returns the number removed.
+    int removeBirds(int species, int n);
+
+    //remove all Birds and Obstacles whose fIsDead==true
+    void removeDeadObjects();
+
+    //rebuilds the spatial grids from the current positions of all Birds and Obstacles
+    void rebuildGrids();
+
+    //rebuilds only the grid of Obstacles
+    void rebuildObstacleGrid();
+
+    //collects all birds within range of a position into neighbours, using fBirdGrid. indices is used as a buffer.
+    void findNeighbours(TwoVector position, double range, std::vector<Bird*>* neighbours, std::vector<int>* indices);
+
+    //add an obstacle
+    void addObstacle(Obstacle* o);
+
+    /* Methods to change the data members of FlockObjects. The data memers of
+     * specific colours cn be changed separately to allow different behaviour
+     * for different coloured birds. */
+    void changeObstacleRadius(int newRadius);
+    void changeMaxSpeed(std::string colour, int newSpeed);
+    void changeSepDistance(std::string colour, int newSep);
+    void changeDetDistance(std::string colour, int newDet);
+    void changeHunger(int newHunger);
+    void changeSeparationStrength(std::string colour, double newStrength);
+    void changeCohesionStrength(std::string colour, double newStrength);
+    void changeAlignmentStrength(std::string colour, double newStrength);
+    void changeAvoidPredatorStrength(std::string colour, double newStrength);
+
+    //removes all FlockObjects from flock.
+    void clearFlock();
+
+    //copies the whole state of the flock into a Checkpoint, and replaces it with the contents of one
+    void saveCheckpoint(Checkpoint* checkpoint);
+    void restoreCheckpoint(const Checkpoint* checkpoint);
+
+    //copies one Bird into a CheckpointBird, and makes a new Bird from one
+    static void saveBird(Bird* b, CheckpointBird* saved);
+    static Bird* restoreBird(const CheckpointBird& saved);
+
+private:
+
+    /* Two vectors are used to store all Flock objects, one for all Birds and Predators,
+     * and one for all Obstacles. The vectors are declared as pointers so that they can
+     * be passed as arguments in methods between classes without having to recreate the
+     * vector each time, which would be slow and heavy on memory usage. Each object in
+     * the vectors must also be declared as a pointer for the same reasons.
+     */
+    std::vector<Bird*>* fBirds;
+    std::vector<Obstacle*>* fObstacles;
+
+    /* Counts to keep track of how many of each FlockObject there is. Used by MainWindow to
+     * add/remove the right amount of objects when controls are changed. The Bird counts are only
+     * changed by countBirth and countDeath, as Birds are added to and removed from fBirds. */
+    FlockCounters fCounters;
+    StatsChannel<FlockCounters> fCounterChannel;
+    int fObstacleCount;
+
+    //update fCounters for a Bird that has been added or removed
+    void countBirth(int species, int count = 1);
+    void countDeath(const Bird* b);
+
+    //zeroes fCounters
+    void resetCounters();
+
+    /* Size of the world. This is separate from the size of the DisplayWindow, which only
+     * shows the part of the world its camera is looking at. */
+    int fWorldWidth;
+    int fWorldHeight;
+
+    /* Spatial grids of the Birds and Obstacles, rebuilt every tick. Used to find the neighbours
+     * of each Bird without checking the whole flock, and by DisplayWindow to only draw what is
+     * on screen. fMaxObstacleRadius is the largest obstacle radius when the grids were built, so
+     * queries can be widened enough to find obstacles whose centre is outside the query. */
+    SpatialGrid fBirdGrid;
+    SpatialGrid fObstacleGrid;
+    int fMaxObstacleRadius;
+
+    //number of ticks simulated so far
+    long long fTick;
+
+    //id given to the next Bird added
+    int fNextId;
+
+    //ids of the Birds removed since the last tick was recorded
+    std::vector<int> fDeaths;
+
+    //records every tick if not 0. Not owned by the Flock.
+    TrajectoryRecorder* fRecorder;
+
+    //measures the flock every few ticks if not 0, and whether it is measuring this tick. Not owned by the Flock.
+    FlockAnalytics* fAnalytics;
+    bool fAnalysing;
+
+    //publishes every tick to shared memory if not 0. Not owned by the Flock.
+    SharedFlockWriter* fExporter;
+
+    //streams every tick to anyone watching if not 0. Not owned by the Flock.
+    StreamServer* fStreamServer;
+
+    /* Birds of other Flocks seen this tick if not 0 (see setGhosts). Not owned by the Flock. While
+     * they are merged into fBirds, fOwnBirds holds the Flock's own Birds and fIsGhost marks which
+     * Birds in fBirds are ghosts. */
+    std::vector<Bird*>* fGhosts;
+    std::vector<Bird*> fOwnBirds;
+    std::vector<unsigned char> fIsGhost;
+
+    //merges fGhosts into fBirds in id order, and takes them out again
+    void mergeGhosts();
+    void unmergeGhosts();
+
+    //candidate positions and headings used by spawnBatch, and whether each one is blocked
+    std::vector<Real> fSpawnX;
+    std::vector<Real> fSpawnY;
+    std::vector<Real> fSpawnHeading;
+    std::vector<unsigned char> fSpawnBlocked;
+
+    //reused every tick to hold the neighbours of the Bird being updated, one of each per thread
+    std::vector<std::vector<Bird*> > fNeighbours;
+    std::vector<std::vector<int> > fNeighbourIndices;
+
+    /* Random numbers. fSeed is the seed of every stream, fRandom is the stream used to spawn new
+     * FlockObjects, and each Bird has its own stream (see birdRandom). */
+    uint64_t fSeed;
+    Random fRandom;
+
+    //threads used by simulateFlock. Made when first needed, so it isn't started for Flocks that never run.
+    ThreadPool* fThreadPool;
+    int fThreadCount;
+
+    /* Putting the Birds in Morton order in memory. fReorderInterval is the ticks between checks,
+     * fLastReorderCheck the tick of the last one and fReorderCount how many times the Birds have been
+     * reordered. fScatter is the fraction of Birds in the same grid cell as the one before them that
+     * are far from it in memory, measured at each check, and fReorderDue is set if it was too high,
+     * so the Birds are reordered at the start of the next tick. fSortValues, fSortBuffer, fSlots and
+     * fMoved are reused by every reorder. */
+    int fReorderInterval;
+    long long fLastReorderCheck;
+    long long fReorderCount;
+    double fScatter;
+    bool fReorderDue;
+    std::vector<uint64_t> fSortValues;
+    std::vector<uint64_t> fSortBuffer;
+    std::vector<Bird*> fSlots;
+    std::vector<Bird> fMoved;
+
+    //moves the Birds between their objects so they are in Morton order in memory, keeping their ids and places in fBirds
+    void reorderBirds();
+
+    //works out fScatter from fBirdGrid
+    void measureScatter();
+
+    /* Summing up far away neighbours (see setFarField). fCellSums holds kOtherSpecies sums for each
+     * cell of fBirdGrid, one per species, worked out by sumCells after the grid is built. */
+    bool fFarField;
+    std::vector<NeighbourSums> fCellSums;
+
+    //works out fCellSums
+    void sumCells();
+
+    /* Isolated Birds (see setSkipIsolated). fIsolated counts the isolated Birds each thread updates,
+     * and fIsolatedCount is their total for the last tick, and likewise for the ones that coasted.
+     * fObstaclesVersion changes whenever an obstacle is added or resized, so coasting Birds check
+     * them again. */
+    bool fSkipIsolated;
+    std::vector<long long> fIsolated;
+    long long fIsolatedCount;
+    std::vector<long long> fCoasting;
+    long long fCoastingCount;
+    int fObstaclesVersion;
+
+    //finds the neighbours of a Bird like findNeighbours, but sums up the cells it can into far
+    void findFarNeighbours(const Bird* b, std::vector<Bird*>* neighbours, std::vector<int>* indices, NeighbourSums* far);
+
+    /* Predation. A Predator that catches a Bird claims it in fClaims, which has a claim for each Bird
+     * in fBirds (of fClaimCapacity), and is added to the list of its thread in fHunters, with the
+     * index of the Bird it caught. See claimCatch and eatCatches. */
+    std::atomic<uint64_t>* fClaims;
+    int fClaimCapacity;
+    std::vector<std::vector<std::pair<int, int> > > fHunters;
+
+    //claims other Flocks made on this Flock's Birds this tick, as indices in fBirds and claims (see claimBird)
+    std::vector<std::pair<int, uint64_t> > fRemoteClaims;
+
+    //called before the claims are eaten, if set (see setClaimSettler)
+    std::function<void()> fClaimSettler;
+
+    //makes sure there is an unclaimed claim for every Bird
+    void prepareClaims();
+
+    //claims the Bird caught by the Predator at index, if any, for the given thread
+    void claimCatch(int index, int thread);
+
+    //lets each Predator eat the Bird it caught, if its claim won, and clears the claims
+    void eatCatches();
+
+    //index in fBirds of the Bird or ghost with an id, or -1 if there isn't one
+    int findIndex(int id)const;
+
+    //value of a claim no Predator has made
+    static const uint64_t kUnclaimed = ~0ULL;
+
+    //finds the neighbours of the Bird at index and updates it, using the buffers of the given thread
+    void updateBird(int index, int thread);
+
+    //ticks between working out each SlowBehaviour (see setBehaviourInterval)
+    int fBehaviourIntervals[kSlowBehaviours];
+
+    //mask of the SlowBehaviours b works out this tick
+    int dueBehaviours(const Bird* b)const;
+
+    /* NUMA placement (see setPinThreads and setMeasurePlacement). fMortonCells lists the cells of
+     * fBirdGrid, of fMortonColumns columns, in Morton order, and fUpdateOrder the Birds in them, in
+     * the order pinned threads update them. fPlaced and fRemote are counted by each thread. */
+    bool fPinThreads;
+    bool fMeasurePlacement;
+    std::vector<int> fMortonCells;
+    int fMortonColumns;
+    std::vector<int> fUpdateOrder;
+    std::vector<long long> fPlaced;
+    std::vector<long long> fRemote;
+
+    //fills fUpdateOrder from fBirdGrid
+    void orderByMorton();
+
+    //counts how many of count Birds, at the indices given, are on another node than the calling thread
+    void measurePlacement(const int* indices, int count, int thread);
+
+    //runs function(begin, end, thread) over the range [0, count) using fThreadPool
+    void parallelFor(int count, std::function<void(int, int, int)> function);
+
+    //width of the cells in fBirdGrid and fObstacleGrid
+    static const int kGridCellSize = 50;
+
+    //percentage of scattered Birds (see fScatter) above which a check reorders the Birds
+    static const int kReorderScatterPercent = 25;
+
+    //two Birds closer than this in memory are counted as near each other by measureScatter
+    static const int kNearbyBytes = 4096;
+
+    //number of Birds handed to a thread at a time
+    static const int kBirdsPerChunk = 256;
+
+    //number of times spawnBatch samples new positions for the Birds still to place before giving up
+    static const int kSpawnRounds = 16;
+
+    //stream used for spawning, and the first of the Bird streams (stream kBirdStreams + id is used by the Bird with that id)
+    static const uint64_t kSpawnStream = 0;
+    static const uint64_t kBirdStreams = 1;
+};
+
+#endif // FLOCK_H
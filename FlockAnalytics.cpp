@@ -0,0 +1,185 @@
+/* FlockAnalytics.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for FlockAnalytics, which measures the flock as it is simulated.
+ */
+#include "FlockAnalytics.h"
+#include "Flock.h"
+#include <cmath>
+#include <algorithm>
+
+//Constructor
+FlockAnalytics::FlockAnalytics(int interval, double binWidth) :
+    fInterval(interval), fBinWidth(binWidth), fParent(0), fCapacity(0)
+{
+}
+
+//Deconstructor
+FlockAnalytics::~FlockAnalytics(){
+    delete[] fParent;
+}
+
+/* beginTick
+ *
+ * Puts every Bird in a set of its own, and clears the nearest neighbour distances.
+ *
+ * inputs:
+ * - birdCount: number of Birds in the flock this tick
+ */
+void FlockAnalytics::beginTick(int birdCount){
+    //atomics can't be moved, so the array is only made again when it needs to grow
+    if(birdCount > fCapacity){
+        delete[] fParent;
+        fCapacity = std::max(birdCount, 2*fCapacity);
+        fParent = new std::atomic<int>[fCapacity];
+    }
+    for(int i=0; i<birdCount; i++){
+        fParent[i].store(i, std::memory_order_relaxed);
+    }
+    fNearest.assign(birdCount, -1);
+}
+
+/* observe
+ *
+ * Finds the nearest of a Bird's neighbours, and joins its cluster with every neighbour of the same
+ * species within its detection distance. Each call only writes to the Bird's own nearest distance
+ * and to the union-find, so it can be called for different Birds from different threads at once.
+ *
+ * inputs:
+ * - index: index of the Bird in the Flock
+ * - b: the Bird
+ * - range: the distance its neighbours were searched for within
+ * - neighbours: its neighbours, as found by Flock::findNeighbours
+ * - indices: the indices of the neighbours
+ */
+void FlockAnalytics::observe(int index, const Bird* b, double range, const std::vector<Bird*>* neighbours, const std::vector<int>* indices){
+    double x = (double)b->getXPos();
+    double y = (double)b->getYPos();
+    double nearestSquared = range*range;
+    bool found = false;
+    double detectionSquared = b->getDetectionDistance()*b->getDetectionDistance();
+
+    for(int i=0; i<neighbours->size(); i++){
+        int other = indices->at(i);
+        if(other == index) continue;
+
+        const Bird* n = neighbours->at(i);
+        double dx = (double)n->getXPos() - x;
+        double dy = (double)n->getYPos() - y;
+        double distanceSquared = dx*dx + dy*dy;
+
+        //the search covers whole cells, so anything beyond range may not be the nearest
+        if(distanceSquared <= nearestSquared){
+            nearestSquared = distanceSquared;
+            found = true;
+        }
+        if(n->getSpecies() == b->getSpecies() && dx*dx + dy*dy < detectionSquared){
+            join(index, other);
+        }
+    }
+    fNearest[index] = found ? std::sqrt(nearestSquared) : -1;
+}
+
+//root of the set a Bird is in. Each step points the Bird at its grandparent, halving the path.
+int FlockAnalytics::find(int index){
+    while(true){
+        int parent = fParent[index].load(std::memory_order_relaxed);
+        if(parent == index) return index;
+        int grandparent = fParent[parent].load(std::memory_order_relaxed);
+        if(grandparent != parent){
+            //another thread may have changed it already, in which case this is just skipped
+            fParent[index].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+        }
+        index = grandparent;
+    }
+}
+
+/* join
+ *
+ * Joins the sets of two Birds by pointing the higher root at the lower one. If another thread
+ * changes the higher root first, the compare and swap fails and the roots are found again, so
+ * no join is ever lost. Parents only ever point to lower indices, so there are never any loops.
+ *
+ * inputs:
+ * - a, b: indices of the Birds
+ */
+void FlockAnalytics::join(int a, int b){
+    while(true){
+        a = find(a);
+        b = find(b);
+        if(a == b) return;
+        if(a < b) std::swap(a, b);
+
+        int expected = a;
+        if(fParent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return;
+    }
+}
+
+/* finishTick
+ *
+ * Works out the stats from the velocities of the Birds and what observe() recorded, and publishes
+ * them on the channel. Called after every Bird has been updated but before any has moved, so the
+ * positions and velocities are still the ones the neighbours were found with.
+ *
+ * inputs:
+ * - flock: the Flock being measured
+ */
+void FlockAnalytics::finishTick(Flock* flock){
+    FlockStats stats;
+    stats.tick = flock->getTick();
+    stats.histogramBinWidth = fBinWidth;
+
+    double headingX[kOtherSpecies] = {0, 0, 0};
+    double headingY[kOtherSpecies] = {0, 0, 0};
+    double nearestSum[kOtherSpecies] = {0, 0, 0};
+    for(int species=0; species<kOtherSpecies; species++){
+        stats.birdCount[species] = 0;
+        stats.clusterCount[species] = 0;
+        stats.largestCluster[species] = 0;
+        stats.isolated[species] = 0;
+        for(int bin=0; bin<FlockStats::kHistogramBins; bin++){
+            stats.nearestHistogram[species][bin] = 0;
+        }
+    }
+
+    std::vector<Bird*>* birds = flock->getBirds();
+    fClusterSize.assign(birds->size(), 0);
+    for(int i=0; i<birds->size(); i++){
+        Bird* b = birds->at(i);
+        int species = b->getSpecies();
+        if(species >= kOtherSpecies) continue;
+        stats.birdCount[species]++;
+
+        TwoVector velocity = b->getVelocity();
+        double speed = (double)velocity.mag();
+        if(speed > 0){
+            headingX[species] += (double)velocity.x()/speed;
+            headingY[species] += (double)velocity.y()/speed;
+        }
+
+        if(fNearest[i] < 0){
+            stats.isolated[species]++;
+        }
+        else{
+            nearestSum[species] += fNearest[i];
+            int bin = std::min((int)(fNearest[i]/fBinWidth), FlockStats::kHistogramBins-1);
+            stats.nearestHistogram[species][bin]++;
+        }
+
+        //each set only holds one species, so every Bird's root is of its own species
+        int root = find(i);
+        if(root == i) stats.clusterCount[species]++;
+        int size = ++fClusterSize[root];
+        stats.largestCluster[species] = std::max(stats.largestCluster[species], size);
+    }
+
+    for(int species=0; species<kOtherSpecies; species++){
+        int count = stats.birdCount[species];
+        int withNeighbour = count - stats.isolated[species];
+        stats.polarisation[species] = count > 0 ? std::sqrt(headingX[species]*headingX[species] +
+                                                            headingY[species]*headingY[species])/count : 0;
+        stats.meanNearestDistance[species] = withNeighbour > 0 ? nearestSum[species]/withNeighbour : 0;
+    }
+    fChannel.publish(stats);
+}
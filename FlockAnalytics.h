@@ -0,0 +1,104 @@
+/* FlockAnalytics.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for FlockAnalytics, which measures the flock while it is simulated, every K ticks,
+ * and publishes the results on a StatsChannel for another thread to read. For each species it
+ * works out:
+ *  - the polarisation (order parameter): the length of the mean heading, 1 when every Bird flies
+ *    the same way and near 0 when they fly every way
+ *  - the clusters: groups of Birds of the species joined by chains of Birds within each other's
+ *    detection distance
+ *  - a histogram of the distance from each Bird to its nearest neighbour
+ *
+ * No extra neighbour search is done. Flock hands each Bird's neighbours to observe() as it finds
+ * them for the Bird's update, and the clusters are built from those with a union-find that the
+ * update threads can all join sets in at once, using atomic compare and swap instead of locks.
+ * The clusters found don't depend on the order the Birds are observed in.
+ */
+#ifndef FLOCKANALYTICS_H
+#define FLOCKANALYTICS_H
+
+#include <vector>
+#include <atomic>
+#include "Bird.h"
+#include "StatsChannel.h"
+
+class Flock;
+
+//the measurements of one tick
+struct FlockStats
+{
+    //number of bins in each nearest neighbour histogram. The last bin holds everything beyond the others.
+    static const int kHistogramBins = 32;
+
+    long long tick;//tick the Birds were measured at, before they moved in it
+    int birdCount[kOtherSpecies];
+    double polarisation[kOtherSpecies];
+    int clusterCount[kOtherSpecies];
+    int largestCluster[kOtherSpecies];//number of Birds in the largest cluster
+    double meanNearestDistance[kOtherSpecies];//mean over the Birds that have a neighbour in range
+    int isolated[kOtherSpecies];//Birds with no other Bird within their neighbour range
+    double histogramBinWidth;
+    int nearestHistogram[kOtherSpecies][kHistogramBins];
+};
+
+class FlockAnalytics
+{
+public:
+
+    //Constructor. Measures every interval ticks, with nearest neighbour distances in bins of binWidth.
+    FlockAnalytics(int interval = 1, double binWidth = 2);
+
+    //Deconstructor
+    virtual ~FlockAnalytics();
+
+    //true if the flock should be measured in this tick
+    inline bool const isDue(long long tick)const{return fInterval > 0 && tick % fInterval == 0;}
+
+    //gets ready to observe birdCount Birds. Called by Flock before the Birds are updated.
+    void beginTick(int birdCount);
+
+    //records what a Bird's neighbours say about it. Called by Flock from any update thread.
+    void observe(int index, const Bird* b, double range, const std::vector<Bird*>* neighbours, const std::vector<int>* indices);
+
+    //works out the stats from the observations and publishes them. Called by Flock once every Bird is updated.
+    void finishTick(Flock* flock);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline StatsChannel<FlockStats>* getChannel(){return &fChannel;}
+    inline int const getInterval()const{return fInterval;}
+    inline double const getBinWidth()const{return fBinWidth;}
+
+    //Setters for data members
+    inline void setInterval(int newVal){fInterval = newVal;}
+    inline void setBinWidth(double newVal){fBinWidth = newVal;}
+
+private:
+
+    //root of the set a Bird is in, shortening the path to it on the way
+    int find(int index);
+
+    //joins the sets of two Birds. Safe to call from several threads at once.
+    void join(int a, int b);
+
+    int fInterval;
+    double fBinWidth;
+
+    //union-find of the Birds, by index. The root of each set is its lowest index.
+    std::atomic<int>* fParent;
+    int fCapacity;
+
+    //distance from each Bird to its nearest neighbour, or -1 if it has none in range
+    std::vector<double> fNearest;
+
+    //where the stats are published
+    StatsChannel<FlockStats> fChannel;
+
+    //reused by finishTick to count the size of each cluster
+    std::vector<int> fClusterSize;
+};
+
+#endif // FLOCKANALYTICS_H
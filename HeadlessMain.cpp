@@ -0,0 +1,292 @@
+/* HeadlessMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockHeadless, which runs a scenario file without any windows. Used for runs
+ * too large to watch, and for benchmarks. Usage:
+ *
+ *     BirdFlockHeadless scenario.toml [--ticks N] [--threads N] [--seed N]
+ *                       [--record out.bftr] [--save out.bfcp] [--restore in.bfcp] [--stats K]
+ *                       [--export name] [--serve [address:]port] [--tick-rate N]
+ *                       [--pin] [--huge-pages N]
+ *     BirdFlockHeadless scenario.toml scenario.toml ... [--ticks N] [--threads N] [--seed N]
+ *
+ * The options override the settings in the scenario files. --restore carries on from a checkpoint
+ * instead of starting the scenario from scratch, with the scenario's settings but none of its Birds
+ * or Obstacles. --stats prints the FlockAnalytics of every Kth tick. --export publishes every tick
+ * into the shared memory region name, for a SharedFlockReader in another program to follow. --serve
+ * streams every tick to browsers and other viewers (see StreamServer.h), on this machine only
+ * unless an address such as 0.0.0.0 is given, and --tick-rate slows the run down to at most N ticks
+ * a second so it can be watched. --pin and --huge-pages set pin_threads and huge_pages (see
+ * Scenario.h), for comparing runs on servers with more than one NUMA node. At the end, the time
+ * taken per tick is printed, and if the scenario has measure_placement on, how many Birds were
+ * updated on another node than their memory. Given several scenarios, they are all run at once on a
+ * SimulationHost, sharing the threads.
+ */
+#include "Flock.h"
+#include "Scenario.h"
+#include "Checkpoint.h"
+#include "TrajectoryRecorder.h"
+#include "SimulationHost.h"
+#include "FlockAnalytics.h"
+#include "SharedFlockWriter.h"
+#include "StreamServer.h"
+#include "Numa.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockHeadless scenario.toml [--ticks N] [--threads N] [--seed N]" << std::endl
+              << "                         [--record out.bftr] [--save out.bfcp] [--restore in.bfcp] [--stats K]" << std::endl
+              << "                         [--export name] [--serve [address:]port] [--tick-rate N]" << std::endl
+              << "                         [--pin] [--huge-pages N]" << std::endl
+              << "       BirdFlockHeadless scenario.toml scenario.toml ... [--ticks N] [--threads N] [--seed N]" << std::endl;
+}
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//prints one line for each species in the stats
+static void printStats(const FlockStats& stats){
+    const char* names[kOtherSpecies] = {"blue", "green", "red"};
+    for(int species=0; species<kOtherSpecies; species++){
+        if(stats.birdCount[species] == 0) continue;
+        std::cout << "tick " << stats.tick << " " << names[species] << ": polarisation " << stats.polarisation[species]
+                  << ", " << stats.clusterCount[species] << " clusters (largest " << stats.largestCluster[species]
+                  << "), nearest neighbour " << stats.meanNearestDistance[species] << ", "
+                  << stats.isolated[species] << " isolated" << std::endl;
+    }
+}
+
+/* runHosted
+ *
+ * Runs several scenarios at once on a SimulationHost, in rounds, until each has run its ticks.
+ *
+ * inputs:
+ * - paths: the scenario files
+ * - ticks: ticks to run each scenario for, or -1 to use the ticks in its file
+ * - threads: threads shared by all the scenarios, or -1 for one per core
+ * - seed: seed of the first scenario, or null to use the seeds in the files. Scenario i uses seed + i.
+ *
+ * return: the exit code of the program
+ */
+static int runHosted(const std::vector<std::string>& paths, long long ticks, int threads, const char* seed){
+    SimulationHost host(std::max(0, threads));
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int i=0; i<paths.size(); i++){
+        Scenario scenario;
+        if(!scenario.load(paths[i])){
+            std::cerr << scenario.getError() << std::endl;
+            return 1;
+        }
+        if(ticks >= 0) scenario.setTicks(ticks);
+        if(seed) scenario.setSeed(strtoull(seed, 0, 10) + i);
+        else if(!scenario.hasSeed()) scenario.setSeed(time(NULL) + i);
+
+        Flock* flock = new Flock();
+        scenario.apply(flock);
+        host.addSimulation(flock, scenario.getPriority(), scenario.getTicksPerRound(), scenario.getTicks());
+    }
+    std::cout << paths.size() << " scenarios on " << host.getThreadCount() << " threads, set up in "
+              << secondsSince(start)*1000 << " ms" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    long long ticksRun = 0;
+    while(!host.isFinished()){
+        ticksRun += host.runRound();
+    }
+    double runTime = secondsSince(start);
+
+    for(int i=0; i<host.getSimulations()->size(); i++){
+        HostedSimulation* simulation = host.getSimulations()->at(i);
+        std::cout << paths[i] << ": seed " << simulation->flock->getSeed() << ", " << simulation->ticksRun << " ticks, "
+                  << simulation->flock->getBlueCount() << " blue, " << simulation->flock->getGreenCount() << " green, "
+                  << simulation->flock->getPredCount() << " predators left" << std::endl;
+    }
+    std::cout << ticksRun << " ticks in " << host.getRound() << " rounds, " << runTime << " s ("
+              << (ticksRun > 0 ? runTime/ticksRun*1000 : 0) << " ms per tick)" << std::endl;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options. Anything that isn't an option is a scenario file.
+    std::vector<std::string> scenarioPaths;
+    long long ticks = -1;
+    int threads = -1;
+    int statsInterval = 0;
+    const char* seed = 0;
+    double tickRate = 0;
+    bool pin = false;
+    int hugePages = -1;
+    std::string recordPath, savePath, restorePath, exportName, serveAddress;
+    for(int i=1; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--ticks") == 0) ticks = atoll(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--threads") == 0) threads = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seed") == 0) seed = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--save") == 0) savePath = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--restore") == 0) restorePath = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--stats") == 0) statsInterval = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--export") == 0) exportName = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--serve") == 0) serveAddress = argv[++i];
+        else if(hasValue && strcmp(argv[i], "--tick-rate") == 0) tickRate = atof(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--huge-pages") == 0) hugePages = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--pin") == 0) pin = true;
+        else if(argv[i][0] != '-') scenarioPaths.push_back(argv[i]);
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+    if(scenarioPaths.empty()){
+        printUsage();
+        return 1;
+    }
+    if(scenarioPaths.size() > 1){
+        if(!recordPath.empty() || !savePath.empty() || !restorePath.empty() || statsInterval > 0 || !exportName.empty() ||
+           !serveAddress.empty() || tickRate > 0){
+            std::cerr << "--record, --save, --restore, --stats, --export, --serve and --tick-rate only work with one scenario" << std::endl;
+            return 1;
+        }
+        return runHosted(scenarioPaths, ticks, threads, seed);
+    }
+    std::string scenarioPath = scenarioPaths[0];
+
+    Scenario scenario;
+    if(!scenario.load(scenarioPath)){
+        std::cerr << scenario.getError() << std::endl;
+        return 1;
+    }
+    if(ticks >= 0) scenario.setTicks(ticks);
+    if(threads >= 0) scenario.setThreads(threads);
+    if(pin) scenario.setPinThreads(true);
+    if(hugePages >= 0) scenario.setHugePages(hugePages);
+    if(seed) scenario.setSeed(strtoull(seed, 0, 10));
+    else if(!scenario.hasSeed()) scenario.setSeed(time(NULL));
+
+    //set up the flock, either from the scenario or from a checkpoint
+    Flock flock;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(restorePath.empty()){
+        scenario.apply(&flock);
+    }
+    else{
+        Checkpoint checkpoint;
+        if(!checkpoint.read(restorePath)){
+            std::cerr << "can't read checkpoint " << restorePath << std::endl;
+            return 1;
+        }
+        flock.restoreCheckpoint(&checkpoint);
+        scenario.applySettings(&flock);
+        if(seed) flock.setSeed(scenario.getSeed());
+    }
+    double setupTime = secondsSince(start);
+
+    TrajectoryRecorder recorder;
+    if(!recordPath.empty()){
+        if(!recorder.open(recordPath, flock.getWorldWidth(), flock.getWorldHeight())){
+            std::cerr << "can't create " << recordPath << std::endl;
+            return 1;
+        }
+        flock.setRecorder(&recorder);
+    }
+
+    SharedFlockWriter exporter;
+    if(!exportName.empty()){
+        if(!exporter.open(exportName, flock.getBirds()->size())){
+            std::cerr << "can't create shared memory " << exportName << std::endl;
+            return 1;
+        }
+        flock.setExporter(&exporter);
+    }
+
+    //the address is optional, and only this machine can connect without one
+    StreamServer server;
+    if(!serveAddress.empty()){
+        size_t colon = serveAddress.rfind(':');
+        std::string address = colon == std::string::npos ? "127.0.0.1" : serveAddress.substr(0, colon);
+        int port = atoi(serveAddress.c_str() + (colon == std::string::npos ? 0 : colon + 1));
+        if(!server.start(address, port)){
+            std::cerr << "can't listen on " << serveAddress << std::endl;
+            return 1;
+        }
+        flock.setStreamServer(&server);
+        std::cout << "watch at http://" << (address == "0.0.0.0" ? "localhost" : address) << ":" << server.getPort() << "/" << std::endl;
+    }
+
+    std::cout << "scenario " << (scenario.getName().empty() ? scenarioPath : scenario.getName())
+              << ", seed " << flock.getSeed() << ", " << flock.getBirds()->size() << " birds, "
+              << flock.getObstacles()->size() << " obstacles, set up in " << setupTime*1000 << " ms" << std::endl;
+
+    FlockAnalytics analytics(statsInterval);
+    if(statsInterval > 0) flock.setAnalytics(&analytics);
+
+    start = std::chrono::steady_clock::now();
+    ticks = scenario.getTicks();
+    FlockStats stats;
+    for(long long t=0; t<ticks; t++){
+        flock.simulateFlock();
+        if(analytics.getChannel()->read(&stats)) printStats(stats);
+        if(tickRate > 0) std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                         std::chrono::duration<double>((t + 1)/tickRate)));
+    }
+    double runTime = secondsSince(start);
+
+    flock.setRecorder(0);
+    recorder.close();
+    flock.setExporter(0);
+    exporter.close();
+    flock.setStreamServer(0);
+    server.stop();
+
+    std::cout << ticks << " ticks in " << runTime << " s (" << (ticks > 0 ? runTime/ticks*1000 : 0) << " ms per tick), "
+              << flock.getBlueCount() << " blue, " << flock.getGreenCount() << " green, "
+              << flock.getPredCount() << " predators left" << std::endl;
+    std::cout << "birds put in Morton order " << flock.getReorderCount() << " times, " << flock.getScatter()*100
+              << "% scattered when last checked, " << flock.getIsolatedCount() << " birds isolated in the last tick ("
+              << flock.getCoastingCount() << " coasting)" << std::endl;
+    if(flock.getMeasurePlacement()){
+        const FlockCounters* counters = flock.getCounters();
+        std::cout << "threads " << (flock.getPinThreads() ? "pinned" : "not pinned") << ", "
+                  << (counters->placed > 0 ? 100.0*counters->remote/counters->placed : 0) << "% of the " << counters->placed
+                  << " birds placed in the last tick were updated from another NUMA node" << std::endl;
+    }
+    if(BirdArena::getHugePages() != kNoHugePages){
+        std::cout << BirdArena::getMappedBytes()/(1024*1024) << " MB of birds in huge page blocks, "
+                  << hugePageBytes()/(1024*1024) << " MB of the program in transparent huge pages" << std::endl;
+    }
+    if(!recordPath.empty()){
+        std::cout << "recorded " << recorder.getRecordedFrames() << " frames, dropped " << recorder.getDroppedFrames() << std::endl;
+    }
+    if(!serveAddress.empty()){
+        std::cout << "streamed " << server.getFramesSent() << " frames, skipped " << server.getFramesSkipped()
+                  << " for slow viewers" << std::endl;
+    }
+
+    if(!savePath.empty()){
+        Checkpoint checkpoint;
+        flock.saveCheckpoint(&checkpoint);
+        if(!checkpoint.write(savePath)){
+            std::cerr << "can't write checkpoint " << savePath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
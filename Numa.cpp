@@ -0,0 +1,228 @@
+/* Numa.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for the helpers that place threads and memory on NUMA nodes. The topology is read from
+ * /sys/devices/system/node, and pages are looked up with move_pages, which only reports where
+ * pages are when it isn't given anywhere to move them.
+ */
+#include "Numa.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define BIRDFLOCK_HAS_NUMA 1
+#endif
+
+//pages looked up or moved by each move_pages call
+static const int kPagesPerLookup = 4096;
+
+//the MPOL_MF_MOVE flag of move_pages, which only moves pages no other process shares
+static const int kMoveOwnPages = 1 << 1;
+
+/* parseCoreList
+ *
+ * Reads a list of cores as the kernel writes them, such as "0-3,8,10-11".
+ *
+ * inputs:
+ * - text: the list
+ *
+ * return: the cores, in the order given
+ */
+static std::vector<int> parseCoreList(const std::string& text){
+    std::vector<int> cores;
+    std::stringstream list(text);
+    std::string range;
+    while(std::getline(list, range, ',')){
+        if(range.empty() || range[0] < '0' || range[0] > '9') continue;
+        size_t dash = range.find('-');
+        int first = atoi(range.c_str());
+        int last = dash == std::string::npos ? first : atoi(range.c_str() + dash + 1);
+        for(int core=first; core<=last; core++) cores.push_back(core);
+    }
+    return cores;
+}
+
+std::vector<std::vector<int> > coresByNode(){
+    std::vector<std::vector<int> > nodes;
+#ifdef BIRDFLOCK_HAS_NUMA
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return nodes;
+
+    //nodes are numbered from 0, but some numbers may be missing
+    std::vector<bool> seen(CPU_SETSIZE, false);
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string onlineText;
+    std::getline(online, onlineText);
+    std::vector<int> nodeIds = parseCoreList(onlineText);
+    for(int n=0; n<nodeIds.size(); n++){
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(nodeIds[n]) + "/cpulist");
+        std::string text;
+        std::getline(file, text);
+        std::vector<int> cores;
+        std::vector<int> listed = parseCoreList(text);
+        for(int i=0; i<listed.size(); i++){
+            int core = listed[i];
+            if(core < CPU_SETSIZE && CPU_ISSET(core, &allowed) && !seen[core]){
+                cores.push_back(core);
+                seen[core] = true;
+            }
+        }
+        if(!cores.empty()) nodes.push_back(cores);
+    }
+
+    //without the node files, every allowed core is put in one node
+    if(nodes.empty()){
+        std::vector<int> cores;
+        for(int core=0; core<CPU_SETSIZE; core++){
+            if(CPU_ISSET(core, &allowed)) cores.push_back(core);
+        }
+        if(!cores.empty()) nodes.push_back(cores);
+    }
+#endif
+    return nodes;
+}
+
+bool pinThread(const std::vector<int>& cores){
+#ifdef BIRDFLOCK_HAS_NUMA
+    if(cores.empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(int i=0; i<cores.size(); i++){
+        if(cores[i] >= 0 && cores[i] < CPU_SETSIZE) CPU_SET(cores[i], &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<int> threadCores(){
+    std::vector<int> cores;
+#ifdef BIRDFLOCK_HAS_NUMA
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0) return cores;
+    for(int core=0; core<CPU_SETSIZE; core++){
+        if(CPU_ISSET(core, &set)) cores.push_back(core);
+    }
+#endif
+    return cores;
+}
+
+int currentNode(){
+#if defined(BIRDFLOCK_HAS_NUMA) && defined(SYS_getcpu)
+    unsigned core = 0, node = 0;
+    if(syscall(SYS_getcpu, &core, &node, 0) == 0) return node;
+#endif
+    return 0;
+}
+
+void nodesOfAddresses(const void* const* addresses, int count, int* nodes){
+    for(int i=0; i<count; i++) nodes[i] = -1;
+#if defined(BIRDFLOCK_HAS_NUMA) && defined(SYS_move_pages)
+    //with no nodes to move them to, move_pages sets the status of each page to the node it is on
+    std::vector<void*> pages(kPagesPerLookup);
+    uintptr_t pageMask = ~(uintptr_t)(sysconf(_SC_PAGESIZE) - 1);
+    for(int first=0; first<count; first+=kPagesPerLookup){
+        int n = std::min(kPagesPerLookup, count - first);
+        for(int i=0; i<n; i++){
+            pages[i] = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(addresses[first + i]) & pageMask);
+        }
+        if(syscall(SYS_move_pages, 0, (unsigned long)n, pages.data(), (const int*)0, nodes + first, 0) != 0){
+            for(int i=0; i<n; i++) nodes[first + i] = -1;
+        }
+        else{
+            for(int i=0; i<n; i++){
+                if(nodes[first + i] < 0) nodes[first + i] = -1;
+            }
+        }
+    }
+#endif
+}
+
+/* moveToNode
+ *
+ * Moves pages with move_pages, a batch at a time. Addresses next to each other are usually on the
+ * same page, so each page is only asked for once per run of them. Pages that can't be moved, or
+ * are already on the node, are left where they are.
+ *
+ * inputs:
+ * - addresses: addresses in the pages to move
+ * - count: number of addresses
+ * - node: node to move them to
+ */
+void moveToNode(const void* const* addresses, int count, int node){
+#if defined(BIRDFLOCK_HAS_NUMA) && defined(SYS_move_pages)
+    std::vector<void*> pages;
+    pages.reserve(std::min(count, kPagesPerLookup));
+    uintptr_t pageMask = ~(uintptr_t)(sysconf(_SC_PAGESIZE) - 1);
+    for(int i=0; i<=count; i++){
+        if(i < count){
+            void* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(addresses[i]) & pageMask);
+            if(pages.empty() || pages.back() != page) pages.push_back(page);
+        }
+        if(!pages.empty() && (i == count || pages.size() == kPagesPerLookup)){
+            std::vector<int> nodes(pages.size(), node), status(pages.size());
+            syscall(SYS_move_pages, 0, (unsigned long)pages.size(), pages.data(), nodes.data(), status.data(), kMoveOwnPages);
+            pages.clear();
+        }
+    }
+#endif
+}
+
+/* mapMemory
+ *
+ * Maps a little more than asked for, and unmaps the ends, so the memory starts on a huge page.
+ * Explicit huge pages are already aligned, but need the system to have reserved some.
+ */
+void* mapMemory(size_t size, int hugePages){
+#ifdef BIRDFLOCK_HAS_NUMA
+    size = (size + kHugePageSize - 1)/kHugePageSize*kHugePageSize;
+#ifdef MAP_HUGETLB
+    if(hugePages == kExplicitHugePages){
+        void* memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(memory != MAP_FAILED) return memory;
+    }
+#endif
+    size_t mapped = size + kHugePageSize;
+    void* memory = mmap(0, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED) return 0;
+    uintptr_t start = reinterpret_cast<uintptr_t>(memory);
+    uintptr_t aligned = (start + kHugePageSize - 1)/kHugePageSize*kHugePageSize;
+    if(aligned > start) munmap(memory, aligned - start);
+    if(start + mapped > aligned + size) munmap(reinterpret_cast<void*>(aligned + size), start + mapped - aligned - size);
+#ifdef MADV_HUGEPAGE
+    if(hugePages != kNoHugePages) madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(aligned);
+#else
+    return 0;
+#endif
+}
+
+void unmapMemory(void* memory, size_t size){
+#ifdef BIRDFLOCK_HAS_NUMA
+    size = (size + kHugePageSize - 1)/kHugePageSize*kHugePageSize;
+    munmap(memory, size);
+#endif
+}
+
+long long hugePageBytes(){
+    std::ifstream file("/proc/self/smaps_rollup");
+    std::string line;
+    while(std::getline(file, line)){
+        if(line.compare(0, 14, "AnonHugePages:") == 0) return atoll(line.c_str() + 14)*1024;
+    }
+    return -1;
+}
@@ -0,0 +1,58 @@
+/* Numa.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for helpers that place threads and memory on the NUMA nodes of a machine. A server
+ * with more than one socket has memory attached to each, and a core reaching the memory of another
+ * socket takes longer than reaching its own. Used by ThreadPool to pin its threads to cores, by
+ * BirdArena to map memory in huge pages, and by Flock to measure how many Birds are updated by a
+ * thread on another node than their memory. They use Linux system calls directly, so no NUMA library
+ * is needed. On other systems, or if the kernel doesn't say, the machine is taken to be one node and
+ * nothing is pinned.
+ */
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <vector>
+#include <cstddef>
+
+//ways of mapping memory: in normal pages, in transparent huge pages, or in huge pages reserved by the system
+enum HugePages{
+    kNoHugePages = 0,
+    kTransparentHugePages = 1,
+    kExplicitHugePages = 2
+};
+
+//size of a huge page, which memory is mapped in multiples of
+const size_t kHugePageSize = 2*1024*1024;
+
+//the cores this process may run on, grouped by NUMA node, in node order. One group if there is one node.
+std::vector<std::vector<int> > coresByNode();
+
+//pins the calling thread to the given cores, returning false if it couldn't be
+bool pinThread(const std::vector<int>& cores);
+
+//the cores the calling thread may run on now, or none if it isn't known
+std::vector<int> threadCores();
+
+//NUMA node of the core the calling thread is running on, or 0 if it isn't known
+int currentNode();
+
+//sets nodes[i] to the node of the page holding addresses[i], or to -1 if it isn't known
+void nodesOfAddresses(const void* const* addresses, int count, int* nodes);
+
+//moves the pages holding the given addresses to a node, as far as the kernel allows
+void moveToNode(const void* const* addresses, int count, int node);
+
+/* maps size bytes of zeroed memory, a multiple of kHugePageSize, aligned to kHugePageSize, in pages
+ * of the given HugePages. Explicit huge pages fall back to transparent ones if none are free.
+ * Returns 0 if no memory could be mapped. */
+void* mapMemory(size_t size, int hugePages);
+
+//unmaps memory from mapMemory
+void unmapMemory(void* memory, size_t size);
+
+//bytes of this process's memory in transparent huge pages, or -1 if it isn't known
+long long hugePageBytes();
+
+#endif // NUMA_H
@@ -0,0 +1,52 @@
+/* Parallel.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Small helper for splitting a loop over a range of indices between several threads.
+ * The range is cut into one contiguous chunk per thread, and each chunk is passed to the
+ * given function along with the index of the thread running it, so that callers can
+ * give each thread its own buffer and avoid locking.
+ */
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+//number of threads parallelFor will use at most. Always at least 1.
+inline int parallelThreadCount(){
+    unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 0 ? (int)threads : 1;
+}
+
+/* parallelFor
+ *
+ * Calls function(begin, end, thread) once for each chunk of the range [0, count). The calling
+ * thread runs the first chunk itself, and the method only returns once every chunk is finished.
+ *
+ * inputs:
+ * - count: number of indices in the range
+ * - function: callable taking (int begin, int end, int thread), with thread < parallelThreadCount()
+ */
+template<typename Function>
+void parallelFor(int count, Function function){
+
+    //never start more threads than there are indices to work on
+    int threadCount = std::max(1, std::min(parallelThreadCount(), count));
+    int chunk = (count + threadCount - 1)/threadCount;
+
+    std::vector<std::thread> threads;
+    for(int t=1; t<threadCount; t++){
+        int begin = std::min(count, t*chunk);
+        int end = std::min(count, begin + chunk);
+        threads.push_back(std::thread(function, begin, end, t));
+    }
+    function(0, std::min(count, chunk), 0);
+
+    for(int t=0; t<threads.size(); t++){
+        threads[t].join();
+    }
+}
+
+#endif // PARALLEL_H
@@ -1,49 +1,58 @@
-/* Predator.h
- * Author: Max Elliott 1434717
- * Created On: 2017-12-12
- *
- * Header for Predator objects. Used to represent each predator in the flocking simulation. Essentially a Bird,
- * but with different update method, and the behaviour of chasing other birds and eating them. They have a hunger
- * indicating how many birds they can eat. Predators will be removed once they eat this amount of birds. Inherits
- * from Bird.
- */
-#ifndef PREDATOR_H
-#define PREDATOR_H
-#include <TwoVector.h>
-#include <vector>
-#include "Bird.h"
-
-class Predator : public Bird{
-public:
-
-    //Constructor
-    Predator(TwoVector position, double maxSpeed, int heading, int separationDistance, int detectionDistance, int hunger);
-
-    //Desctructor
-    virtual ~Predator();
-
-    //new update method for Predators
-    void update(std::vector<Bird*>* flock, std::vector<Obstacle*>* obstacles, int xdim, int ydim);
-
-    //new behaviour for predators: chases after the nearest non-predator bird
-    TwoVector hunt(std::vector<Bird*>* flock);
-
-    //used to eat Birds
-    void eat(Bird* b);
-
-    //inline gettter and setter for new data member
-    inline int const getHunger()const{return fHunger;}
-    inline int setHunger(int newVal){fHunger= newVal;}
-
-    //checks whether the predator has eaten all the birds it can
-    inline bool isFull(){return getHunger()==0;};
-
-
-
-private:
-
-    int fHunger;//number of birds the predator can eat
-
-};
-
-#endif // PREDATOR_H
+/* Predator.h
+ * Author: Max Elliott 1434717
+ * Created On: 2017-12-12
+ *
+ * Header for Predator objects. Used to represent each predator in the flocking simulation. Essentially a Bird,
+ * but with different update method, and the behaviour of chasing other birds and eating them. They have a hunger
+ * indicating how many birds they can eat. Predators will be removed once they eat this amount of birds. Inherits
+ * from Bird.
+ */
+#ifndef PREDATOR_H
+#define PREDATOR_H
+#include <TwoVector.h>
+#include <vector>
+#include "Bird.h"
+
+class Predator : public Bird{
+public:
+
+    //Constructor
+    Predator(TwoVector position, Real maxSpeed, int heading, int separationDistance, int detectionDistance, int hunger);
+
+    //Desctructor
+    virtual ~Predator();
+
+    //new update method for Predators. far is ignored, as Predators don't flock.
+    void update(std::vector<Bird*>* flock, std::vector<Obstacle*>* obstacles, int xdim, int ydim, const NeighbourSums* far = 0,
+                int due = kEverySlowBehaviour);
+
+    //new behaviour for predators: chases after the nearest non-predator bird, and catches it if close enough
+    TwoVector hunt(std::vector<Bird*>* flock);
+
+    //used to eat Birds. Called by Flock for the Bird caught, once it has made sure no other Predator gets it.
+    void eat(Bird* b);
+
+    //inline gettter and setter for new data member
+    inline int const getHunger()const{return fHunger;}
+    inline void setHunger(int newVal){fHunger= newVal;}
+
+    //checks whether the predator has eaten all the birds it can
+    inline bool isFull(){return getHunger()==0;};
+
+    /* the Bird caught by the last call to hunt, and how far away it was, or 0 if none was close enough.
+     * Only valid until the end of the tick. */
+    inline Bird* getCatch()const{return fCatch;}
+    inline Real const getCatchDistance()const{return fCatchDistance;}
+
+private:
+
+    int fHunger;//number of birds the predator can eat
+    Bird* fCatch;//Bird caught in the last update, if any
+    Real fCatchDistance;//distance to fCatch
+
+    //a Bird closer than this to a Predator is caught
+    static const int kCatchDistance = 3;
+
+};
+
+#endif // PREDATOR_H
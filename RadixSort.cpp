@@ -0,0 +1,79 @@
+/* RadixSort.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for the parallel radix sort.
+ */
+#include "RadixSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+//number of values counted and placed as one block. Each block gets its own counts, so it can be placed without locking.
+static const int kBlockSize = 16384;
+
+//number of different values of one byte
+static const int kBuckets = 256;
+
+/* radixSortByKey
+ *
+ * Least significant digit radix sort. For each byte of the key, every block of values counts how
+ * many of its values have each value of the byte. The counts are then turned into a write position
+ * for each block and byte value, in order of byte value and then block, so when each block copies
+ * its values to their positions the values with the same byte keep their order. After the last
+ * pass the values are sorted by the whole key.
+ *
+ * inputs:
+ * - values: values to sort, with the key in the top 32 bits
+ * - buffer: scratch space, resized to fit
+ * - pool: threads to split each pass between
+ */
+void radixSortByKey(std::vector<uint64_t>* values, std::vector<uint64_t>* buffer, ThreadPool* pool){
+    int count = values->size();
+    int blocks = (count + kBlockSize - 1)/kBlockSize;
+    if(blocks == 0) return;
+    buffer->resize(count);
+
+    //bits that differ between any two keys. Bytes without any are already sorted.
+    uint32_t first = (uint32_t)(values->at(0) >> 32), differing = 0;
+    for(int i=1; i<count; i++){
+        differing |= (uint32_t)(values->at(i) >> 32) ^ first;
+    }
+
+    std::vector<int> positions((size_t)blocks*kBuckets);
+    for(int shift=32; shift<64; shift+=8){
+        if(((differing >> (shift - 32)) & 0xff) == 0) continue;
+        const uint64_t* in = values->data();
+        uint64_t* out = buffer->data();
+
+        //count each block. The pool may hand out several blocks at once, so they are split up again here.
+        pool->parallelFor(count, kBlockSize, [&](int begin, int end, int){
+            for(int block=begin/kBlockSize; block*kBlockSize < end; block++){
+                int* counts = &positions[(size_t)block*kBuckets];
+                std::fill(counts, counts + kBuckets, 0);
+                for(int i=block*kBlockSize; i<std::min(end, (block + 1)*kBlockSize); i++){
+                    counts[(in[i] >> shift) & 0xff]++;
+                }
+            }
+        });
+
+        //turn the counts into the position each block writes its first value with each byte to
+        int total = 0;
+        for(int bucket=0; bucket<kBuckets; bucket++){
+            for(int block=0; block<blocks; block++){
+                int n = positions[(size_t)block*kBuckets + bucket];
+                positions[(size_t)block*kBuckets + bucket] = total;
+                total += n;
+            }
+        }
+
+        pool->parallelFor(count, kBlockSize, [&](int begin, int end, int){
+            for(int block=begin/kBlockSize; block*kBlockSize < end; block++){
+                int* next = &positions[(size_t)block*kBuckets];
+                for(int i=block*kBlockSize; i<std::min(end, (block + 1)*kBlockSize); i++){
+                    out[next[(in[i] >> shift) & 0xff]++] = in[i];
+                }
+            }
+        });
+        values->swap(*buffer);
+    }
+}
@@ -0,0 +1,23 @@
+/* RadixSort.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for a parallel radix sort, used by Flock to put its Birds into Morton order. Each
+ * value being sorted is a 32 bit key in the top half and something to carry along with it, usually
+ * an index, in the bottom half. Only the keys are compared, and the sort is stable, so values with
+ * the same key keep their order and the result is the same for any number of threads.
+ */
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+#include <cstdint>
+
+class ThreadPool;
+
+/* Sorts values by their top 32 bits, one byte at a time from the lowest. Bytes that are the same in
+ * every key are skipped. buffer is used as scratch space, so it can be reused between sorts. The
+ * counting and placing of each pass are split between the threads of pool. */
+void radixSortByKey(std::vector<uint64_t>* values, std::vector<uint64_t>* buffer, ThreadPool* pool);
+
+#endif // RADIXSORT_H
@@ -0,0 +1,75 @@
+/* Random.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for Random, a counter based random number generator (Philox4x32-10, from Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3").
+ */
+#include "Random.h"
+
+//Constructor
+Random::Random(uint64_t seed, uint64_t stream, uint64_t counter) :
+    fSeed(seed), fStream(stream), fCounter(counter), fBlockCounter(~(uint64_t)0){}
+
+/* nextInt
+ *
+ * Every block of the stream holds four values, so a new block is only generated every
+ * fourth call.
+ *
+ * return: the next 32 random bits of the stream
+ */
+uint32_t Random::nextInt(){
+    uint64_t block = fCounter >> 2;
+    if(block != fBlockCounter){
+        uint32_t counter[4] = {(uint32_t)block, (uint32_t)(block >> 32), (uint32_t)fStream, (uint32_t)(fStream >> 32)};
+        uint32_t key[2] = {(uint32_t)fSeed, (uint32_t)(fSeed >> 32)};
+        philox(counter, key, fBlock);
+        fBlockCounter = block;
+    }
+    return fBlock[fCounter++ & 3];
+}
+
+//uniform double in [0, 1), using 53 random bits so every representable value can come up
+double Random::uniform(){
+    uint64_t high = nextInt() >> 5;
+    uint64_t low = nextInt() >> 6;
+    return (high*67108864. + low)*(1./9007199254740992.);
+}
+
+/* uniformInt
+ *
+ * Maps 32 random bits onto [0, n) with a multiply and shift, which is much faster than % and
+ * doesn't favour low numbers as much. The bias left is at most n/2^32, far too small to matter.
+ *
+ * inputs:
+ * - n: number of possible values
+ *
+ * return: random integer in [0, n)
+ */
+int Random::uniformInt(int n){
+    if(n <= 0) return 0;
+    return (int)(((uint64_t)nextInt()*(uint64_t)n) >> 32);
+}
+
+//the Philox4x32-10 block function
+void Random::philox(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]){
+    const uint32_t kMultiplier0 = 0xD2511F53, kMultiplier1 = 0xCD9E8D57;
+    const uint32_t kWeyl0 = 0x9E3779B9, kWeyl1 = 0xBB67AE85;
+
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for(int round=0; round<10; round++){
+        uint64_t product0 = (uint64_t)kMultiplier0*c0;
+        uint64_t product1 = (uint64_t)kMultiplier1*c2;
+        uint32_t next0 = (uint32_t)(product1 >> 32) ^ c1 ^ k0;
+        uint32_t next1 = (uint32_t)product1;
+        uint32_t next2 = (uint32_t)(product0 >> 32) ^ c3 ^ k1;
+        uint32_t next3 = (uint32_t)product0;
+        c0 = next0; c1 = next1; c2 = next2; c3 = next3;
+        k0 += kWeyl0;
+        k1 += kWeyl1;
+    }
+
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
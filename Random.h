@@ -0,0 +1,60 @@
+/* Random.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for Random, a counter based random number generator (Philox4x32-10). Instead of
+ * keeping a hidden state like rand(), every number is a function of a seed, a stream and a counter,
+ * so the same seed always gives the same numbers no matter which thread asks for them or in which
+ * order, and the whole state of a stream is the single counter. Each Flock has its own seed, with
+ * one stream for spawning and one stream for every Bird, so simulations never share random numbers
+ * with each other or with the rest of the program, and a run can be repeated exactly from its seed.
+ */
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+class Random
+{
+public:
+
+    //Constructor. Starts at counter, the number of values already taken from the stream.
+    Random(uint64_t seed = 0, uint64_t stream = 0, uint64_t counter = 0);
+
+    //next 32 random bits
+    uint32_t nextInt();
+
+    //uniform random double in [0, 1)
+    double uniform();
+
+    //uniform random double in [min, max)
+    inline double uniform(double min, double max){return min + (max-min)*uniform();}
+
+    //uniform random integer in [0, n). Returns 0 if n <= 0.
+    int uniformInt(int n);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline uint64_t const getSeed()const{return fSeed;}
+    inline uint64_t const getStream()const{return fStream;}
+    inline uint64_t const getCounter()const{return fCounter;}
+
+    //moves the stream to a counter, e.g. one saved in a checkpoint
+    inline void setCounter(uint64_t newVal){fCounter = newVal; fBlockCounter = ~(uint64_t)0;}
+
+    //the Philox4x32-10 block function: encrypts a 128 bit counter with a 64 bit key
+    static void philox(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+private:
+
+    uint64_t fSeed;
+    uint64_t fStream;
+    uint64_t fCounter;//number of 32 bit values taken so far
+
+    //the last block generated, which holds four 32 bit values, and the block number it is for
+    uint32_t fBlock[4];
+    uint64_t fBlockCounter;
+};
+
+#endif // RANDOM_H
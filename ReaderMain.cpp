@@ -0,0 +1,99 @@
+/* ReaderMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockReader, a small example of following a simulation through shared memory. Run
+ * BirdFlockHeadless with --export name (or anything else that publishes with a SharedFlockWriter),
+ * then, on the same machine:
+ *
+ *     BirdFlockReader name [--interval ms]
+ *
+ * Every interval (a second by default) the newest tick is read in place, without copying it, and
+ * the number of Birds of each species and where they are on average is printed. Stops once the
+ * writer closes the region.
+ */
+#include "SharedFlockReader.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockReader name [--interval ms]" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    int interval = 1000;
+    for(int i=2; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--interval") == 0) interval = atoi(argv[++i]);
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    //wait for the writer to create the region
+    SharedFlockReader reader;
+    while(!reader.open(argv[1])){
+        std::cerr << "waiting for " << argv[1] << std::endl;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    static const char* names[3] = {"blue", "green", "red"};
+    while(!reader.isClosed()){
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+
+        //read the arrays in place, and only keep the result if the writer didn't overwrite them meanwhile
+        int count[3];
+        double sumX[3], sumY[3];
+        long long tick = 0;
+        bool read = false;
+        for(int attempt=0; attempt<4 && !read; attempt++){
+            uint64_t sequence;
+            const SharedFlockSlot* slot = reader.beginRead(&sequence);
+            if(!slot) break;
+
+            for(int species=0; species<3; species++){
+                count[species] = 0;
+                sumX[species] = 0;
+                sumY[species] = 0;
+            }
+            SharedFlockConstArrays arrays = reader.getArrays(slot);
+            uint32_t birdCount = std::min(slot->birdCount, reader.getCapacity());
+            for(uint32_t i=0; i<birdCount; i++){
+                int species = arrays.species[i];
+                if(species > 2) continue;
+                count[species]++;
+                sumX[species] += arrays.x[i];
+                sumY[species] += arrays.y[i];
+            }
+            tick = slot->tick;
+            read = reader.endRead(slot, sequence);
+        }
+        if(!read) continue;
+
+        std::cout << "tick " << tick;
+        for(int species=0; species<3; species++){
+            if(count[species] == 0) continue;
+            std::cout << ", " << count[species] << " " << names[species] << " around ("
+                      << sumX[species]/count[species] << ", " << sumY[species]/count[species] << ")";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "writer closed. Read " << reader.getFramesRead() << " frames, skipped " << reader.getFramesSkipped()
+              << ", " << reader.getTornReads() << " reads overwritten" << std::endl;
+    return 0;
+}
@@ -0,0 +1,370 @@
+/* Scenario.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for Scenario, which reads a scenario file and uses it to fill a Flock.
+ */
+#include "Scenario.h"
+#include "Flock.h"
+#include "Obstacle.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+
+//removes spaces and tabs from both ends of a string
+static std::string trim(const std::string& text){
+    size_t begin = text.find_first_not_of(" \t\r");
+    if(begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+/* Constructor. The defaults are the same as the simulation MainWindow::reset starts: a 1200x800
+ * world with 50 blue and 50 green Birds, no Predators and no obstacles. */
+Scenario::Scenario() :
+    fName(""), fWorldWidth(1200), fWorldHeight(800), fHasSeed(false), fSeed(0), fThreads(0), fReorderInterval(Flock::kDefaultReorderInterval), fFarField(false), fSkipIsolated(true), fPinThreads(false), fHugePages(0), fMeasurePlacement(false),
+    fTicks(0), fPriority(0), fTicksPerRound(1),
+    fRandomObstacleCount(0), fRandomObstacleRadius(5), fLineNumber(0)
+{
+    SpeciesParams blue = {4, 30, 90, 1.5, 0.6, 1, 5, 0};
+    SpeciesParams green = {3, 20, 50, 1.5, 1, 1.1, 5, 0};
+    SpeciesParams red = {5, 50, 200, 0, 0, 0, 0, 5};
+    fSpecies[kBlue] = blue;
+    fSpecies[kGreen] = green;
+    fSpecies[kRed] = red;
+    fSpeciesCount[kBlue] = 50;
+    fSpeciesCount[kGreen] = 50;
+    fSpeciesCount[kRed] = 0;
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        fBehaviourIntervals[behaviour] = 1;
+    }
+}
+
+/* load
+ *
+ * Reads a scenario file one line at a time.
+ *
+ * inputs:
+ * - path: file to read
+ *
+ * return: true if the whole file was valid. If not, getError() says what was wrong and where.
+ */
+bool Scenario::load(std::string path){
+    *this = Scenario();
+
+    std::ifstream file(path.c_str());
+    if(!file){
+        fError = "can't open " + path;
+        return false;
+    }
+
+    std::string line;
+    while(std::getline(file, line)){
+        fLineNumber++;
+        if(!parseLine(line)){
+            std::ostringstream error;
+            error << path << ":" << fLineNumber << ": " << fError;
+            fError = error.str();
+            return false;
+        }
+    }
+    return true;
+}
+
+/* parseLine
+ *
+ * Handles one line: strips the comment, then reads it as a table heading or a key = value pair.
+ *
+ * inputs:
+ * - line: the line, without its newline
+ *
+ * return: true if the line was valid
+ */
+bool Scenario::parseLine(const std::string& line){
+
+    //cut off the comment, ignoring any # inside a string
+    bool inString = false;
+    size_t end = line.size();
+    for(size_t i=0; i<line.size(); i++){
+        if(line[i] == '"') inString = !inString;
+        else if(line[i] == '#' && !inString){
+            end = i;
+            break;
+        }
+    }
+    std::string text = trim(line.substr(0, end));
+    if(text.empty()) return true;
+
+    //[[obstacle]] starts a new fixed obstacle
+    if(text.compare(0, 2, "[[") == 0){
+        if(text.size() < 4 || text.compare(text.size()-2, 2, "]]") != 0){
+            fError = "expected ]] at the end of the heading";
+            return false;
+        }
+        fTable = trim(text.substr(2, text.size()-4));
+        if(fTable != "obstacle"){
+            fError = "unknown array of tables [[" + fTable + "]]";
+            return false;
+        }
+        fObstacleX.push_back(0);
+        fObstacleY.push_back(0);
+        fObstacleRadius.push_back(fRandomObstacleRadius);
+        return true;
+    }
+
+    //[table] changes which settings the keys below it set
+    if(text[0] == '['){
+        if(text[text.size()-1] != ']'){
+            fError = "expected ] at the end of the heading";
+            return false;
+        }
+        fTable = trim(text.substr(1, text.size()-2));
+        if(fTable != "world" && fTable != "obstacles" && fTable != "species.blue" &&
+           fTable != "species.green" && fTable != "species.red" && fTable != "sweep"){
+            fError = "unknown table [" + fTable + "]";
+            return false;
+        }
+        return true;
+    }
+
+    size_t equals = text.find('=');
+    if(equals == std::string::npos){
+        fError = "expected key = value";
+        return false;
+    }
+    std::string key = trim(text.substr(0, equals));
+    std::string value = trim(text.substr(equals + 1));
+    if(key.empty() || value.empty()){
+        fError = "expected key = value";
+        return false;
+    }
+
+    //the sweep table is only read by Sweep, so it is kept as text
+    if(fTable == "sweep"){
+        fSweepKeys.push_back(key);
+        fSweepValues.push_back(value);
+        fSweepLines.push_back(fLineNumber);
+        return true;
+    }
+    return setValue(key, value);
+}
+
+/* parseNumber
+ *
+ * Reads a TOML number (underscores between digits are allowed, e.g. 100_000) or boolean.
+ *
+ * inputs:
+ * - value: the text of the value
+ * - out: set to the number
+ *
+ * return: true if value is a number
+ */
+bool Scenario::parseNumber(const std::string& value, double* out){
+    if(value == "true" || value == "false"){
+        *out = (value == "true");
+        return true;
+    }
+
+    std::string digits;
+    for(size_t i=0; i<value.size(); i++){
+        if(value[i] != '_') digits += value[i];
+    }
+    char* end;
+    errno = 0;
+    *out = strtod(digits.c_str(), &end);
+    return !digits.empty() && *end == 0 && errno == 0;
+}
+
+/* setValue
+ *
+ * Sets the setting named by key in the current table.
+ *
+ * inputs:
+ * - key: name of the setting
+ * - value: text of the value
+ *
+ * return: true if the setting exists and the value is valid for it
+ */
+bool Scenario::setValue(const std::string& key, const std::string& value){
+
+    //the only string setting
+    if(fTable.empty() && key == "name"){
+        if(value.size() < 2 || value[0] != '"' || value[value.size()-1] != '"'){
+            fError = "expected a \"string\"";
+            return false;
+        }
+        fName = value.substr(1, value.size()-2);
+        return true;
+    }
+
+    //seeds are read as integers, as they may be too big to be stored exactly as a double
+    if(fTable.empty() && key == "seed"){
+        char* end;
+        errno = 0;
+        fSeed = strtoull(value.c_str(), &end, 10);
+        if(*end != 0 || errno != 0){
+            fError = "expected a whole number, not " + value;
+            return false;
+        }
+        fHasSeed = true;
+        return true;
+    }
+
+    double number;
+    if(!parseNumber(value, &number)){
+        fError = "expected a number, not " + value;
+        return false;
+    }
+    return setNumber(fTable, key, number);
+}
+
+/* setSetting
+ *
+ * Sets a number setting from its full name, e.g. "species.blue.cohesion_strength" or "ticks".
+ * Used by Sweep to change the scenario between runs.
+ *
+ * inputs:
+ * - name: table and key, separated by the last '.'
+ * - number: the new value
+ *
+ * return: true if the setting exists and the value is valid for it. If not, getError() says why.
+ */
+bool Scenario::setSetting(const std::string& name, double number){
+    size_t dot = name.rfind('.');
+    if(dot == std::string::npos) return setNumber("", name, number);
+    return setNumber(name.substr(0, dot), name.substr(dot + 1), number);
+}
+
+/* setNumber
+ *
+ * Sets a number setting.
+ *
+ * inputs:
+ * - table: table the setting is in, "" for the top of the file
+ * - key: name of the setting
+ * - number: the new value
+ *
+ * return: true if the setting exists and the value is valid for it
+ */
+bool Scenario::setNumber(const std::string& table, const std::string& key, double number){
+    if(number < 0){
+        fError = "settings can't be negative";
+        return false;
+    }
+
+    bool found = true;
+    if(table.empty()){
+        if(key == "threads") fThreads = number;
+        else if(key == "reorder_interval") fReorderInterval = number;
+        else if(key == "far_field") fFarField = number != 0;
+        else if(key == "skip_isolated") fSkipIsolated = number != 0;
+        else if(key == "cohesion_interval") fBehaviourIntervals[kCohesion] = std::max(1.0, number);
+        else if(key == "alignment_interval") fBehaviourIntervals[kAlignment] = std::max(1.0, number);
+        else if(key == "avoid_predator_interval") fBehaviourIntervals[kAvoidPredators] = std::max(1.0, number);
+        else if(key == "pin_threads") fPinThreads = number != 0;
+        else if(key == "huge_pages") fHugePages = std::min(2.0, number);
+        else if(key == "measure_placement") fMeasurePlacement = number != 0;
+        else if(key == "ticks") fTicks = number;
+        else if(key == "priority") fPriority = number;
+        else if(key == "ticks_per_round") fTicksPerRound = std::max(1.0, number);
+        else found = false;
+    }
+    else if(table == "world"){
+        if(key == "width") fWorldWidth = number;
+        else if(key == "height") fWorldHeight = number;
+        else found = false;
+
+        if(fWorldWidth < 1 || fWorldHeight < 1){
+            fError = "the world must be at least 1x1";
+            return false;
+        }
+    }
+    else if(table == "obstacles"){
+        if(key == "count") fRandomObstacleCount = number;
+        else if(key == "radius") fRandomObstacleRadius = number;
+        else found = false;
+    }
+    else if(table == "obstacle" && !fObstacleX.empty()){
+        if(key == "x") fObstacleX.back() = number;
+        else if(key == "y") fObstacleY.back() = number;
+        else if(key == "radius") fObstacleRadius.back() = number;
+        else found = false;
+    }
+    else if(table == "species.blue" || table == "species.green" || table == "species.red"){
+        int species = Bird::speciesFromColour(table.substr(8));
+        SpeciesParams& params = fSpecies[species];
+        if(key == "count") fSpeciesCount[species] = number;
+        else if(key == "max_speed") params.maxSpeed = number;
+        else if(key == "separation_distance") params.separationDistance = number;
+        else if(key == "detection_distance") params.detectionDistance = number;
+        else if(key == "separation_strength") params.separationStrength = number;
+        else if(key == "cohesion_strength") params.cohesionStrength = number;
+        else if(key == "alignment_strength") params.alignmentStrength = number;
+        else if(key == "avoid_predator_strength") params.avoidPredatorStrength = number;
+        else if(key == "hunger" && species == kRed) params.hunger = number;
+        else found = false;
+    }
+    else found = false;
+
+    if(!found){
+        fError = "unknown setting " + key + (table.empty() ? "" : " in [" + table + "]");
+        return false;
+    }
+    return true;
+}
+
+/* apply
+ *
+ * Empties the flock and fills it with the scenario. Obstacles go in first, so spawnBatch can
+ * keep the Birds out of them. Random obstacles are kept away from the walls in the same way as
+ * MainWindow adds them.
+ *
+ * inputs:
+ * - flock: Flock to fill
+ */
+void Scenario::apply(Flock* flock)const{
+    flock->clearFlock();
+    flock->setWorldSize(fWorldWidth, fWorldHeight);
+    applySettings(flock);
+    if(fHasSeed) flock->setSeed(fSeed);
+
+    std::vector<Obstacle*>* obstacles = flock->getObstacles();
+    obstacles->reserve(fObstacleX.size() + fRandomObstacleCount);
+    for(int i=0; i<fObstacleX.size(); i++){
+        flock->addObstacle(new Obstacle(TwoVector(fObstacleX[i], fObstacleY[i]), fObstacleRadius[i]));
+    }
+    for(int i=0; i<fRandomObstacleCount; i++){
+        double x = 0.1*fWorldWidth + flock->getRandom()->uniformInt(0.8*fWorldWidth);
+        double y = 0.1*fWorldHeight + flock->getRandom()->uniformInt(0.8*fWorldHeight);
+        flock->addObstacle(new Obstacle(TwoVector(x, y), fRandomObstacleRadius));
+    }
+    flock->setObstacleCount(obstacles->size());
+
+    for(int species=0; species<kOtherSpecies; species++){
+        flock->spawnBatch(species, fSpeciesCount[species], fSpecies[species]);
+    }
+    flock->rebuildGrids();
+}
+
+/* applySettings
+ *
+ * Sets everything about how the flock is simulated from the scenario, but not what is in it, so a
+ * flock restored from a checkpoint can be run with the scenario's settings.
+ *
+ * inputs:
+ * - flock: the Flock to set up
+ */
+void Scenario::applySettings(Flock* flock)const{
+    flock->setThreadCount(fThreads);
+    flock->setReorderInterval(fReorderInterval);
+    flock->setFarField(fFarField);
+    flock->setSkipIsolated(fSkipIsolated);
+    for(int behaviour=0; behaviour<kSlowBehaviours; behaviour++){
+        flock->setBehaviourInterval(behaviour, fBehaviourIntervals[behaviour]);
+    }
+    flock->setPinThreads(fPinThreads);
+    flock->setHugePages(fHugePages);
+    flock->setMeasurePlacement(fMeasurePlacement);
+}
@@ -0,0 +1,178 @@
+/* Scenario.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for Scenario, a description of a simulation to start from, read from a scenario
+ * file. Scenario files use a small subset of TOML: comments start with #, and each line is either
+ * a [table] heading, an [[obstacle]] heading, or a key = value pair where the value is a number,
+ * true/false, or a "string". For example:
+ *
+ *     name = "Large flock"    # shown in the title of the window
+ *     seed = 42               # optional, a random seed is used otherwise
+ *     threads = 0             # threads used to simulate, 0 for one per core
+ *     reorder_interval = 100  # ticks between checking whether to put the Birds back into Morton order in memory, 0 for never
+ *     far_field = false       # sum up far away neighbours cell by cell, for large detection distances
+ *     skip_isolated = true    # Birds with no other Bird near them don't look for neighbours, and coast if nothing else is near
+ *     cohesion_interval = 1   # ticks between each Bird working out cohesion, and the same for
+ *     alignment_interval = 1  # alignment and avoiding predators, reusing the last force between
+ *     avoid_predator_interval = 1
+ *     pin_threads = false     # pin threads to cores, each updating its own patch of the world
+ *     huge_pages = 0          # Birds in normal pages, 1 for transparent huge pages, 2 for reserved ones
+ *     measure_placement = false # count Birds updated on another NUMA node than their memory
+ *     ticks = 1000            # number of ticks BirdFlockHeadless runs for
+ *     priority = 0            # when BirdFlockHeadless runs several scenarios at once, higher
+ *     ticks_per_round = 1     # priorities start first, and each runs this many ticks at a time
+ *
+ *     [world]
+ *     width = 4000
+ *     height = 3000
+ *
+ *     [species.blue]          # also species.green and species.red (predators)
+ *     count = 20000
+ *     max_speed = 4
+ *     separation_distance = 30
+ *     detection_distance = 90
+ *     separation_strength = 1.5
+ *     cohesion_strength = 0.6
+ *     alignment_strength = 1
+ *     avoid_predator_strength = 5
+ *     hunger = 5              # predators only
+ *
+ *     [obstacles]             # obstacles at random positions
+ *     count = 10
+ *     radius = 5
+ *
+ *     [[obstacle]]            # one obstacle at a fixed position, can be repeated
+ *     x = 600
+ *     y = 400
+ *     radius = 30
+ *
+ *     [sweep]                 # only used by BirdFlockSweep, see Sweep.h
+ *
+ * Every key is optional; anything left out keeps the same value MainWindow::reset uses. The file
+ * is read one line at a time, so files listing a very large number of obstacles never need to be
+ * held in memory as text. apply() then fills a Flock in bulk, using spawnBatch for the Birds.
+ */
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Bird.h"
+
+class Flock;
+
+class Scenario
+{
+public:
+
+    //Constructor. Sets every setting to its default.
+    Scenario();
+
+    //reads a scenario file. Returns false, and sets the error message, if it can't be read.
+    bool load(std::string path);
+
+    //empties the flock and fills it with the scenario
+    void apply(Flock* flock)const;
+
+    //sets how the flock is simulated (threads, reordering, far field and so on), without touching its Birds, Obstacles, world or seed
+    void applySettings(Flock* flock)const;
+
+    //sets a number setting from its full name, e.g. "species.blue.cohesion_strength". Returns false if there is no such setting.
+    bool setSetting(const std::string& name, double number);
+
+    //reads a number or true/false, as written in a scenario file. Returns false if value isn't one.
+    static bool parseNumber(const std::string& value, double* out);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline std::string const getError()const{return fError;}
+    inline std::string const getName()const{return fName;}
+    inline int const getWorldWidth()const{return fWorldWidth;}
+    inline int const getWorldHeight()const{return fWorldHeight;}
+    inline bool const hasSeed()const{return fHasSeed;}
+    inline uint64_t const getSeed()const{return fSeed;}
+    inline int const getThreads()const{return fThreads;}
+    inline int const getReorderInterval()const{return fReorderInterval;}
+    inline bool const getFarField()const{return fFarField;}
+    inline bool const getSkipIsolated()const{return fSkipIsolated;}
+    inline int const getBehaviourInterval(int behaviour)const{return fBehaviourIntervals[behaviour];}
+    inline bool const getPinThreads()const{return fPinThreads;}
+    inline int const getHugePages()const{return fHugePages;}
+    inline bool const getMeasurePlacement()const{return fMeasurePlacement;}
+    inline long long const getTicks()const{return fTicks;}
+    inline int const getPriority()const{return fPriority;}
+    inline int const getTicksPerRound()const{return fTicksPerRound;}
+    inline const SpeciesParams* getSpeciesParams(int species)const{return &fSpecies[species];}
+    inline int const getSpeciesCount(int species)const{return fSpeciesCount[species];}
+    inline int const getObstacleCount()const{return fRandomObstacleCount;}
+    inline int const getObstacleRadius()const{return fRandomObstacleRadius;}
+
+    //the keys and values of the [sweep] table, as text, and the line each was on
+    inline const std::vector<std::string>* getSweepKeys()const{return &fSweepKeys;}
+    inline const std::vector<std::string>* getSweepValues()const{return &fSweepValues;}
+    inline const std::vector<int>* getSweepLines()const{return &fSweepLines;}
+
+    //setters for the settings that can also be given on the command line
+    inline void setSeed(uint64_t newVal){fSeed = newVal; fHasSeed = true;}
+    inline void setThreads(int newVal){fThreads = newVal;}
+    inline void setPinThreads(bool newVal){fPinThreads = newVal;}
+    inline void setHugePages(int newVal){fHugePages = newVal;}
+    inline void setTicks(long long newVal){fTicks = newVal;}
+
+private:
+
+    //handles one line of the file. Returns false if it isn't valid.
+    bool parseLine(const std::string& line);
+
+    //sets the setting named by the current table and key. Returns false if there is no such setting.
+    bool setValue(const std::string& key, const std::string& value);
+
+    //sets a number setting in a table. Returns false if there is no such setting.
+    bool setNumber(const std::string& table, const std::string& key, double number);
+
+    //the settings from the file
+    std::string fName;
+    int fWorldWidth;
+    int fWorldHeight;
+    bool fHasSeed;
+    uint64_t fSeed;
+    int fThreads;
+    int fReorderInterval;
+    bool fFarField;
+    bool fSkipIsolated;
+    int fBehaviourIntervals[kSlowBehaviours];
+    bool fPinThreads;
+    int fHugePages;
+    bool fMeasurePlacement;
+    long long fTicks;
+    int fPriority;
+    int fTicksPerRound;
+
+    //settings and number of Birds of each species, indexed by Species id
+    SpeciesParams fSpecies[kOtherSpecies];
+    int fSpeciesCount[kOtherSpecies];
+
+    //obstacles at random positions
+    int fRandomObstacleCount;
+    int fRandomObstacleRadius;
+
+    //obstacles at fixed positions
+    std::vector<double> fObstacleX;
+    std::vector<double> fObstacleY;
+    std::vector<int> fObstacleRadius;
+
+    //the [sweep] table, left as text for Sweep
+    std::vector<std::string> fSweepKeys;
+    std::vector<std::string> fSweepValues;
+    std::vector<int> fSweepLines;
+
+    //parser state: the current table heading, and the line being read
+    std::string fTable;
+    int fLineNumber;
+    std::string fError;
+};
+
+#endif // SCENARIO_H
@@ -0,0 +1,118 @@
+/* SharedFlock.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Layout of the shared memory region that SharedFlockWriter publishes the live flock into, and
+ * SharedFlockReader reads it from, so other programs on the same machine can follow a simulation
+ * as it runs. The region is a POSIX shared memory object (shm_open), made of a header followed by a
+ * ring of slots. Each slot holds one tick, stored as separate arrays (x, y, vx, vy, id, species)
+ * so a reader can take just the arrays it needs.
+ *
+ * Each slot is guarded by a sequence lock: its sequence is odd while the writer is filling it and
+ * even once it is complete. A reader notes the sequence, reads the slot in place, and then checks
+ * the sequence hasn't changed; if it has, the writer overwrote the slot during the read and the
+ * read is tried again. The writer never waits for readers, and readers only ever map the region
+ * read only. With several slots a reader has several ticks' time to finish reading a slot before
+ * the writer comes back round to it.
+ *
+ * Everything in the region is in the byte order of the machine, as it never leaves it.
+ */
+#ifndef SHAREDFLOCK_H
+#define SHAREDFLOCK_H
+
+#include <cstdint>
+#include <atomic>
+
+//written into the header, so readers can check they have opened the right kind of region
+static const char kSharedFlockMagic[4] = {'B', 'F', 'S', 'M'};
+static const uint32_t kSharedFlockVersion = 1;
+
+//values of SharedFlockHeader::state
+enum SharedFlockState{
+    kSharedFlockLive = 0,//the writer is publishing into this region
+    kSharedFlockReplaced = 1,//the writer needed more space and moved to a new region with the same name
+    kSharedFlockClosed = 2//the writer has finished
+};
+
+//start of the region. Padded to 64 bytes so the slots start on a cache line.
+struct SharedFlockHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t slotCount;//number of slots in the ring
+    uint32_t capacity;//most Birds a slot can hold
+    uint64_t slotBytes;//size of each slot, including its SharedFlockSlot
+    std::atomic<uint64_t> frameCount;//number of complete frames published. Frame n is in slot n % slotCount.
+    std::atomic<uint32_t> state;//a SharedFlockState
+    uint32_t reserved[7];
+};
+
+/* Start of each slot. It is followed by the arrays, each capacity long:
+ * float x, y, vx, vy; int32_t id; uint8_t species. */
+struct SharedFlockSlot
+{
+    std::atomic<uint64_t> sequence;//2*frame+1 while frame is being written, 2*frame+2 once it is complete
+    int64_t tick;
+    uint32_t birdCount;
+    int32_t worldWidth;
+    int32_t worldHeight;
+    uint32_t reserved[9];
+};
+
+static_assert(sizeof(SharedFlockHeader) == 64, "SharedFlockHeader must be 64 bytes");
+static_assert(sizeof(SharedFlockSlot) == 64, "SharedFlockSlot must be 64 bytes");
+
+//pointers to the arrays of a slot, for writing and for reading
+struct SharedFlockArrays
+{
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    int32_t* id;
+    uint8_t* species;
+};
+struct SharedFlockConstArrays
+{
+    const float* x;
+    const float* y;
+    const float* vx;
+    const float* vy;
+    const int32_t* id;
+    const uint8_t* species;
+};
+
+//size in bytes of a slot holding up to capacity Birds, rounded up to a whole number of cache lines
+inline uint64_t sharedFlockSlotBytes(uint32_t capacity){
+    uint64_t bytes = sizeof(SharedFlockSlot) + (uint64_t)capacity*(4*sizeof(float) + sizeof(int32_t) + sizeof(uint8_t));
+    return (bytes + 63) & ~(uint64_t)63;
+}
+
+//size in bytes of a whole region
+inline uint64_t sharedFlockRegionBytes(uint32_t capacity, uint32_t slotCount){
+    return sizeof(SharedFlockHeader) + (uint64_t)slotCount*sharedFlockSlotBytes(capacity);
+}
+
+//the arrays that follow a slot
+inline SharedFlockArrays sharedFlockArrays(SharedFlockSlot* slot, uint32_t capacity){
+    SharedFlockArrays arrays;
+    arrays.x = reinterpret_cast<float*>(slot + 1);
+    arrays.y = arrays.x + capacity;
+    arrays.vx = arrays.y + capacity;
+    arrays.vy = arrays.vx + capacity;
+    arrays.id = reinterpret_cast<int32_t*>(arrays.vy + capacity);
+    arrays.species = reinterpret_cast<uint8_t*>(arrays.id + capacity);
+    return arrays;
+}
+inline SharedFlockConstArrays sharedFlockArrays(const SharedFlockSlot* slot, uint32_t capacity){
+    SharedFlockConstArrays arrays;
+    arrays.x = reinterpret_cast<const float*>(slot + 1);
+    arrays.y = arrays.x + capacity;
+    arrays.vx = arrays.y + capacity;
+    arrays.vy = arrays.vx + capacity;
+    arrays.id = reinterpret_cast<const int32_t*>(arrays.vy + capacity);
+    arrays.species = reinterpret_cast<const uint8_t*>(arrays.id + capacity);
+    return arrays;
+}
+
+#endif // SHAREDFLOCK_H
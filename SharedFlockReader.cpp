@@ -0,0 +1,201 @@
+/* SharedFlockReader.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SharedFlockReader, which reads a Flock published into shared memory.
+ */
+#include "SharedFlockReader.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define BIRDFLOCK_HAS_SHM 1
+#endif
+
+//most times readLatest tries again after the writer overwrote the slot it was reading
+static const int kMaxReadAttempts = 16;
+
+//Constructor
+SharedFlockReader::SharedFlockReader() :
+    fHeader(0), fBytes(0), fSeen(0), fFramesRead(0), fFramesSkipped(0), fTornReads(0)
+{
+}
+
+//Deconstructor
+SharedFlockReader::~SharedFlockReader(){
+    close();
+}
+
+/* open
+ *
+ * Maps a region published by a SharedFlockWriter.
+ *
+ * inputs:
+ * - name: name of the region. POSIX names start with '/', which is added if it is missing.
+ *
+ * return: true if the region was mapped
+ */
+bool SharedFlockReader::open(std::string name){
+    close();
+    fName = (name.empty() || name[0] != '/') ? "/" + name : name;
+    fSeen = 0;
+    fFramesRead = 0;
+    fFramesSkipped = 0;
+    fTornReads = 0;
+    if(!map()){
+        fName.clear();
+        return false;
+    }
+    //start from the newest frame rather than counting everything before it as skipped
+    uint64_t frames = fHeader->frameCount.load(std::memory_order_acquire);
+    fSeen = frames > 0 ? frames - 1 : 0;
+    return true;
+}
+
+//unmaps the region and forgets its name
+void SharedFlockReader::close(){
+    unmap();
+    fName.clear();
+}
+
+/* map
+ *
+ * Opens fName read only and maps it, checking that its header is one written by a
+ * SharedFlockWriter and that the object is as big as the header says.
+ *
+ * return: true if the region was mapped
+ */
+bool SharedFlockReader::map(){
+#ifdef BIRDFLOCK_HAS_SHM
+    int file = shm_open(fName.c_str(), O_RDONLY, 0);
+    if(file < 0) return false;
+    struct stat info;
+    if(fstat(file, &info) != 0 || info.st_size < (off_t)sizeof(SharedFlockHeader)){
+        ::close(file);
+        return false;
+    }
+    size_t bytes = info.st_size;
+    void* memory = mmap(0, bytes, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if(memory == MAP_FAILED) return false;
+
+    //the writer may not have filled in the header yet, in which case the caller tries again later
+    const SharedFlockHeader* header = static_cast<const SharedFlockHeader*>(memory);
+    if(memcmp(header->magic, kSharedFlockMagic, 4) != 0 || header->version != kSharedFlockVersion ||
+       header->slotCount == 0 || header->slotBytes != sharedFlockSlotBytes(header->capacity) ||
+       bytes < sharedFlockRegionBytes(header->capacity, header->slotCount)){
+        munmap(memory, bytes);
+        return false;
+    }
+    fHeader = header;
+    fBytes = bytes;
+    return true;
+#else
+    return false;
+#endif
+}
+
+//unmaps the region, but keeps its name so it can be mapped again
+void SharedFlockReader::unmap(){
+#ifdef BIRDFLOCK_HAS_SHM
+    if(fHeader) munmap(const_cast<SharedFlockHeader*>(fHeader), fBytes);
+#endif
+    fHeader = 0;
+    fBytes = 0;
+}
+
+/* beginRead
+ *
+ * Finds the newest complete frame. If the writer has moved to a new region, it is mapped first;
+ * if the new region isn't ready yet, there is no frame this time.
+ *
+ * inputs:
+ * - sequence: set to the sequence of the slot, to be passed to endRead
+ *
+ * return: the slot holding the newest frame, or 0 if there is no frame that hasn't been read
+ */
+const SharedFlockSlot* SharedFlockReader::beginRead(uint64_t* sequence){
+    if(fHeader && fHeader->state.load(std::memory_order_acquire) == kSharedFlockReplaced){
+        unmap();
+    }
+    if(!fHeader && (fName.empty() || !map())) return 0;
+
+    uint64_t frames = fHeader->frameCount.load(std::memory_order_acquire);
+    if(frames <= fSeen) return 0;
+
+    //if the writer has already started on this slot again, the frame is gone; endRead will say so
+    uint64_t frame = frames - 1;
+    const SharedFlockSlot* slot = slotAt(frame % fHeader->slotCount);
+    *sequence = slot->sequence.load(std::memory_order_acquire);
+    return slot;
+}
+
+/* endRead
+ *
+ * Checks that the slot wasn't changed while it was being read.
+ *
+ * inputs:
+ * - slot: the slot returned by beginRead
+ * - sequence: the sequence set by beginRead
+ *
+ * return: true if what was read is a whole frame, which is then counted as read
+ */
+bool SharedFlockReader::endRead(const SharedFlockSlot* slot, uint64_t sequence){
+    //keeps the reads of the slot before the sequence is loaded again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(sequence % 2 != 0 || slot->sequence.load(std::memory_order_relaxed) != sequence){
+        fTornReads++;
+        return false;
+    }
+
+    //an even sequence of 2*frame+2 means the slot holds frame
+    uint64_t frame = sequence/2 - 1;
+    if(frame < fSeen) return false;
+    fFramesSkipped += frame - fSeen;
+    fFramesRead++;
+    fSeen = frame + 1;
+    return true;
+}
+
+/* readLatest
+ *
+ * Copies the newest frame out of the region, trying again if the writer overwrites it during the
+ * copy.
+ *
+ * inputs:
+ * - frame: set to the newest frame
+ *
+ * return: true if there was a frame that hasn't been read
+ */
+bool SharedFlockReader::readLatest(SharedFlockFrame* frame){
+    for(int attempt=0; attempt<kMaxReadAttempts; attempt++){
+        uint64_t sequence;
+        const SharedFlockSlot* slot = beginRead(&sequence);
+        if(!slot) return false;
+
+        //the count is checked against the capacity, as the writer may be halfway through changing it
+        uint32_t count = std::min(slot->birdCount, fHeader->capacity);
+        SharedFlockConstArrays arrays = getArrays(slot);
+        frame->tick = slot->tick;
+        frame->worldWidth = slot->worldWidth;
+        frame->worldHeight = slot->worldHeight;
+        frame->x.assign(arrays.x, arrays.x + count);
+        frame->y.assign(arrays.y, arrays.y + count);
+        frame->vx.assign(arrays.vx, arrays.vx + count);
+        frame->vy.assign(arrays.vy, arrays.vy + count);
+        frame->id.assign(arrays.id, arrays.id + count);
+        frame->species.assign(arrays.species, arrays.species + count);
+
+        if(endRead(slot, sequence)) return true;
+    }
+    return false;
+}
+
+//true once the writer has closed the region
+bool SharedFlockReader::isClosed(){
+    return fHeader && fHeader->state.load(std::memory_order_acquire) == kSharedFlockClosed;
+}
@@ -0,0 +1,110 @@
+/* SharedFlockReader.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SharedFlockReader, which follows a simulation that a SharedFlockWriter is
+ * publishing into shared memory (see SharedFlock.h). The region is mapped read only, so a reader
+ * can't change or slow down the simulation; it takes the newest complete frame whenever it is
+ * ready for one, and any frames published in between are skipped.
+ *
+ * Frames can be read in place with beginRead() and endRead(), which copies nothing, or copied out
+ * with readLatest(). If the writer moves to a bigger region the reader opens it again by itself.
+ *
+ * Only available on POSIX systems; elsewhere open() always fails.
+ */
+#ifndef SHAREDFLOCKREADER_H
+#define SHAREDFLOCKREADER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "SharedFlock.h"
+
+//one frame copied out of the region by SharedFlockReader::readLatest
+struct SharedFlockFrame
+{
+    long long tick;
+    int worldWidth;
+    int worldHeight;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<int32_t> id;
+    std::vector<uint8_t> species;
+};
+
+class SharedFlockReader
+{
+public:
+
+    //Constructor
+    SharedFlockReader();
+
+    //Deconstructor
+    virtual ~SharedFlockReader();
+
+    /* Maps the region called name (e.g. "/birdflock") read only. Returns false if there is no such
+     * region, or it isn't one written by a SharedFlockWriter. */
+    bool open(std::string name);
+
+    //unmaps the region
+    void close();
+
+    /* Zero copy reading. beginRead returns the slot of the newest frame not yet read, or 0 if there
+     * isn't one, and sets sequence. Its arrays can then be read in place with getArrays(); endRead
+     * must be called afterwards, and if it returns false the writer changed the slot during the read
+     * and whatever was read must be thrown away. Until then any field of the slot may be half
+     * written, so its birdCount must be checked against getCapacity() before it is used. */
+    const SharedFlockSlot* beginRead(uint64_t* sequence);
+    bool endRead(const SharedFlockSlot* slot, uint64_t sequence);
+
+    //copies the newest frame not yet read into frame. Returns false if there isn't one.
+    bool readLatest(SharedFlockFrame* frame);
+
+    //true once the writer has closed the region
+    bool isClosed();
+
+    //the arrays of a slot returned by beginRead
+    inline SharedFlockConstArrays getArrays(const SharedFlockSlot* slot)const{return sharedFlockArrays(slot, fHeader->capacity);}
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline bool const isOpen()const{return fHeader != 0;}
+    inline std::string const getName()const{return fName;}
+    inline uint64_t const getFramesRead()const{return fFramesRead;}
+    inline uint64_t const getFramesSkipped()const{return fFramesSkipped;}
+    inline uint64_t const getTornReads()const{return fTornReads;}
+    inline uint32_t const getCapacity()const{return fHeader ? fHeader->capacity : 0;}
+
+private:
+
+    //maps fName, and checks it is a region written by a SharedFlockWriter
+    bool map();
+
+    //unmaps the region
+    void unmap();
+
+    //slot number slot of the ring
+    inline const SharedFlockSlot* slotAt(uint64_t slot)const{
+        return reinterpret_cast<const SharedFlockSlot*>(reinterpret_cast<const char*>(fHeader + 1) + slot*fHeader->slotBytes);
+    }
+
+    std::string fName;
+
+    //the mapped region
+    const SharedFlockHeader* fHeader;
+    size_t fBytes;
+
+    //number of frames published when the last frame was read, so the same frame isn't read twice
+    uint64_t fSeen;
+
+    //counts of frames read, frames the writer published that were never read, and reads that were
+    //overwritten while they were happening
+    uint64_t fFramesRead;
+    uint64_t fFramesSkipped;
+    uint64_t fTornReads;
+};
+
+#endif // SHAREDFLOCKREADER_H
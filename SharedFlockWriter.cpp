@@ -0,0 +1,169 @@
+/* SharedFlockWriter.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SharedFlockWriter, which publishes a Flock into shared memory every tick.
+ */
+#include "SharedFlockWriter.h"
+#include "Flock.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define BIRDFLOCK_HAS_SHM 1
+#endif
+
+//Constructor
+SharedFlockWriter::SharedFlockWriter() :
+    fHeader(0), fBytes(0), fFrame(0)
+{
+}
+
+//Deconstructor
+SharedFlockWriter::~SharedFlockWriter(){
+    close();
+}
+
+/* open
+ *
+ * Creates the shared memory region, replacing any left behind by a writer that didn't close.
+ *
+ * inputs:
+ * - name: name of the region. POSIX names start with '/', which is added if it is missing.
+ * - capacity: most Birds each slot can hold at first
+ * - slotCount: number of ticks kept in the ring
+ *
+ * return: true if the region was created
+ */
+bool SharedFlockWriter::open(std::string name, int capacity, int slotCount){
+    close();
+    fName = (name.empty() || name[0] != '/') ? "/" + name : name;
+    fFrame = 0;
+    return create(std::max(1, capacity), std::max(2, slotCount));
+}
+
+//marks the region closed, so readers know no more frames are coming, and removes it
+void SharedFlockWriter::close(){
+    unmap(kSharedFlockClosed);
+}
+
+/* create
+ *
+ * Creates a region under fName, maps it, and writes its header. Readers that still have an old
+ * region with the same name mapped keep it until they open the name again.
+ *
+ * inputs:
+ * - capacity: most Birds each slot can hold
+ * - slotCount: number of slots
+ *
+ * return: true if the region was created
+ */
+bool SharedFlockWriter::create(uint32_t capacity, uint32_t slotCount){
+#ifdef BIRDFLOCK_HAS_SHM
+    size_t bytes = sharedFlockRegionBytes(capacity, slotCount);
+
+    //a new object is always made, so a reader never sees the size of a mapped object change
+    shm_unlink(fName.c_str());
+    int file = shm_open(fName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(file < 0) return false;
+    if(ftruncate(file, bytes) != 0){
+        ::close(file);
+        shm_unlink(fName.c_str());
+        return false;
+    }
+    void* memory = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    ::close(file);
+    if(memory == MAP_FAILED){
+        shm_unlink(fName.c_str());
+        return false;
+    }
+
+    //the new object is all zeros, so every slot starts with sequence 0: empty, and complete
+    fHeader = static_cast<SharedFlockHeader*>(memory);
+    fBytes = bytes;
+    memcpy(fHeader->magic, kSharedFlockMagic, 4);
+    fHeader->version = kSharedFlockVersion;
+    fHeader->slotCount = slotCount;
+    fHeader->capacity = capacity;
+    fHeader->slotBytes = sharedFlockSlotBytes(capacity);
+    fHeader->frameCount.store(fFrame, std::memory_order_relaxed);
+    fHeader->state.store(kSharedFlockLive, std::memory_order_release);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* unmap
+ *
+ * Tells readers why the region is going away, then unmaps it. The name is only removed when the
+ * writer is closing; when it is replaced, create() takes the name over straight away.
+ *
+ * inputs:
+ * - state: kSharedFlockReplaced or kSharedFlockClosed
+ */
+void SharedFlockWriter::unmap(SharedFlockState state){
+#ifdef BIRDFLOCK_HAS_SHM
+    if(!fHeader) return;
+    fHeader->state.store(state, std::memory_order_release);
+    munmap(fHeader, fBytes);
+    if(state == kSharedFlockClosed) shm_unlink(fName.c_str());
+#endif
+    fHeader = 0;
+    fBytes = 0;
+}
+
+/* publish
+ *
+ * Writes the current state of the flock into the next slot of the ring. The slot's sequence is
+ * made odd before anything is written and even again afterwards, so a reader can tell if it read
+ * the slot while it was changing. Only then is the frame count moved on, so readers are never
+ * pointed at a frame that isn't finished.
+ *
+ * inputs:
+ * - flock: the Flock to publish
+ */
+void SharedFlockWriter::publish(Flock* flock){
+    if(!fHeader) return;
+
+    std::vector<Bird*>* birds = flock->getBirds();
+    uint32_t birdCount = birds->size();
+    if(birdCount > fHeader->capacity){
+        uint32_t slotCount = fHeader->slotCount;
+        uint32_t capacity = std::max(birdCount, 2*fHeader->capacity);
+        unmap(kSharedFlockReplaced);
+        if(!create(capacity, slotCount)) return;
+    }
+
+    uint64_t frame = fFrame++;
+    SharedFlockSlot* slot = slotAt(frame % fHeader->slotCount);
+    slot->sequence.store(2*frame + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    //Birds eaten this tick are still in the flock until the next one, but aren't published
+    SharedFlockArrays arrays = sharedFlockArrays(slot, fHeader->capacity);
+    uint32_t count = 0;
+    for(uint32_t i=0; i<birdCount; i++){
+        const Bird* b = birds->at(i);
+        if(b->getIsDead()) continue;
+        TwoVector velocity = b->getVelocity();
+        arrays.x[count] = (float)b->getXPos();
+        arrays.y[count] = (float)b->getYPos();
+        arrays.vx[count] = (float)velocity.x();
+        arrays.vy[count] = (float)velocity.y();
+        arrays.id[count] = b->getId();
+        arrays.species[count] = b->getSpecies();
+        count++;
+    }
+    slot->tick = flock->getTick();
+    slot->birdCount = count;
+    slot->worldWidth = flock->getWorldWidth();
+    slot->worldHeight = flock->getWorldHeight();
+
+    slot->sequence.store(2*frame + 2, std::memory_order_release);
+    fHeader->frameCount.store(fFrame, std::memory_order_release);
+}
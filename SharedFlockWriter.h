@@ -0,0 +1,75 @@
+/* SharedFlockWriter.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SharedFlockWriter, which publishes every tick of a Flock into a POSIX shared
+ * memory region (see SharedFlock.h) for other programs to read while the simulation runs. Flock
+ * calls publish() at the end of every simulateFlock, which copies the Birds straight into the next
+ * slot of the ring; there is no other copy and no waiting for readers, so publishing costs about
+ * the same as one pass over the Birds. If the flock grows past the capacity of the slots, the writer
+ * moves to a new, bigger region with the same name and marks the old one as replaced, so readers
+ * know to open it again.
+ *
+ * Only available on POSIX systems; elsewhere open() always fails.
+ */
+#ifndef SHAREDFLOCKWRITER_H
+#define SHAREDFLOCKWRITER_H
+
+#include <string>
+#include <cstddef>
+#include "SharedFlock.h"
+
+class Flock;
+
+class SharedFlockWriter
+{
+public:
+
+    //Constructor
+    SharedFlockWriter();
+
+    //Deconstructor. Closes the region if it is still open.
+    virtual ~SharedFlockWriter();
+
+    /* Creates the shared memory region called name (e.g. "/birdflock"), with slotCount slots that
+     * each hold up to capacity Birds. Returns false if it couldn't be created. */
+    bool open(std::string name, int capacity = 4096, int slotCount = 4);
+
+    //marks the region as closed for its readers, and removes it
+    void close();
+
+    //copies the current state of the flock into the next slot. Called by Flock.
+    void publish(Flock* flock);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline bool const isOpen()const{return fHeader != 0;}
+    inline std::string const getName()const{return fName;}
+    inline uint64_t const getPublishedFrames()const{return fFrame;}
+    inline int const getCapacity()const{return fHeader ? fHeader->capacity : 0;}
+
+private:
+
+    //creates and maps a region, and fills in its header
+    bool create(uint32_t capacity, uint32_t slotCount);
+
+    //unmaps the region, and removes its name if the writer is finished with it
+    void unmap(SharedFlockState state);
+
+    //slot number slot of the ring
+    inline SharedFlockSlot* slotAt(uint64_t slot){
+        return reinterpret_cast<SharedFlockSlot*>(reinterpret_cast<char*>(fHeader + 1) + slot*fHeader->slotBytes);
+    }
+
+    std::string fName;
+
+    //the mapped region
+    SharedFlockHeader* fHeader;
+    size_t fBytes;
+
+    //number of the next frame published
+    uint64_t fFrame;
+};
+
+#endif // SHAREDFLOCKWRITER_H
@@ -0,0 +1,211 @@
+/* SharedMemoryTransport.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SharedMemoryTransport
+ */
+#include "SharedMemoryTransport.h"
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#define BIRDFLOCK_HAS_SHM 1
+#endif
+
+//Constructor
+SharedMemoryTransport::SharedMemoryTransport(int rank, int size) :
+    TileTransport(rank, size)
+{
+}
+
+//Deconstructor
+SharedMemoryTransport::~SharedMemoryTransport(){
+    closeAll();
+}
+
+//the ring from one rank to another, e.g. /birdflock-0-1
+std::string SharedMemoryTransport::ringName(int from, int to)const{
+    std::string name = fName[0] == '/' ? fName : "/" + fName;
+    return name + "-" + std::to_string(from) + "-" + std::to_string(to);
+}
+
+/* open
+ *
+ * inputs:
+ * - name: name the rings are called after
+ * - peers: ranks to exchange with
+ * - ringBytes: bytes of data in each ring this process makes
+ *
+ * return: true if there is a ring to and from every peer
+ */
+bool SharedMemoryTransport::open(const std::string& name, const std::vector<int>& peers, size_t ringBytes){
+    closeAll();
+    fName = name;
+    fPeers = peers;
+
+    TileRing empty = {0, 0, 0};
+    fSendRings.assign(peers.size(), empty);
+    fReceiveRings.assign(peers.size(), empty);
+    for(int i=0; i<peers.size(); i++){
+        if(!createRing(ringName(fRank, peers[i]), ringBytes, &fSendRings[i])){
+            closeAll();
+            return false;
+        }
+    }
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(kConnectSeconds);
+    for(int i=0; i<peers.size(); i++){
+        while(!openRing(ringName(peers[i], fRank), &fReceiveRings[i])){
+            if(std::chrono::steady_clock::now() >= deadline){
+                fError = "timed out waiting for rank " + std::to_string(peers[i]) + " to make its ring";
+                closeAll();
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    return true;
+}
+
+/* createRing
+ *
+ * Makes a new ring, replacing any left over with the same name, and fills in its header. The
+ * magic number is written last, so a reader that sees it knows the rest is ready.
+ *
+ * inputs:
+ * - name: shared memory name of the ring
+ * - ringBytes: bytes of data it holds
+ * - ring: set to the mapped ring
+ *
+ * return: true if it was made
+ */
+bool SharedMemoryTransport::createRing(const std::string& name, size_t ringBytes, TileRing* ring){
+#ifdef BIRDFLOCK_HAS_SHM
+    shm_unlink(name.c_str());
+    int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    size_t size = sizeof(TileRingHeader) + ringBytes;
+    if(descriptor < 0 || ftruncate(descriptor, size) != 0){
+        fError = "can't make shared memory " + name + ": " + strerror(errno);
+        if(descriptor >= 0) ::close(descriptor);
+        return false;
+    }
+    void* memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if(memory == MAP_FAILED){
+        fError = "can't map shared memory " + name;
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    ring->header = static_cast<TileRingHeader*>(memory);
+    ring->data = static_cast<uint8_t*>(memory) + sizeof(TileRingHeader);
+    ring->mappedSize = size;
+    ring->header->version = kTileRingVersion;
+    ring->header->capacity = ringBytes;
+    ring->header->creator = getpid();
+    ring->header->head.store(0, std::memory_order_relaxed);
+    ring->header->tail.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(ring->header->magic, kTileRingMagic, 4);
+    return true;
+#else
+    fError = "shared memory is not available on this system";
+    return false;
+#endif
+}
+
+//maps a ring whose header has been filled in by a process that is still running
+bool SharedMemoryTransport::openRing(const std::string& name, TileRing* ring){
+#ifdef BIRDFLOCK_HAS_SHM
+    int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if(descriptor < 0) return false;
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size <= (off_t)sizeof(TileRingHeader)){
+        ::close(descriptor);
+        return false;
+    }
+    void* memory = mmap(0, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if(memory == MAP_FAILED) return false;
+
+    TileRingHeader* header = static_cast<TileRingHeader*>(memory);
+    bool ready = memcmp(header->magic, kTileRingMagic, 4) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    ready = ready && header->version == kTileRingVersion &&
+            sizeof(TileRingHeader) + header->capacity == (size_t)status.st_size &&
+            (kill(header->creator, 0) == 0 || errno != ESRCH);
+    if(!ready){
+        munmap(memory, status.st_size);
+        return false;
+    }
+    ring->header = header;
+    ring->data = static_cast<uint8_t*>(memory) + sizeof(TileRingHeader);
+    ring->mappedSize = status.st_size;
+    return true;
+#else
+    return false;
+#endif
+}
+
+//unmaps every ring, and removes the ones this process made
+void SharedMemoryTransport::closeAll(){
+#ifdef BIRDFLOCK_HAS_SHM
+    for(int i=0; i<fSendRings.size(); i++){
+        if(!fSendRings[i].header) continue;
+        munmap(fSendRings[i].header, fSendRings[i].mappedSize);
+        shm_unlink(ringName(fRank, fPeers[i]).c_str());
+    }
+    for(int i=0; i<fReceiveRings.size(); i++){
+        if(fReceiveRings[i].header) munmap(fReceiveRings[i].header, fReceiveRings[i].mappedSize);
+    }
+#endif
+    fSendRings.clear();
+    fReceiveRings.clear();
+}
+
+//copies as much as fits into the ring to a peer, wrapping round its end
+long long SharedMemoryTransport::sendSome(int peer, const uint8_t* data, size_t size){
+    TileRing& ring = fSendRings[peer];
+    uint64_t capacity = ring.header->capacity;
+    uint64_t head = ring.header->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring.header->tail.load(std::memory_order_acquire);
+    size_t n = std::min<uint64_t>(size, capacity - (head - tail));
+
+    size_t start = head % capacity;
+    size_t first = std::min<size_t>(n, capacity - start);
+    memcpy(ring.data + start, data, first);
+    memcpy(ring.data, data + first, n - first);
+    ring.header->head.store(head + n, std::memory_order_release);
+    return n;
+}
+
+//copies out as much as the peer has put in its ring
+long long SharedMemoryTransport::receiveSome(int peer, uint8_t* data, size_t size){
+    TileRing& ring = fReceiveRings[peer];
+    uint64_t capacity = ring.header->capacity;
+    uint64_t tail = ring.header->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring.header->head.load(std::memory_order_acquire);
+    size_t n = std::min<uint64_t>(size, head - tail);
+
+    size_t start = tail % capacity;
+    size_t first = std::min<size_t>(n, capacity - start);
+    memcpy(data, ring.data + start, first);
+    memcpy(data + first, ring.data, n - first);
+    ring.header->tail.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+/* there is nothing to wait on, so this yields to the other processes for a while, then sleeps
+ * briefly so a long wait doesn't keep a core busy */
+void SharedMemoryTransport::wait(const std::vector<unsigned char>&, const std::vector<unsigned char>&, int idleRounds){
+    if(idleRounds < kSpinRounds) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
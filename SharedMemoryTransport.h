@@ -0,0 +1,98 @@
+/* SharedMemoryTransport.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SharedMemoryTransport, a TileTransport for processes on the same machine that
+ * passes bytes through POSIX shared memory instead of the kernel. Every process makes one ring
+ * for each of its peers, called <name>-<rank>-<peer>, that only it writes to and only that peer
+ * reads from, so each ring has one producer and one consumer and needs no locks: the producer
+ * only moves the head and the consumer only moves the tail. Messages bigger than a ring just go
+ * through it a piece at a time.
+ *
+ * A ring left behind by a process that has died is noticed from the process id stored in it, and
+ * not used.
+ *
+ * Only available on POSIX systems; elsewhere open() always fails.
+ */
+#ifndef SHAREDMEMORYTRANSPORT_H
+#define SHAREDMEMORYTRANSPORT_H
+
+#include "TileTransport.h"
+#include <atomic>
+
+//magic number at the start of every ring, so a reader knows it has been set up
+static const char kTileRingMagic[4] = {'B', 'F', 'T', 'R'};
+static const uint32_t kTileRingVersion = 1;
+
+/* The start of a ring, followed by its capacity bytes of data. head and tail count every byte ever
+ * written and read, and are on their own cache lines so the two processes don't slow each other
+ * down. */
+struct TileRingHeader
+{
+    char magic[4];//kTileRingMagic, written last when the ring is made
+    uint32_t version;
+    uint64_t capacity;
+    int32_t creator;//process id of the writer
+    uint32_t reserved[11];
+    std::atomic<uint64_t> head;//written by the producer
+    char headPadding[56];
+    std::atomic<uint64_t> tail;//written by the consumer
+    char tailPadding[56];
+};
+
+//one ring, as mapped by this process
+struct TileRing
+{
+    TileRingHeader* header;
+    uint8_t* data;
+    size_t mappedSize;
+};
+
+class SharedMemoryTransport : public TileTransport
+{
+public:
+
+    //Constructor
+    SharedMemoryTransport(int rank, int size);
+
+    //Deconstructor. Unmaps every ring, and removes the ones this process made.
+    virtual ~SharedMemoryTransport();
+
+    /* makes a ring to every peer and opens the ring from every peer, waiting up to kConnectSeconds
+     * for the peers to make theirs. Returns false, and sets the error, if it can't. */
+    bool open(const std::string& name, const std::vector<int>& peers, size_t ringBytes = kDefaultRingBytes);
+
+    //bytes of data in each ring unless open is told otherwise
+    static const size_t kDefaultRingBytes = 1 << 20;
+
+protected:
+
+    long long sendSome(int peer, const uint8_t* data, size_t size);
+    long long receiveSome(int peer, uint8_t* data, size_t size);
+    void wait(const std::vector<unsigned char>& sending, const std::vector<unsigned char>& receiving, int idleRounds);
+
+private:
+
+    //shared memory name of the ring from one rank to another
+    std::string ringName(int from, int to)const;
+
+    //makes a ring and fills in its header. Returns false if it couldn't be made.
+    bool createRing(const std::string& name, size_t ringBytes, TileRing* ring);
+
+    //opens a ring made by a running process. Returns false if there isn't one yet.
+    bool openRing(const std::string& name, TileRing* ring);
+
+    //unmaps every ring, and removes the names of the ones this process made
+    void closeAll();
+
+    std::string fName;
+
+    //rings to and from each peer, in the order of fPeers
+    std::vector<TileRing> fSendRings;
+    std::vector<TileRing> fReceiveRings;
+
+    //idle rounds spent just yielding before wait() starts sleeping
+    static const int kSpinRounds = 64;
+};
+
+#endif // SHAREDMEMORYTRANSPORT_H
@@ -0,0 +1,176 @@
+/* SimulationHost.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SimulationHost, which runs many Flocks on one shared ThreadPool.
+ */
+#include "SimulationHost.h"
+#include "Flock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+/* Simulations with less work than this in a round (Birds x ticks) are batched together until a
+ * batch has about this much work, which takes around a millisecond. */
+static const long long kBatchBirdTicks = 1000;
+
+//Constructor
+SimulationHost::SimulationHost(int threadCount) :
+    fPool(threadCount), fNextId(0), fRound(0)
+{
+}
+
+//Deconstructor
+SimulationHost::~SimulationHost(){
+    for(int i=0; i<fSimulations.size(); i++){
+        delete fSimulations[i]->flock;
+        delete fSimulations[i];
+    }
+}
+
+/* addSimulation
+ *
+ * Hosts a Flock. The host owns it from now on, and deletes it when it is removed.
+ *
+ * inputs:
+ * - flock: the Flock, already filled with Birds
+ * - priority: simulations with higher priorities are started first in each round
+ * - ticksPerRound: number of ticks the simulation runs each round
+ * - tickLimit: the simulation stops after this many ticks, -1 for never
+ *
+ * return: the id of the simulation
+ */
+int SimulationHost::addSimulation(Flock* flock, int priority, int ticksPerRound, long long tickLimit){
+    flock->setThreadCount(1);
+
+    //Flocks take turns on the host's threads, so none may pin the thread it is run on
+    flock->setPinThreads(false);
+
+    HostedSimulation* simulation = new HostedSimulation;
+    simulation->id = fNextId++;
+    simulation->flock = flock;
+    simulation->priority = priority;
+    simulation->ticksPerRound = ticksPerRound;
+    simulation->tickLimit = tickLimit;
+    simulation->paused = false;
+    simulation->ticksRun = 0;
+    simulation->skippedRounds = 0;
+    simulation->lastRoundSeconds = 0;
+    fSimulations.push_back(simulation);
+    return simulation->id;
+}
+
+//stops hosting a simulation, and deletes its Flock
+bool SimulationHost::removeSimulation(int id){
+    for(int i=0; i<fSimulations.size(); i++){
+        if(fSimulations[i]->id == id){
+            delete fSimulations[i]->flock;
+            delete fSimulations[i];
+            fSimulations.erase(fSimulations.begin() + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+//the simulation with an id, or null
+HostedSimulation* SimulationHost::getSimulation(int id){
+    for(int i=0; i<fSimulations.size(); i++){
+        if(fSimulations[i]->id == id) return fSimulations[i];
+    }
+    return 0;
+}
+
+//true if every simulation has reached its tick limit
+bool SimulationHost::isFinished()const{
+    for(int i=0; i<fSimulations.size(); i++){
+        const HostedSimulation* simulation = fSimulations[i];
+        if(simulation->tickLimit < 0 || simulation->ticksRun < simulation->tickLimit) return false;
+    }
+    return true;
+}
+
+//number of ticks a simulation runs this round: its ticksPerRound, unless that would pass its limit
+int SimulationHost::ticksThisRound(const HostedSimulation* simulation)const{
+    if(simulation->paused) return 0;
+    long long ticks = simulation->ticksPerRound;
+    if(simulation->tickLimit >= 0) ticks = std::min(ticks, simulation->tickLimit - simulation->ticksRun);
+    return std::max(0LL, ticks);
+}
+
+/* makeBatches
+ *
+ * Puts the simulations with ticks to run into batches, in order of priority. A simulation with at
+ * least kBatchBirdTicks of work gets a batch of its own. Smaller ones are added to the current
+ * batch of small simulations until it has that much work between them, then a new one is started.
+ * Because the ThreadPool hands out batches in order, higher priority batches are started first.
+ */
+void SimulationHost::makeBatches(){
+    std::vector<HostedSimulation*> order;
+    for(int i=0; i<fSimulations.size(); i++){
+        if(ticksThisRound(fSimulations[i]) > 0) order.push_back(fSimulations[i]);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const HostedSimulation* a, const HostedSimulation* b){
+        return a->priority > b->priority;
+    });
+
+    fBatches.clear();
+    int smallBatch = -1;
+    long long smallBatchWork = 0;
+    for(int i=0; i<order.size(); i++){
+        long long work = (long long)std::max<size_t>(1, order[i]->flock->getBirds()->size()) * ticksThisRound(order[i]);
+        if(work >= kBatchBirdTicks){
+            fBatches.push_back(std::vector<HostedSimulation*>(1, order[i]));
+            continue;
+        }
+
+        if(smallBatch < 0 || smallBatchWork >= kBatchBirdTicks){
+            smallBatch = fBatches.size();
+            smallBatchWork = 0;
+            fBatches.push_back(std::vector<HostedSimulation*>());
+        }
+        fBatches[smallBatch].push_back(order[i]);
+        smallBatchWork += work;
+    }
+}
+
+/* runRound
+ *
+ * Runs every simulation that isn't paused or finished for its ticks this round, spreading the
+ * batches over the pool. Each simulation's ticks are run together on one thread. If maxSeconds is
+ * given, a simulation that hasn't been started by then is skipped until the next round, and its
+ * skippedRounds goes up; simulations already running are always allowed to finish their ticks.
+ *
+ * inputs:
+ * - maxSeconds: time after which no more simulations are started, 0 for no limit
+ *
+ * return: the number of ticks run, over all the simulations
+ */
+int SimulationHost::runRound(double maxSeconds){
+    makeBatches();
+    fRound++;
+
+    std::atomic<int> ticksRun(0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    fPool.parallelFor(fBatches.size(), 1, [&](int begin, int end, int){
+        for(int b=begin; b<end; b++){
+            for(int i=0; i<fBatches[b].size(); i++){
+                HostedSimulation* simulation = fBatches[b][i];
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if(maxSeconds > 0 && std::chrono::duration<double>(now - start).count() > maxSeconds){
+                    simulation->skippedRounds++;
+                    continue;
+                }
+
+                int ticks = ticksThisRound(simulation);
+                for(int t=0; t<ticks; t++){
+                    simulation->flock->simulateFlock();
+                }
+                simulation->ticksRun += ticks;
+                simulation->lastRoundSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - now).count();
+                ticksRun += ticks;
+            }
+        }
+    });
+    return ticksRun;
+}
@@ -0,0 +1,90 @@
+/* SimulationHost.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SimulationHost, which owns many independent Flocks and runs their ticks on one
+ * shared ThreadPool, for running lots of small simulations in one process. Work is done in rounds:
+ * each round, every simulation runs up to its own number of ticks. The simulations are started in
+ * order of priority, highest first, so if a round is given a time limit it is the low priority
+ * simulations that miss out when there isn't time for everything. Small simulations are put
+ * together into batches that one thread runs one after the other, so the cost of handing out work
+ * isn't paid for every tiny Flock.
+ *
+ * Each Flock is run by one thread at a time, so the host sets its Flocks to use a single thread,
+ * not pinned to a core. A very large Flock is better run on its own with Flock::setThreadCount. The
+ * host, and the Flocks it owns, must only be used by one thread, and not while runRound is running.
+ */
+#ifndef SIMULATIONHOST_H
+#define SIMULATIONHOST_H
+
+#include <vector>
+#include "ThreadPool.h"
+
+class Flock;
+
+//a Flock owned by a SimulationHost, with the settings used to schedule it
+struct HostedSimulation
+{
+    int id;
+    Flock* flock;
+    int priority;//higher priorities are started first in each round
+    int ticksPerRound;//ticks run in each round
+    long long tickLimit;//the simulation stops after this many ticks, -1 for never
+    bool paused;//paused simulations are left out of rounds
+
+    //what has happened so far
+    long long ticksRun;
+    int skippedRounds;//rounds the simulation was left out of because the time ran out
+    double lastRoundSeconds;//time its ticks took in the last round it ran in
+};
+
+class SimulationHost
+{
+public:
+
+    //Constructor. threadCount threads run the simulations, 0 for one per core.
+    SimulationHost(int threadCount = 0);
+
+    //Deconstructor. Deletes every Flock still hosted.
+    virtual ~SimulationHost();
+
+    //hosts a Flock, which the host then owns. Returns the id used to refer to it.
+    int addSimulation(Flock* flock, int priority = 0, int ticksPerRound = 1, long long tickLimit = -1);
+
+    //stops hosting a simulation and deletes its Flock. Returns false if there is no such id.
+    bool removeSimulation(int id);
+
+    //the simulation with an id, or null. Its settings can be changed between rounds.
+    HostedSimulation* getSimulation(int id);
+
+    //runs one round. If maxSeconds > 0, simulations not started by then are skipped. Returns the number of ticks run.
+    int runRound(double maxSeconds = 0);
+
+    //true if every simulation has reached its tick limit
+    bool isFinished()const;
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline std::vector<HostedSimulation*>* getSimulations(){return &fSimulations;}
+    inline int const getThreadCount()const{return fPool.getThreadCount();}
+    inline long long const getRound()const{return fRound;}
+
+private:
+
+    //number of ticks a simulation should run this round
+    int ticksThisRound(const HostedSimulation* simulation)const;
+
+    //sorts the simulations by priority and groups them into the batches run this round
+    void makeBatches();
+
+    ThreadPool fPool;
+    std::vector<HostedSimulation*> fSimulations;
+    int fNextId;
+    long long fRound;
+
+    //the batches of the current round, each run by one thread
+    std::vector<std::vector<HostedSimulation*> > fBatches;
+};
+
+#endif // SIMULATIONHOST_H
@@ -0,0 +1,269 @@
+/* SocketTransport.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SocketTransport
+ */
+#include "SocketTransport.h"
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#define BIRDFLOCK_HAS_SOCKETS 1
+#endif
+
+//flags for send, so a peer that has gone doesn't kill the process with SIGPIPE
+#ifdef MSG_NOSIGNAL
+static const int kSendFlags = MSG_NOSIGNAL;
+#else
+static const int kSendFlags = 0;
+#endif
+
+//Constructor
+SocketTransport::SocketTransport(int rank, int size) :
+    TileTransport(rank, size)
+{
+    fTcp = false;
+    fPort = 0;
+}
+
+//Deconstructor
+SocketTransport::~SocketTransport(){
+    closeAll();
+}
+
+//connects through Unix sockets at path.<rank>
+bool SocketTransport::openUnix(const std::string& path, const std::vector<int>& peers){
+    fTcp = false;
+    fPath = path;
+    return connectPeers(peers);
+}
+
+//connects over TCP, to port + rank on each peer's host
+bool SocketTransport::openTcp(const std::vector<std::string>& hosts, int port, const std::vector<int>& peers){
+    if(hosts.empty() || port <= 0){
+        fError = "no hosts or port given";
+        return false;
+    }
+    fTcp = true;
+    fHosts = hosts;
+    fPort = port;
+    return connectPeers(peers);
+}
+
+/* connectPeers
+ *
+ * Starts listening, then connects to every lower ranked peer, retrying until it has started, and
+ * then accepts a connection from every higher ranked peer. A peer that connects before this
+ * process is accepting just waits in the backlog, so no order of starting can lock up.
+ *
+ * inputs:
+ * - peers: ranks to connect to
+ *
+ * return: true if every peer was connected
+ */
+bool SocketTransport::connectPeers(const std::vector<int>& peers){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    closeAll();
+    fPeers = peers;
+    fSockets.assign(peers.size(), -1);
+
+    //listen at this rank's own address
+    int listener = -1;
+    if(fTcp){
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(fPort + fRank);
+        if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0){
+            fError = "can't listen on port " + std::to_string(fPort + fRank) + ": " + strerror(errno);
+            if(listener >= 0) ::close(listener);
+            return false;
+        }
+    }
+    else{
+        std::string path = fPath + "." + std::to_string(fRank);
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if(path.size() >= sizeof(address.sun_path)){
+            fError = "socket path " + path + " is too long";
+            return false;
+        }
+        strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0){
+            fError = "can't listen at " + path + ": " + strerror(errno);
+            if(listener >= 0) ::close(listener);
+            return false;
+        }
+    }
+    listen(listener, kBacklog);
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(kConnectSeconds);
+    bool connected = true;
+
+    //connect to the lower ranks, and tell each one who this is
+    for(int i=0; i<peers.size() && connected; i++){
+        if(peers[i] >= fRank) continue;
+        while((fSockets[i] = connectTo(peers[i])) < 0 && std::chrono::steady_clock::now() < deadline){
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        int32_t rank = fRank;
+        if(fSockets[i] < 0 || send(fSockets[i], &rank, sizeof(rank), kSendFlags) != sizeof(rank)){
+            fError = "can't connect to rank " + std::to_string(peers[i]);
+            connected = false;
+        }
+    }
+
+    //accept the higher ranks, which each say who they are
+    int waiting = 0;
+    for(int i=0; i<peers.size(); i++) waiting += peers[i] > fRank;
+    while(connected && waiting > 0){
+        int timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        pollfd waitFor = {listener, POLLIN, 0};
+        if(timeLeft <= 0 || poll(&waitFor, 1, timeLeft) <= 0){
+            fError = "timed out waiting for higher ranks to connect";
+            connected = false;
+            break;
+        }
+        int client = accept(listener, 0, 0);
+        if(client < 0) continue;
+        timeval timeout = {kConnectSeconds, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        int32_t rank = -1;
+        int index = -1;
+        if(recv(client, &rank, sizeof(rank), MSG_WAITALL) == sizeof(rank)){
+            index = std::find(peers.begin(), peers.end(), rank) - peers.begin();
+        }
+        if(index < 0 || index >= peers.size() || rank <= fRank || fSockets[index] >= 0){
+            ::close(client);
+            continue;
+        }
+        fSockets[index] = client;
+        waiting--;
+    }
+
+    ::close(listener);
+    if(!fTcp) unlink((fPath + "." + std::to_string(fRank)).c_str());
+    if(!connected){
+        closeAll();
+        return false;
+    }
+
+    //from now on nothing waits on a socket except wait()
+    for(int i=0; i<fSockets.size(); i++){
+        fcntl(fSockets[i], F_SETFL, fcntl(fSockets[i], F_GETFL) | O_NONBLOCK);
+        if(fTcp){
+            int noDelay = 1;
+            setsockopt(fSockets[i], IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(fSockets[i], SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    }
+    return true;
+#else
+    fError = "sockets are not available on this system";
+    return false;
+#endif
+}
+
+//makes a socket connected to the listener of a rank, or returns -1 if it isn't listening yet
+int SocketTransport::connectTo(int rank){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    int connection = -1;
+    if(fTcp){
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* found = 0;
+        std::string port = std::to_string(fPort + rank);
+        if(getaddrinfo(fHosts[rank % fHosts.size()].c_str(), port.c_str(), &hints, &found) != 0) return -1;
+        connection = socket(AF_INET, SOCK_STREAM, 0);
+        if(connection >= 0 && connect(connection, found->ai_addr, found->ai_addrlen) != 0){
+            ::close(connection);
+            connection = -1;
+        }
+        freeaddrinfo(found);
+    }
+    else{
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, (fPath + "." + std::to_string(rank)).c_str(), sizeof(address.sun_path) - 1);
+        connection = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(connection >= 0 && connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0){
+            ::close(connection);
+            connection = -1;
+        }
+    }
+    return connection;
+#else
+    return -1;
+#endif
+}
+
+//closes the connection to every peer
+void SocketTransport::closeAll(){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    for(int i=0; i<fSockets.size(); i++){
+        if(fSockets[i] >= 0) ::close(fSockets[i]);
+    }
+#endif
+    fSockets.clear();
+}
+
+//sends what the socket of a peer will take without waiting
+long long SocketTransport::sendSome(int peer, const uint8_t* data, size_t size){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    ssize_t n = send(fSockets[peer], data, size, kSendFlags);
+    if(n >= 0) return n;
+    if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+    fError = "lost the connection to rank " + std::to_string(fPeers[peer]) + ": " + strerror(errno);
+#endif
+    return -1;
+}
+
+//receives what has arrived from a peer without waiting
+long long SocketTransport::receiveSome(int peer, uint8_t* data, size_t size){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    ssize_t n = recv(fSockets[peer], data, size, 0);
+    if(n > 0) return n;
+    if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+    fError = "rank " + std::to_string(fPeers[peer]) + " closed the connection";
+#endif
+    return -1;
+}
+
+//waits until one of the sockets can move something, or a second has gone by
+void SocketTransport::wait(const std::vector<unsigned char>& sending, const std::vector<unsigned char>& receiving, int){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    std::vector<pollfd> waitFor;
+    for(int i=0; i<fSockets.size(); i++){
+        short events = (sending[i] ? POLLOUT : 0) | (receiving[i] ? POLLIN : 0);
+        if(events == 0) continue;
+        pollfd entry = {fSockets[i], events, 0};
+        waitFor.push_back(entry);
+    }
+    poll(waitFor.data(), waitFor.size(), 1000);
+#endif
+}
@@ -0,0 +1,64 @@
+/* SocketTransport.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SocketTransport, a TileTransport over stream sockets: Unix sockets between
+ * processes on one machine, or TCP between machines. Every process listens at its own address,
+ * connects to the peers with lower ranks and accepts the peers with higher ranks, so each pair
+ * ends up with one connection whichever order the processes start in. The first thing sent on a
+ * connection is the rank of the process that made it.
+ *
+ * Only available on POSIX systems; elsewhere the open methods always fail.
+ */
+#ifndef SOCKETTRANSPORT_H
+#define SOCKETTRANSPORT_H
+
+#include "TileTransport.h"
+
+class SocketTransport : public TileTransport
+{
+public:
+
+    //Constructor
+    SocketTransport(int rank, int size);
+
+    //Deconstructor. Closes every connection.
+    virtual ~SocketTransport();
+
+    //connects to the peers through Unix sockets at path.<rank>. Returns false, and sets the error, if it can't.
+    bool openUnix(const std::string& path, const std::vector<int>& peers);
+
+    /* connects to the peers over TCP. Rank r listens on port + r, and is reached at host number r of
+     * hosts (modulo its length). Returns false, and sets the error, if it can't. */
+    bool openTcp(const std::vector<std::string>& hosts, int port, const std::vector<int>& peers);
+
+protected:
+
+    long long sendSome(int peer, const uint8_t* data, size_t size);
+    long long receiveSome(int peer, uint8_t* data, size_t size);
+    void wait(const std::vector<unsigned char>& sending, const std::vector<unsigned char>& receiving, int idleRounds);
+
+private:
+
+    //listens, then connects to or accepts every peer. Shared by openUnix and openTcp.
+    bool connectPeers(const std::vector<int>& peers);
+
+    //makes a socket connected to a rank, or returns -1
+    int connectTo(int rank);
+
+    //closes every socket
+    void closeAll();
+
+    bool fTcp;
+    std::string fPath;
+    std::vector<std::string> fHosts;
+    int fPort;
+
+    //socket of each peer, in the order of fPeers
+    std::vector<int> fSockets;
+
+    //most connections waiting to be accepted
+    static const int kBacklog = 16;
+};
+
+#endif // SOCKETTRANSPORT_H
@@ -0,0 +1,110 @@
+/* SpatialGrid.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for SpatialGrid, a uniform grid of square cells laid over the world. Each cell
+ * stores the indices of the FlockObjects whose positions are inside it, so that objects near
+ * a point or inside a rectangle can be found without checking every object in the simulation.
+ */
+#include "SpatialGrid.h"
+#include <cmath>
+#include <algorithm>
+
+//Constructor. The grid starts with a single empty cell until it is first built.
+SpatialGrid::SpatialGrid(double cellSize) :
+    fCellSize(cellSize), fColumns(1), fRows(1){
+    fCellStart.assign(2, 0);
+}
+
+//Deconstructor
+SpatialGrid::~SpatialGrid(){}
+
+/* resize
+ *
+ * Sets the number of columns and rows so the grid covers the whole world. Always at
+ * least one cell, so that a zero sized world still works.
+ */
+void SpatialGrid::resize(int width, int height){
+    fColumns = std::max(1, (int)std::ceil(width/fCellSize));
+    fRows = std::max(1, (int)std::ceil(height/fCellSize));
+}
+
+/* sortIntoCells
+ *
+ * Counting sort of the object indices by cell. First counts how many objects are in each
+ * cell, then turns the counts into start positions, then places each index into its cell.
+ * Objects keep their relative order inside each cell. Runs in O(objects + cells).
+ */
+void SpatialGrid::sortIntoCells(){
+    int cellCount = getCellCount();
+    fCellStart.assign(cellCount + 1, 0);
+
+    //count objects in each cell, stored one place along so the prefix sum below gives start positions
+    for(int i=0; i<fObjectCells.size(); i++){
+        fCellStart[fObjectCells[i] + 1]++;
+    }
+    for(int c=0; c<cellCount; c++){
+        fCellStart[c+1] += fCellStart[c];
+    }
+
+    //place indices, using a copy of the start positions as write positions
+    fEntries.resize(fObjectCells.size());
+    std::vector<int> next(fCellStart.begin(), fCellStart.end()-1);
+    for(int i=0; i<fObjectCells.size(); i++){
+        fEntries[next[fObjectCells[i]]++] = i;
+    }
+}
+
+/* query
+ *
+ * Finds all objects in cells that overlap a rectangle. Objects near the edges of the
+ * rectangle may be outside it, so callers should still check positions if they need to.
+ *
+ * inputs:
+ * - minX, minY: top-left corner of the rectangle
+ * - maxX, maxY: bottom-right corner of the rectangle
+ * - out: vector that the indices of the objects are appended to
+ */
+void SpatialGrid::query(double minX, double minY, double maxX, double maxY, std::vector<int>* out)const{
+
+    //nothing to find if the rectangle is completely outside the grid
+    if(maxX < 0 || maxY < 0 || minX > fColumns*fCellSize || minY > fRows*fCellSize){
+        return;
+    }
+
+    int firstColumn = column(minX), lastColumn = column(maxX);
+    int firstRow = row(minY), lastRow = row(maxY);
+
+    for(int r=firstRow; r<=lastRow; r++){
+        for(int c=firstColumn; c<=lastColumn; c++){
+            int cell = r*fColumns + c;
+            out->insert(out->end(), cellBegin(cell), cellEnd(cell));
+        }
+    }
+}
+
+/* count
+ *
+ * The cells of a row are next to each other in fEntries, so the entries of every cell of a row
+ * between two columns can be counted from where the first starts and the last ends, without
+ * reading them.
+ *
+ * inputs:
+ * - minX, minY, maxX, maxY: the rectangle, as for query
+ *
+ * return: number of objects in cells overlapping the rectangle
+ */
+int SpatialGrid::count(double minX, double minY, double maxX, double maxY)const{
+    if(maxX < 0 || maxY < 0 || minX > fColumns*fCellSize || minY > fRows*fCellSize){
+        return 0;
+    }
+
+    int firstColumn = column(minX), lastColumn = column(maxX);
+    int firstRow = row(minY), lastRow = row(maxY);
+
+    int total = 0;
+    for(int r=firstRow; r<=lastRow; r++){
+        total += fCellStart[r*fColumns + lastColumn + 1] - fCellStart[r*fColumns + firstColumn];
+    }
+    return total;
+}
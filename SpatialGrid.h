@@ -0,0 +1,112 @@
+/* SpatialGrid.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for SpatialGrid, a uniform grid of square cells laid over the world. Each cell
+ * stores the indices of the FlockObjects whose positions are inside it, so that objects near
+ * a point or inside a rectangle can be found without checking every object in the simulation.
+ * The grid is rebuilt from scratch by Flock every tick using a counting sort, and indices are
+ * stored contiguously cell by cell.
+ */
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <vector>
+#include <cstdint>
+#include "FlockObject.h"
+
+class SpatialGrid
+{
+public:
+
+    //Constructor. cellSize is the width of each square cell in world units.
+    SpatialGrid(double cellSize);
+
+    //Deconstructor
+    virtual ~SpatialGrid();
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline double const getCellSize()const{return fCellSize;}
+    inline int const getColumns()const{return fColumns;}
+    inline int const getRows()const{return fRows;}
+    inline int const getCellCount()const{return fColumns*fRows;}
+
+    //column and row of the cell containing a position. Positions outside the world are clamped to the edge cells.
+    inline int const column(double x)const{return clamp((int)(x/fCellSize), fColumns);}
+    inline int const row(double y)const{return clamp((int)(y/fCellSize), fRows);}
+
+    /* The entries of cell number 'cell' (row*columns + column) are the indices in the range
+     * [cellBegin(cell), cellEnd(cell)), in the same order as in the vector the grid was built from */
+    inline const int* cellBegin(int cell)const{return fEntries.data() + fCellStart[cell];}
+    inline const int* cellEnd(int cell)const{return fEntries.data() + fCellStart[cell+1];}
+
+    /* Morton (Z-order) code of a cell: the bits of its column and row interleaved, so cells that are
+     * close together in the world mostly have close codes. Only the lowest 16 bits of each are used. */
+    inline static uint32_t mortonCode(int column, int row){return spreadBits(column) | (spreadBits(row) << 1);}
+
+    //rebuilds the grid from the positions of the given objects, for a world of the given size
+    template<class T>
+    void build(const std::vector<T*>* objects, int width, int height);
+
+    //appends the indices of all objects in cells overlapping the given rectangle to out
+    void query(double minX, double minY, double maxX, double maxY, std::vector<int>* out)const;
+
+    //number of indices query would append for the same rectangle
+    int count(double minX, double minY, double maxX, double maxY)const;
+
+private:
+
+    //clamps a cell coordinate into [0, count)
+    inline static int clamp(int cell, int count){return cell < 0 ? 0 : (cell >= count ? count-1 : cell);}
+
+    //spreads the lowest 16 bits of a value out to the even bits
+    inline static uint32_t spreadBits(uint32_t value){
+        value &= 0xffff;
+        value = (value | (value << 8)) & 0x00ff00ff;
+        value = (value | (value << 4)) & 0x0f0f0f0f;
+        value = (value | (value << 2)) & 0x33333333;
+        value = (value | (value << 1)) & 0x55555555;
+        return value;
+    }
+
+    //resizes the grid to cover a world of the given size
+    void resize(int width, int height);
+
+    //counting sort of the indices in fObjectCells into fCellStart and fEntries
+    void sortIntoCells();
+
+    double fCellSize;//width of each cell
+    int fColumns;//number of cells along x
+    int fRows;//number of cells along y
+
+    std::vector<int> fCellStart;//index into fEntries of the first entry of each cell, plus one extra for the end
+    std::vector<int> fEntries;//object indices, sorted by cell
+    std::vector<int> fObjectCells;//cell of each object, filled in by build()
+};
+
+/* build
+ *
+ * Finds the cell of every object, then sorts the indices of the objects into the cells.
+ * Defined in the header because it is a template, so it works for vectors of any
+ * FlockObject (Birds or Obstacles).
+ *
+ * inputs:
+ * - objects: objects to put in the grid
+ * - width: width of the world
+ * - height: height of the world
+ */
+template<class T>
+void SpatialGrid::build(const std::vector<T*>* objects, int width, int height){
+    resize(width, height);
+
+    fObjectCells.resize(objects->size());
+    for(int i=0; i<objects->size(); i++){
+        const FlockObject* o = objects->at(i);
+        fObjectCells[i] = row((double)o->getYPos())*fColumns + column((double)o->getXPos());
+    }
+    sortIntoCells();
+}
+
+#endif // SPATIALGRID_H
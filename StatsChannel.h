@@ -0,0 +1,96 @@
+/* StatsChannel.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for StatsChannel, which passes the latest value of something (e.g. the FlockStats of
+ * the last tick analysed) from the thread that makes it to one other thread that reads it, without
+ * either thread ever waiting for the other. It is a triple buffer: the writer fills one buffer,
+ * the reader reads another, and finished values are swapped through the third with a single atomic
+ * exchange. The reader always gets the newest value published; values published faster than they
+ * are read are simply skipped, so a slow reader can never hold up the simulation.
+ *
+ * Only one thread may publish and only one thread may read. T must be copyable.
+ */
+#ifndef STATSCHANNEL_H
+#define STATSCHANNEL_H
+
+#include <atomic>
+
+template<class T>
+class StatsChannel
+{
+public:
+
+    //Constructor
+    StatsChannel() : fMiddle(2), fWrite(0), fRead(1), fPublished(0) {}
+
+    /* publish
+     *
+     * Copies a value into the writer's buffer and swaps it into the middle, marked as new. Called
+     * by the writing thread only.
+     *
+     * inputs:
+     * - value: the value to publish
+     */
+    void publish(const T& value){
+        fBuffers[fWrite] = value;
+        publishWriteBuffer();
+    }
+
+    /* For values that are big or costly to copy, the writer can fill the buffer it owns in place
+     * instead, then publish it with publishWriteBuffer(). The buffer holds whatever value was in it
+     * last, so it must be filled completely. */
+    inline T* getWriteBuffer(){return &fBuffers[fWrite];}
+    void publishWriteBuffer(){
+        fWrite = fMiddle.exchange(fWrite | kFresh, std::memory_order_acq_rel) & kIndexMask;
+        fPublished.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* read
+     *
+     * Takes the newest value, if one has been published since the last read. Called by the reading
+     * thread only.
+     *
+     * inputs:
+     * - out: set to the newest value, if there is a new one
+     *
+     * return: true if there was a new value
+     */
+    bool read(T* out){
+        const T* value = take();
+        if(!value) return false;
+        *out = *value;
+        return true;
+    }
+
+    /* take
+     *
+     * Like read, but without copying: takes the newest value into the buffer the reader owns and
+     * returns it. The value stays valid, and unchanged, until the next take or read. Called by the
+     * reading thread only.
+     *
+     * return: the newest value, or 0 if there isn't a new one
+     */
+    const T* take(){
+        if(!(fMiddle.load(std::memory_order_relaxed) & kFresh)) return 0;
+        fRead = fMiddle.exchange(fRead, std::memory_order_acq_rel) & kIndexMask;
+        return &fBuffers[fRead];
+    }
+
+    //number of values published so far, from any thread
+    inline long long const getPublished()const{return fPublished.load(std::memory_order_relaxed);}
+
+private:
+
+    //the low bits of fMiddle are the index of the middle buffer, kFresh is set if it hasn't been read
+    static const int kIndexMask = 3;
+    static const int kFresh = 4;
+
+    T fBuffers[3];
+    std::atomic<int> fMiddle;
+    int fWrite;//buffer owned by the writer
+    int fRead;//buffer owned by the reader
+    std::atomic<long long> fPublished;
+};
+
+#endif // STATSCHANNEL_H
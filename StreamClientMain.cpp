@@ -0,0 +1,195 @@
+/* StreamClientMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockStreamClient, a command line viewer for StreamServer, used to check a stream
+ * without a browser. Run BirdFlockHeadless with --serve port, then:
+ *
+ *     BirdFlockStreamClient [address:]port [--fps N] [--seconds S] [--slow ms]
+ *
+ * Connects with a WebSocket, asks for N frames a second (20 by default), decodes every frame with
+ * FrameDecoder, and once a second prints how many frames and bytes arrived and the newest tick.
+ * Stops after S seconds (10 by default) or when the server goes. --slow waits that long after every
+ * frame before reading the next, to act like a viewer that can't keep up: the server should send it
+ * fewer frames, without the simulation slowing down. Returns 1 if any frame fails to decode.
+ */
+#include "Trajectory.h"
+#include "WebSocket.h"
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockStreamClient [address:]port [--fps N] [--seconds S] [--slow ms]" << std::endl;
+}
+
+//seconds since start
+static double secondsSince(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//sends all of data. Returns false if the connection has gone.
+static bool sendAll(int socket, const std::vector<uint8_t>& data){
+    size_t sent = 0;
+    while(sent < data.size()){
+        ssize_t n = send(socket, data.data() + sent, data.size() - sent, 0);
+        if(n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 2){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    double fps = 20;
+    double seconds = 10;
+    int slow = 0;
+    for(int i=2; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--fps") == 0) fps = atof(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seconds") == 0) seconds = atof(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--slow") == 0) slow = atoi(argv[++i]);
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::string target = argv[1];
+    size_t colon = target.rfind(':');
+    std::string address = colon == std::string::npos ? "127.0.0.1" : target.substr(0, colon);
+    int port = atoi(target.c_str() + (colon == std::string::npos ? 0 : colon + 1));
+
+    sockaddr_in socketAddress;
+    memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    if(inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1 || server < 0 ||
+       connect(server, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0){
+        std::cerr << "can't connect to " << address << ":" << port << std::endl;
+        return 1;
+    }
+
+    //handshake, with a random key the server has to prove it read
+    std::mt19937 random(std::random_device{}());
+    uint8_t keyBytes[16];
+    for(int i=0; i<16; i++) keyBytes[i] = (uint8_t)random();
+    std::string key = base64Encode(keyBytes, 16);
+    std::string request = "GET /stream?fps=" + std::to_string(fps) + " HTTP/1.1\r\nHost: " + address + "\r\n"
+                          "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + key +
+                          "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    sendAll(server, std::vector<uint8_t>(request.begin(), request.end()));
+
+    std::vector<uint8_t> input;
+    uint8_t buffer[65536];
+    size_t headerEnd = std::string::npos;
+    while(headerEnd == std::string::npos){
+        ssize_t n = recv(server, buffer, sizeof(buffer), 0);
+        if(n <= 0){
+            std::cerr << "connection closed during the handshake" << std::endl;
+            return 1;
+        }
+        input.insert(input.end(), buffer, buffer + n);
+        headerEnd = std::string(input.begin(), input.end()).find("\r\n\r\n");
+    }
+    std::string response(input.begin(), input.begin() + headerEnd);
+    input.erase(input.begin(), input.begin() + headerEnd + 4);
+    if(response.compare(0, 12, "HTTP/1.1 101") != 0 || response.find(webSocketAccept(key)) == std::string::npos){
+        std::cerr << "not a stream: " << response.substr(0, response.find("\r\n")) << std::endl;
+        return 1;
+    }
+
+    //give up waiting on the socket now and then, to print and check the time
+    timeval timeout = {0, 200000};
+    setsockopt(server, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    FrameDecoder decoder;
+    TrajectoryFrame frame;
+    WebSocketFrame message;
+    long long frames = 0, keyframes = 0, bytes = 0, failures = 0;
+    long long totalFrames = 0, totalBytes = 0;
+    uint64_t lastTick = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastPrint = start;
+    bool open = true;
+    while(open && secondsSince(start) < seconds){
+        ssize_t n = recv(server, buffer, sizeof(buffer), 0);
+        if(n == 0) break;
+        if(n > 0) input.insert(input.end(), buffer, buffer + n);
+
+        size_t used = 0;
+        while(true){
+            long long length = readWebSocketFrame(input.data() + used, input.size() - used, &message, 1u << 30);
+            if(length <= 0) break;
+            used += length;
+            if(message.opcode == kWebSocketClose){
+                open = false;
+                break;
+            }
+            if(message.opcode != kWebSocketBinary || message.payload.size() < sizeof(TrajectoryFrameHeader)) continue;
+
+            //a new header means the world changed size, and a keyframe follows
+            if(memcmp(message.payload.data(), kTrajectoryMagic, 4) == 0){
+                TrajectoryHeader header;
+                memcpy(&header, message.payload.data(), sizeof(header));
+                std::cout << "world " << header.worldWidth << " x " << header.worldHeight << std::endl;
+                continue;
+            }
+            TrajectoryFrameHeader header;
+            memcpy(&header, message.payload.data(), sizeof(header));
+            if(header.magic != kTrajectoryFrameMagic || header.payloadSize != message.payload.size() - sizeof(header) ||
+               !decoder.decode(header, message.payload.data() + sizeof(header), &frame)){
+                failures++;
+                continue;
+            }
+            frames++;
+            if(header.keyframe) keyframes++;
+            bytes += message.payload.size();
+            lastTick = frame.tick;
+            if(slow > 0) std::this_thread::sleep_for(std::chrono::milliseconds(slow));
+        }
+        input.erase(input.begin(), input.begin() + used);
+
+        if(secondsSince(lastPrint) >= 1){
+            std::cout << "tick " << lastTick << ", " << frame.size() << " birds: " << frames << " frames (" << keyframes
+                      << " keyframes), " << bytes/1024.0 << " kB" << std::endl;
+            lastPrint = std::chrono::steady_clock::now();
+            totalFrames += frames;
+            totalBytes += bytes;
+            frames = 0;
+            keyframes = 0;
+            bytes = 0;
+        }
+    }
+    totalFrames += frames;
+    totalBytes += bytes;
+
+    if(open){
+        std::vector<uint8_t> closeFrame;
+        appendWebSocketFrame(&closeFrame, kWebSocketClose, 0, 0, true, random());
+        sendAll(server, closeFrame);
+    }
+    ::close(server);
+
+    double time = secondsSince(start);
+    std::cout << totalFrames << " frames in " << time << " s (" << totalFrames/time << " a second, "
+              << (totalFrames > 0 ? totalBytes/totalFrames : 0) << " bytes each), " << failures << " failed to decode" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
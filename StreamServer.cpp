@@ -0,0 +1,569 @@
+/* StreamServer.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for StreamServer, which streams a Flock to browsers and other programs over WebSockets.
+ */
+#include "StreamServer.h"
+#include "Flock.h"
+#include "TrajectoryRecorder.h"
+#include "WebSocket.h"
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#define BIRDFLOCK_HAS_SOCKETS 1
+#endif
+
+//flags for send(). Where there is no MSG_NOSIGNAL, SO_NOSIGPIPE is set on each socket instead.
+#ifdef MSG_NOSIGNAL
+static const int kSendFlags = MSG_NOSIGNAL;
+#else
+static const int kSendFlags = 0;
+#endif
+
+//page served to a browser that opens the port. It connects back with a WebSocket and draws every frame.
+static const char* kViewerPage = R"HTML(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>Bird Flock</title>
+<style>
+body { margin: 0; background: #111; color: #ddd; font: 13px sans-serif; }
+#bar { padding: 6px 10px; }
+canvas { display: block; background: #fff; margin: 0 10px; }
+</style>
+</head>
+<body>
+<div id="bar">frames per second <input id="fps" type="number" min="1" max="120" value="20" style="width: 4em">
+<span id="status">connecting</span></div>
+<canvas id="view"></canvas>
+<script>
+"use strict";
+const kFrameMagic = 0x454d5246;
+const colours = ["#2255ee", "#22aa22", "#dd2222"];
+const canvas = document.getElementById("view");
+const context = canvas.getContext("2d");
+const status = document.getElementById("status");
+let worldWidth = 1200, worldHeight = 800, positionScale = 16, velocityScale = 1024;
+
+//the same state as TrajectoryState, so deltas decode against the last frame received
+let seen = [], species = [], values = [], frameNumber = 1, started = false;
+let frames = 0, bytes = 0;
+
+function resize() {
+    const scale = Math.min((window.innerWidth - 20)/worldWidth, (window.innerHeight - 50)/worldHeight);
+    canvas.width = Math.max(1, Math.floor(worldWidth*scale));
+    canvas.height = Math.max(1, Math.floor(worldHeight*scale));
+}
+window.addEventListener("resize", resize);
+resize();
+
+function decode(data) {
+    const view = new DataView(data);
+    const buffer = new Uint8Array(data);
+    if (buffer[0] == 66 && buffer[1] == 70 && buffer[2] == 84 && buffer[3] == 82) {
+        worldWidth = view.getInt32(8, true);
+        worldHeight = view.getInt32(12, true);
+        positionScale = view.getUint32(16, true);
+        velocityScale = view.getUint32(20, true);
+        resize();
+        return;
+    }
+    if (view.getUint32(0, true) != kFrameMagic) return;
+    const keyframe = view.getUint32(4, true) != 0;
+    const tick = view.getUint32(8, true) + view.getUint32(12, true)*4294967296;
+    const birdCount = view.getUint32(16, true);
+    const deathCount = view.getUint32(20, true);
+    let p = 32;
+    function varint() {
+        let value = 0, scale = 1, byte;
+        do {
+            byte = buffer[p++];
+            value += (byte & 127)*scale;
+            scale *= 128;
+        } while (byte & 128);
+        return value % 2 ? -(value + 1)/2 : value/2;
+    }
+
+    if (keyframe) {
+        seen = [];
+        species = [];
+        values = [];
+        frameNumber = 1;
+        started = true;
+    }
+    if (!started) return;
+    frameNumber++;
+    for (let i = 0; i < deathCount; i++) varint();
+
+    const scale = canvas.width/worldWidth;
+    context.clearRect(0, 0, canvas.width, canvas.height);
+    let id = 0;
+    for (let i = 0; i < birdCount; i++) {
+        id += varint();
+        let v;
+        if (keyframe || seen[id] !== frameNumber - 1) {
+            species[id] = buffer[p++];
+            v = [varint(), varint(), varint(), varint()];
+        }
+        else {
+            const last = values[id];
+            v = [last[0] + varint(), last[1] + varint(), last[2] + varint(), last[3] + varint()];
+        }
+        seen[id] = frameNumber;
+        values[id] = v;
+
+        const x = v[0]/positionScale*scale, y = v[1]/positionScale*scale;
+        const vx = v[2]/velocityScale, vy = v[3]/velocityScale;
+        const speed = Math.sqrt(vx*vx + vy*vy) || 1;
+        context.strokeStyle = colours[species[id]] || "#000";
+        context.beginPath();
+        context.moveTo(x - 4*vx/speed, y - 4*vy/speed);
+        context.lineTo(x + 4*vx/speed, y + 4*vy/speed);
+        context.stroke();
+    }
+    frames++;
+    status.textContent = "tick " + tick + ", " + birdCount + " birds";
+}
+
+const socket = new WebSocket((location.protocol == "https:" ? "wss://" : "ws://") + location.host + "/stream" + location.search);
+socket.binaryType = "arraybuffer";
+socket.onopen = function() { socket.send("fps " + document.getElementById("fps").value); };
+socket.onmessage = function(event) { bytes += event.data.byteLength; decode(event.data); };
+socket.onclose = function() { status.textContent += " (disconnected)"; };
+document.getElementById("fps").onchange = function() { socket.send("fps " + this.value); };
+setInterval(function() {
+    document.title = "Bird Flock - " + frames + " fps, " + Math.round(bytes/1024) + " kB/s";
+    frames = 0;
+    bytes = 0;
+}, 1000);
+</script>
+</body>
+</html>
+)HTML";
+
+//Constructor
+StreamServer::StreamServer() :
+    fListenSocket(-1), fPort(0), fStopping(false), fWatching(0), fFramesSent(0), fFramesSkipped(0)
+{
+}
+
+//Deconstructor
+StreamServer::~StreamServer(){
+    stop();
+}
+
+/* start
+ *
+ * Opens the listening socket and starts the server thread.
+ *
+ * inputs:
+ * - address: IPv4 address to listen on
+ * - port: port to listen on, or 0 for any free port
+ *
+ * return: true if the server started
+ */
+bool StreamServer::start(std::string address, int port){
+    stop();
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    sockaddr_in socketAddress;
+    memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    if(inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) return false;
+
+    int listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if(listenSocket < 0) return false;
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if(bind(listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0 ||
+       listen(listenSocket, 16) != 0){
+        close(listenSocket);
+        return false;
+    }
+    fcntl(listenSocket, F_SETFL, fcntl(listenSocket, F_GETFL) | O_NONBLOCK);
+
+    socklen_t length = sizeof(socketAddress);
+    getsockname(listenSocket, reinterpret_cast<sockaddr*>(&socketAddress), &length);
+    fPort = ntohs(socketAddress.sin_port);
+    fListenSocket = listenSocket;
+
+    fStopping = false;
+    fThread = std::thread(&StreamServer::serve, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+//stops the server thread, which disconnects every client, then closes the listening socket
+void StreamServer::stop(){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    if(fListenSocket < 0) return;
+    fStopping = true;
+    fThread.join();
+    close(fListenSocket);
+#endif
+    fListenSocket = -1;
+    fPort = 0;
+}
+
+/* publish
+ *
+ * Quantises the flock straight into the channel's free buffer and hands it to the server thread.
+ * Does nothing while no one is watching.
+ *
+ * inputs:
+ * - flock: the Flock to stream
+ */
+void StreamServer::publish(Flock* flock){
+    if(fWatching.load(std::memory_order_relaxed) == 0) return;
+
+    StreamSnapshot* snapshot = fChannel.getWriteBuffer();
+    snapshot->worldWidth = flock->getWorldWidth();
+    snapshot->worldHeight = flock->getWorldHeight();
+    TrajectoryRecorder::quantiseFlock(flock, &snapshot->frame);
+    fChannel.publishWriteBuffer();
+}
+
+/* serve
+ *
+ * Run by the server thread. Waits a short time for any socket to be ready, reads from every client
+ * that has sent something, takes the newest tick if there is one, sends it to every client that is
+ * due a frame, and accepts new connections. Disconnects everyone once stop() is called.
+ */
+void StreamServer::serve(){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    const StreamSnapshot* snapshot = 0;
+    std::vector<pollfd> sockets;
+    while(!fStopping.load()){
+        sockets.resize(fClients.size() + 1);
+        sockets[0].fd = fListenSocket;
+        sockets[0].events = POLLIN;
+        sockets[0].revents = 0;
+        for(int i=0; i<fClients.size(); i++){
+            StreamClient* client = fClients[i];
+            sockets[i+1].fd = client->socket;
+            sockets[i+1].events = POLLIN | (client->output.empty() ? 0 : POLLOUT);
+            sockets[i+1].revents = 0;
+        }
+        poll(sockets.data(), sockets.size(), fWatching.load() > 0 ? kPollMilliseconds : kIdlePollMilliseconds);
+
+        const StreamSnapshot* latest = fChannel.take();
+        if(latest) snapshot = latest;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        int kept = 0;
+        for(int i=0; i<fClients.size(); i++){
+            StreamClient* client = fClients[i];
+            bool connected = true;
+            if(sockets[i+1].revents & (POLLIN | POLLHUP | POLLERR)) connected = receive(client);
+            if(connected && snapshot) sendFrame(client, snapshot, now);
+            if(connected) connected = flush(client);
+
+            if(connected) fClients[kept++] = client;
+            else disconnect(client);
+        }
+        fClients.resize(kept);
+
+        if(sockets[0].revents & POLLIN) acceptClients();
+    }
+
+    for(int i=0; i<fClients.size(); i++){
+        disconnect(fClients[i]);
+    }
+    fClients.clear();
+#endif
+}
+
+//accepts every connection that is waiting, and sets it up to be used without blocking
+void StreamServer::acceptClients(){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    while(true){
+        int socket = accept(fListenSocket, 0, 0);
+        if(socket < 0) return;
+
+        int on = 1;
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        int sendBuffer = kSendBufferBytes;
+        setsockopt(socket, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+#ifdef SO_NOSIGPIPE
+        setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        StreamClient* client = new StreamClient();
+        client->socket = socket;
+        client->webSocket = false;
+        client->closing = false;
+        client->outputSent = 0;
+        client->framesPerSecond = kDefaultFramesPerSecond;
+        client->nextFrame = std::chrono::steady_clock::now();
+        client->wantKeyframe = true;
+        client->framesSinceKeyframe = 0;
+        client->lastTick = UINT64_MAX;
+        client->skippedTick = UINT64_MAX;
+        client->worldWidth = -1;
+        client->worldHeight = -1;
+        client->framesSent = 0;
+        client->framesSkipped = 0;
+        fClients.push_back(client);
+    }
+#endif
+}
+
+/* receive
+ *
+ * Reads everything a client has sent. Until the handshake is done that is an HTTP request; after
+ * it, WebSocket frames, which clients must always mask.
+ *
+ * inputs:
+ * - client: the client to read from
+ *
+ * return: false if the client has gone, or sent something it shouldn't have
+ */
+bool StreamServer::receive(StreamClient* client){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    uint8_t buffer[4096];
+    while(true){
+        ssize_t received = recv(client->socket, buffer, sizeof(buffer), 0);
+        if(received == 0) return false;
+        if(received < 0){
+            if(errno == EINTR) continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        client->input.insert(client->input.end(), buffer, buffer + received);
+    }
+
+    if(!client->webSocket){
+        std::string text(client->input.begin(), client->input.end());
+        size_t end = text.find("\r\n\r\n");
+        if(end == std::string::npos) return client->input.size() <= kMaxRequestBytes;
+        client->input.erase(client->input.begin(), client->input.begin() + end + 4);
+        if(!handleRequest(client, text.substr(0, end))) return false;
+        if(!client->webSocket) return true;
+    }
+
+    //every whole frame received so far
+    size_t used = 0;
+    WebSocketFrame frame;
+    while(true){
+        long long length = readWebSocketFrame(client->input.data() + used, client->input.size() - used, &frame, kMaxRequestBytes);
+        if(length < 0) return false;
+        if(length == 0) break;
+        used += length;
+        if(!frame.masked) return false;
+
+        if(frame.opcode == kWebSocketText && frame.final){
+            handleMessage(client, std::string(frame.payload.begin(), frame.payload.end()));
+        }
+        else if(frame.opcode == kWebSocketPing){
+            appendWebSocketFrame(&client->output, kWebSocketPong, frame.payload.data(), frame.payload.size());
+        }
+        else if(frame.opcode == kWebSocketClose){
+            appendWebSocketFrame(&client->output, kWebSocketClose, frame.payload.data(), std::min<size_t>(frame.payload.size(), 2));
+            client->closing = true;
+            break;
+        }
+    }
+    client->input.erase(client->input.begin(), client->input.begin() + used);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* handleRequest
+ *
+ * Either upgrades the connection to a WebSocket, serves the viewer page, or says there is nothing
+ * there.
+ *
+ * inputs:
+ * - client: the client that sent the request
+ * - request: the request line and headers
+ *
+ * return: false if the request isn't a GET
+ */
+bool StreamServer::handleRequest(StreamClient* client, const std::string& request){
+    if(request.compare(0, 4, "GET ") != 0) return false;
+    size_t pathEnd = request.find(' ', 4);
+    if(pathEnd == std::string::npos) return false;
+    std::string path = request.substr(4, pathEnd - 4);
+
+    //header names are case insensitive, so they are found in a lower case copy
+    std::string lower = request;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    std::string key;
+    size_t keyStart = lower.find("\r\nsec-websocket-key:");
+    if(keyStart != std::string::npos){
+        keyStart += 20;
+        size_t keyEnd = request.find("\r\n", keyStart);
+        key = request.substr(keyStart, keyEnd == std::string::npos ? std::string::npos : keyEnd - keyStart);
+        key.erase(0, key.find_first_not_of(" \t"));
+        key.erase(key.find_last_not_of(" \t") + 1);
+    }
+
+    std::string response;
+    if(lower.find("\r\nupgrade: websocket") != std::string::npos && !key.empty()){
+        response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                   "Sec-WebSocket-Accept: " + webSocketAccept(key) + "\r\n\r\n";
+        client->webSocket = true;
+        fWatching++;
+
+        size_t fps = path.find("fps=");
+        if(fps != std::string::npos) handleMessage(client, "fps " + path.substr(fps + 4));
+    }
+    else if(path == "/" || path.compare(0, 2, "/?") == 0 || path == "/index.html"){
+        std::string page = kViewerPage;
+        response = "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=utf-8\r\nCache-Control: no-cache\r\n"
+                   "Content-Length: " + std::to_string(page.size()) + "\r\nConnection: close\r\n\r\n" + page;
+        client->closing = true;
+    }
+    else{
+        response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        client->closing = true;
+    }
+    client->output.insert(client->output.end(), response.begin(), response.end());
+    return true;
+}
+
+/* handleMessage
+ *
+ * Acts on a text message from a client: "fps N" sets how many frames a second it gets, and "key"
+ * makes its next frame a keyframe. Anything else is ignored.
+ *
+ * inputs:
+ * - client: the client that sent the message
+ * - message: the message
+ */
+void StreamServer::handleMessage(StreamClient* client, const std::string& message){
+    if(message.compare(0, 4, "fps ") == 0){
+        double fps = atof(message.c_str() + 4);
+        if(fps > 0) client->framesPerSecond = std::min<double>(fps, kMaxFramesPerSecond);
+        client->nextFrame = std::chrono::steady_clock::now();
+    }
+    else if(message == "key"){
+        client->wantKeyframe = true;
+    }
+}
+
+/* sendFrame
+ *
+ * Encodes the newest tick for a client and queues it, if the client is due a frame and hasn't
+ * already had this tick. If the client is still taking the last frame, this one is skipped for it;
+ * as the encoder only remembers frames that were sent, the next delta is still against what the
+ * client actually has. A header is sent first if the world has changed size.
+ *
+ * inputs:
+ * - client: the client to send to
+ * - snapshot: the newest tick
+ * - now: the current time
+ */
+void StreamServer::sendFrame(StreamClient* client, const StreamSnapshot* snapshot, std::chrono::steady_clock::time_point now){
+    const TrajectoryFrame& frame = snapshot->frame;
+    if(!client->webSocket || client->closing) return;
+    if(frame.tick == client->lastTick || now < client->nextFrame) return;
+    if(!client->output.empty()){
+        if(frame.tick != client->skippedTick){
+            client->skippedTick = frame.tick;
+            client->framesSkipped++;
+            fFramesSkipped++;
+        }
+        return;
+    }
+
+    if(snapshot->worldWidth != client->worldWidth || snapshot->worldHeight != client->worldHeight){
+        TrajectoryHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, kTrajectoryMagic, 4);
+        header.version = kTrajectoryVersion;
+        header.worldWidth = snapshot->worldWidth;
+        header.worldHeight = snapshot->worldHeight;
+        header.positionScale = TrajectoryRecorder::kPositionScale;
+        header.velocityScale = TrajectoryRecorder::kVelocityScale;
+        header.keyframeInterval = kKeyframeInterval;
+        appendWebSocketFrame(&client->output, kWebSocketBinary, reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+        client->worldWidth = snapshot->worldWidth;
+        client->worldHeight = snapshot->worldHeight;
+        client->wantKeyframe = true;
+    }
+
+    //the payload is encoded straight after room for its header, which is filled in once its size is known
+    bool keyframe = client->wantKeyframe || client->framesSinceKeyframe >= kKeyframeInterval;
+    fMessage.resize(sizeof(TrajectoryFrameHeader));
+    client->encoder.encode(frame, keyframe, &fMessage);
+
+    TrajectoryFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kTrajectoryFrameMagic;
+    header.keyframe = keyframe ? 1 : 0;
+    header.tick = frame.tick;
+    header.birdCount = frame.size();
+    header.deathCount = frame.deaths.size();
+    header.payloadSize = fMessage.size() - sizeof(header);
+    memcpy(fMessage.data(), &header, sizeof(header));
+    appendWebSocketFrame(&client->output, kWebSocketBinary, fMessage.data(), fMessage.size());
+
+    client->wantKeyframe = false;
+    client->framesSinceKeyframe = keyframe ? 1 : client->framesSinceKeyframe + 1;
+    client->lastTick = frame.tick;
+    client->framesSent++;
+    fFramesSent++;
+
+    //frames are spaced evenly, unless the client has fallen more than a frame behind
+    std::chrono::steady_clock::duration interval =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0/client->framesPerSecond));
+    client->nextFrame += interval;
+    if(client->nextFrame < now) client->nextFrame = now + interval;
+}
+
+/* flush
+ *
+ * Sends as much of a client's output as its socket will take without waiting.
+ *
+ * inputs:
+ * - client: the client to send to
+ *
+ * return: false if the client has gone, or if it was closing and everything has been sent
+ */
+bool StreamServer::flush(StreamClient* client){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    while(client->outputSent < client->output.size()){
+        ssize_t sent = send(client->socket, client->output.data() + client->outputSent,
+                            client->output.size() - client->outputSent, kSendFlags);
+        if(sent < 0){
+            if(errno == EINTR) continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            return false;
+        }
+        client->outputSent += sent;
+    }
+    client->output.clear();
+    client->outputSent = 0;
+    return !client->closing;
+#else
+    return false;
+#endif
+}
+
+//closes a client's socket and frees it
+void StreamServer::disconnect(StreamClient* client){
+#ifdef BIRDFLOCK_HAS_SOCKETS
+    close(client->socket);
+#endif
+    if(client->webSocket) fWatching--;
+    delete client;
+}
@@ -0,0 +1,167 @@
+/* StreamServer.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for StreamServer, which lets a simulation be watched live from a browser or another
+ * program on the same machine or network. It listens on a TCP port; a browser that opens the port
+ * gets a small viewer page, and anything that connects with a WebSocket gets the flock streamed to
+ * it as binary messages.
+ *
+ * The stream is the trajectory format (see Trajectory.h) sent message by message: first a
+ * TrajectoryHeader, then a TrajectoryFrameHeader and its payload for every frame, quantised and
+ * delta encoded exactly as in a trajectory file, so FrameDecoder can read it. A new header is sent
+ * whenever the size of the world changes. Every client has its own encoder, so each one gets
+ * deltas against the last frame it was actually sent, and a keyframe every kKeyframeInterval
+ * frames or whenever it sends "key". A client picks how many frames a second it wants by sending
+ * "fps N" as a text message, or with ?fps=N on the address it connects to.
+ *
+ * Flock calls publish() at the end of every simulateFlock, which only quantises the flock into a
+ * buffer and hands it over through a StatsChannel, and does nothing at all while no one is
+ * watching. Everything else happens on the server's own thread. A client is only given a new frame
+ * once it has taken all of the last one, so a slow client just gets fewer frames, and can never
+ * hold up the simulation or the other clients.
+ *
+ * Only available on POSIX systems; elsewhere start() always fails.
+ */
+#ifndef STREAMSERVER_H
+#define STREAMSERVER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "Trajectory.h"
+#include "StatsChannel.h"
+
+class Flock;
+
+//one tick, as handed from publish() to the server thread
+struct StreamSnapshot
+{
+    int worldWidth;
+    int worldHeight;
+    TrajectoryFrame frame;
+};
+
+//everything the server thread knows about one connection
+struct StreamClient
+{
+    int socket;
+    bool webSocket;//whether the handshake has been done
+    bool closing;//whether to close once the output has been sent
+    std::vector<uint8_t> input;//bytes received but not yet used
+    std::vector<uint8_t> output;//bytes waiting to be sent
+    size_t outputSent;//how much of output has been sent
+
+    FrameEncoder encoder;
+    double framesPerSecond;
+    std::chrono::steady_clock::time_point nextFrame;//time the next frame is due
+    bool wantKeyframe;//whether the next frame must be a keyframe
+    int framesSinceKeyframe;
+    uint64_t lastTick;//tick of the last frame sent
+    uint64_t skippedTick;//tick of the last frame skipped, so each one is only counted once
+    int worldWidth;//world size in the last header sent
+    int worldHeight;
+
+    long long framesSent;
+    long long framesSkipped;//frames that were due while the client was still taking the last one
+};
+
+class StreamServer
+{
+public:
+
+    //Constructor
+    StreamServer();
+
+    //Deconstructor. Stops the server if it is still running.
+    virtual ~StreamServer();
+
+    /* Starts listening on address:port and starts the server thread. address is "127.0.0.1" for this
+     * machine only, or "0.0.0.0" for every network it is on. Port 0 picks a free port, which
+     * getPort() then gives. Returns false if the port couldn't be opened. */
+    bool start(std::string address, int port);
+
+    //disconnects every client and stops the server thread
+    void stop();
+
+    //hands the current state of the flock to the server thread. Called by Flock.
+    void publish(Flock* flock);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline bool const isRunning()const{return fListenSocket >= 0;}
+    inline int const getPort()const{return fPort;}
+    inline int const getClientCount()const{return fWatching.load(std::memory_order_relaxed);}
+    inline long long const getFramesSent()const{return fFramesSent.load(std::memory_order_relaxed);}
+    inline long long const getFramesSkipped()const{return fFramesSkipped.load(std::memory_order_relaxed);}
+
+    //frames a second a client gets until it asks for something else, and the most it can ask for
+    static const int kDefaultFramesPerSecond = 20;
+    static const int kMaxFramesPerSecond = 120;
+
+    //number of frames sent to a client between keyframes
+    static const int kKeyframeInterval = 100;
+
+private:
+
+    //loop run by the server thread until stop() is called
+    void serve();
+
+    //accepts every waiting connection
+    void acceptClients();
+
+    //reads what a client has sent, and acts on it. Returns false if the client has gone.
+    bool receive(StreamClient* client);
+
+    //handles the HTTP request a connection starts with. Returns false if it is not a valid request.
+    bool handleRequest(StreamClient* client, const std::string& request);
+
+    //handles one message sent by a WebSocket client
+    void handleMessage(StreamClient* client, const std::string& message);
+
+    //encodes and queues the newest frame for a client, if it wants one and is ready for it
+    void sendFrame(StreamClient* client, const StreamSnapshot* snapshot, std::chrono::steady_clock::time_point now);
+
+    //sends as much of a client's output as the socket will take. Returns false if the client has gone.
+    bool flush(StreamClient* client);
+
+    //closes the socket of a client and frees it
+    void disconnect(StreamClient* client);
+
+    int fListenSocket;
+    int fPort;
+
+    //ticks handed from publish() to the server thread
+    StatsChannel<StreamSnapshot> fChannel;
+
+    //only used by the server thread
+    std::vector<StreamClient*> fClients;
+    std::vector<uint8_t> fMessage;//encoded frame being wrapped in a WebSocket frame
+
+    std::thread fThread;
+    std::atomic<bool> fStopping;
+
+    //number of WebSocket clients, read by publish() to do nothing while there are none
+    std::atomic<int> fWatching;
+
+    //totals over every client
+    std::atomic<long long> fFramesSent;
+    std::atomic<long long> fFramesSkipped;
+
+    /* longest the server thread waits for a socket before checking for a new tick, in milliseconds,
+     * while someone is watching and while no one is */
+    static const int kPollMilliseconds = 2;
+    static const int kIdlePollMilliseconds = 100;
+
+    /* size asked for the kernel's send buffer of each client. Kept small so a slow client's frames
+     * wait here, where they can be skipped, rather than piling up out of date in the kernel. */
+    static const int kSendBufferBytes = 64*1024;
+
+    //largest request or message accepted from a client
+    static const int kMaxRequestBytes = 8192;
+};
+
+#endif // STREAMSERVER_H
@@ -0,0 +1,399 @@
+/* Sweep.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for Sweep, which runs a scenario many times with different settings.
+ */
+#include "Sweep.h"
+#include "Flock.h"
+#include "Bird.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <ctime>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+//the metrics are averaged over this last fraction of each run, so one unusual tick doesn't decide them
+static const double kMeasuredFraction = 0.1;
+
+//Constructor
+Sweep::Sweep() :
+    fMethod(kGrid), fSamples(0), fRepeats(1), fRunsAtOnce(0), fSeed(0)
+{
+}
+
+/* load
+ *
+ * Reads the scenario and its [sweep] table, then works out the configurations to run.
+ *
+ * inputs:
+ * - path: sweep file to read
+ *
+ * return: true if the file is a valid sweep. If not, getError() says what was wrong and where.
+ */
+bool Sweep::load(std::string path){
+    fParameterNames.clear();
+    fParameterValues.clear();
+    fConfigurations.clear();
+    fMethod = kGrid;
+    fSamples = 0;
+    fRepeats = 1;
+    fRunsAtOnce = 0;
+
+    if(!fScenario.load(path)){
+        fError = fScenario.getError();
+        return false;
+    }
+    if(fScenario.getTicks() <= 0){
+        fError = path + ": ticks must be set to run a sweep";
+        return false;
+    }
+    fSeed = fScenario.hasSeed() ? fScenario.getSeed() : time(NULL);
+
+    if(!readSweepTable(path)) return false;
+    makeConfigurations();
+    return true;
+}
+
+//changes the seed, and makes the configurations again as a latin hypercube depends on it
+void Sweep::setSeed(uint64_t newVal){
+    fSeed = newVal;
+    makeConfigurations();
+}
+
+/* readSweepTable
+ *
+ * Reads the settings of the sweep, and the settings to sweep, from the [sweep] table.
+ *
+ * inputs:
+ * - path: the file, for error messages
+ *
+ * return: true if the table is valid
+ */
+bool Sweep::readSweepTable(const std::string& path){
+    const std::vector<std::string>* keys = fScenario.getSweepKeys();
+    const std::vector<std::string>* values = fScenario.getSweepValues();
+
+    for(int i=0; i<keys->size(); i++){
+        const std::string& key = keys->at(i);
+        const std::string& value = values->at(i);
+        std::ostringstream where;
+        where << path << ":" << fScenario.getSweepLines()->at(i) << ": ";
+
+        double number = 0;
+        bool isNumber = Scenario::parseNumber(value, &number);
+        if(key == "method"){
+            if(value == "\"grid\"") fMethod = kGrid;
+            else if(value == "\"latin_hypercube\"") fMethod = kLatinHypercube;
+            else{
+                fError = where.str() + "method must be \"grid\" or \"latin_hypercube\"";
+                return false;
+            }
+        }
+        else if(key == "samples" || key == "repeats" || key == "runs_at_once"){
+            if(!isNumber || number < 0){
+                fError = where.str() + "expected a whole number, not " + value;
+                return false;
+            }
+            if(key == "samples") fSamples = number;
+            else if(key == "repeats") fRepeats = std::max(1, (int)number);
+            else fRunsAtOnce = number;
+        }
+        else{
+            //anything else is a setting of the scenario to sweep
+            std::vector<double> list;
+            if(!parseList(value, &list) || list.empty()){
+                fError = where.str() + "expected a [list] of values for " + key;
+                return false;
+            }
+            Scenario test = fScenario;
+            for(int j=0; j<list.size(); j++){
+                if(!test.setSetting(key, list[j])){
+                    fError = where.str() + test.getError();
+                    return false;
+                }
+            }
+            fParameterNames.push_back(key);
+            fParameterValues.push_back(list);
+        }
+    }
+
+    //check the lists suit the method, now it is known
+    if(fMethod == kLatinHypercube){
+        if(fSamples <= 0){
+            fError = path + ": samples must be set for a latin_hypercube sweep";
+            return false;
+        }
+        for(int p=0; p<fParameterValues.size(); p++){
+            if(fParameterValues[p].size() != 2){
+                fError = path + ": " + fParameterNames[p] + " must be a [min, max] range for a latin_hypercube sweep";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* parseList
+ *
+ * Reads a list of numbers written as [a, b, c].
+ *
+ * inputs:
+ * - value: the text of the value
+ * - out: the numbers are added to this
+ *
+ * return: true if value is a list of numbers
+ */
+bool Sweep::parseList(const std::string& value, std::vector<double>* out){
+    if(value.size() < 2 || value[0] != '[' || value[value.size()-1] != ']') return false;
+
+    std::stringstream items(value.substr(1, value.size()-2));
+    std::string item;
+    while(std::getline(items, item, ',')){
+        size_t begin = item.find_first_not_of(" \t");
+        if(begin == std::string::npos) continue;//allows a trailing comma
+        size_t end = item.find_last_not_of(" \t");
+
+        double number;
+        if(!Scenario::parseNumber(item.substr(begin, end - begin + 1), &number)) return false;
+        out->push_back(number);
+    }
+    return true;
+}
+
+//fills fConfigurations using the method given in the file
+void Sweep::makeConfigurations(){
+    if(fMethod == kGrid) makeGrid();
+    else makeLatinHypercube();
+}
+
+//fills fConfigurations with every combination of the listed values, the last setting changing fastest
+void Sweep::makeGrid(){
+    int count = 1;
+    for(int p=0; p<fParameterValues.size(); p++){
+        count *= fParameterValues[p].size();
+    }
+
+    fConfigurations.resize(count);
+    for(int c=0; c<count; c++){
+        int index = c;
+        fConfigurations[c].resize(fParameterValues.size());
+        for(int p=fParameterValues.size()-1; p>=0; p--){
+            int size = fParameterValues[p].size();
+            fConfigurations[c][p] = fParameterValues[p][index % size];
+            index /= size;
+        }
+    }
+}
+
+/* makeLatinHypercube
+ *
+ * Splits the range of every setting into fSamples equal slices, and gives each configuration a
+ * random point in one slice of every setting, using each slice once. The slices are matched up by
+ * shuffling them separately for each setting. The shuffles come from the sweep's seed, so the same
+ * file and seed always give the same configurations.
+ */
+void Sweep::makeLatinHypercube(){
+    Random random(fSeed);
+    fConfigurations.assign(fSamples, std::vector<double>(fParameterValues.size()));
+
+    std::vector<int> slices(fSamples);
+    for(int p=0; p<fParameterValues.size(); p++){
+        for(int i=0; i<fSamples; i++){
+            slices[i] = i;
+        }
+
+        //Fisher-Yates shuffle
+        for(int i=fSamples-1; i>0; i--){
+            std::swap(slices[i], slices[random.uniformInt(i+1)]);
+        }
+
+        double min = fParameterValues[p][0];
+        double max = fParameterValues[p][1];
+        for(int i=0; i<fSamples; i++){
+            fConfigurations[i][p] = min + (max-min)*(slices[i] + random.uniform())/fSamples;
+        }
+    }
+}
+
+/* run
+ *
+ * Runs every configuration fRepeats times, fRunsAtOnce at a time, each on its own thread. Each run
+ * writes its line of the results file as soon as it finishes, so a long sweep that is stopped part
+ * way through still leaves the runs it finished. The lines are in the order the runs finish; the
+ * run column says which run each is.
+ *
+ * inputs:
+ * - resultsPath: comma separated file to write the results to
+ * - progress: stream to write a line to as each run finishes, or null
+ *
+ * return: true if the results file could be written
+ */
+bool Sweep::run(std::string resultsPath, std::ostream* progress){
+    std::ofstream results(resultsPath.c_str());
+    if(!results){
+        fError = "can't create " + resultsPath;
+        return false;
+    }
+
+    results << "run,configuration,repeat,seed";
+    for(int p=0; p<fParameterNames.size(); p++){
+        results << "," << fParameterNames[p];
+    }
+    results << ",blue,green,red,eaten,died,blue_polarisation,green_polarisation,red_polarisation,"
+            << "blue_spread,green_spread,red_spread,seconds" << std::endl;
+    results.precision(10);
+
+    int runCount = getRunCount();
+    int finished = 0;
+    ThreadPool pool(fRunsAtOnce);
+    pool.parallelFor(runCount, 1, [&](int begin, int end, int){
+        for(int run=begin; run<end; run++){
+            SweepResult result;
+            runOne(run, &result);
+
+            int configuration = run / fRepeats;
+            std::lock_guard<std::mutex> lock(fResultsMutex);
+            results << run << "," << configuration << "," << run % fRepeats << "," << fSeed + run;
+            for(int p=0; p<fParameterNames.size(); p++){
+                results << "," << fConfigurations[configuration][p];
+            }
+            for(int species=0; species<kOtherSpecies; species++){
+                results << "," << result.birdCount[species];
+            }
+            results << "," << result.eaten << "," << result.died;
+            for(int species=0; species<kOtherSpecies; species++){
+                results << "," << result.polarisation[species];
+            }
+            for(int species=0; species<kOtherSpecies; species++){
+                results << "," << result.spread[species];
+            }
+            results << "," << result.seconds << std::endl;
+
+            finished++;
+            if(progress){
+                *progress << "run " << run << " finished in " << result.seconds << " s, "
+                          << finished << "/" << runCount << " done" << std::endl;
+            }
+        }
+    });
+
+    if(!results){
+        fError = "can't write " + resultsPath;
+        return false;
+    }
+    return true;
+}
+
+/* runOne
+ *
+ * Sets up a Flock from the scenario with one configuration's settings, runs it for the scenario's
+ * ticks on the calling thread, and summarises it.
+ *
+ * inputs:
+ * - run: which run, from 0 to getRunCount()-1
+ * - result: filled with the summary of the run
+ */
+void Sweep::runOne(int run, SweepResult* result)const{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    //the settings were checked by load, so setSetting can't fail here
+    Scenario scenario = fScenario;
+    const std::vector<double>& configuration = fConfigurations[run / fRepeats];
+    for(int p=0; p<fParameterNames.size(); p++){
+        scenario.setSetting(fParameterNames[p], configuration[p]);
+    }
+    scenario.setSeed(fSeed + run);
+    scenario.setThreads(1);
+
+    //runs share the machine's cores, so none may pin its thread to one
+    scenario.setPinThreads(false);
+
+    Flock flock;
+    scenario.apply(&flock);
+
+    for(int species=0; species<kOtherSpecies; species++){
+        result->polarisation[species] = 0;
+        result->spread[species] = 0;
+    }
+
+    long long ticks = scenario.getTicks();
+    long long measuredTicks = std::max(1LL, (long long)(ticks*kMeasuredFraction));
+    for(long long t=0; t<ticks; t++){
+        flock.simulateFlock();
+        if(t >= ticks - measuredTicks) measure(&flock, result);
+    }
+
+    for(int species=0; species<kOtherSpecies; species++){
+        result->polarisation[species] /= measuredTicks;
+        result->spread[species] /= measuredTicks;
+    }
+
+    //Birds killed in the last tick are only counted once they are removed
+    flock.removeDeadObjects();
+    const FlockCounters* counters = flock.getCounters();
+    result->eaten = 0;
+    result->died = 0;
+    for(int species=0; species<kOtherSpecies; species++){
+        result->birdCount[species] = counters->alive[species];
+        result->eaten += counters->eaten[species];
+        result->died += counters->died[species] - counters->eaten[species];
+    }
+    result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* measure
+ *
+ * Works out the polarisation and spread of each species for the current tick, and adds them to
+ * result. Polarisation is the length of the mean of the Birds' unit velocities, so 1 means they
+ * all fly the same way and near 0 means they fly every way. Spread is the rms distance of the Birds
+ * from the mean position of their species.
+ *
+ * inputs:
+ * - flock: the Flock to measure
+ * - result: the measurements are added to its polarisation and spread
+ */
+void Sweep::measure(Flock* flock, SweepResult* result){
+    double headingX[kOtherSpecies] = {0, 0, 0};
+    double headingY[kOtherSpecies] = {0, 0, 0};
+    double sumX[kOtherSpecies] = {0, 0, 0};
+    double sumY[kOtherSpecies] = {0, 0, 0};
+    double sumSquares[kOtherSpecies] = {0, 0, 0};
+    int count[kOtherSpecies] = {0, 0, 0};
+
+    std::vector<Bird*>* birds = flock->getBirds();
+    for(int i=0; i<birds->size(); i++){
+        Bird* b = birds->at(i);
+        int species = b->getSpecies();
+        if(species >= kOtherSpecies) continue;
+
+        TwoVector velocity = b->getVelocity();
+        double speed = (double)velocity.mag();
+        if(speed > 0){
+            headingX[species] += (double)velocity.x()/speed;
+            headingY[species] += (double)velocity.y()/speed;
+        }
+        TwoVector position = b->getPosition();
+        sumX[species] += (double)position.x();
+        sumY[species] += (double)position.y();
+        sumSquares[species] += (double)(position.x()*position.x() + position.y()*position.y());
+        count[species]++;
+    }
+
+    for(int species=0; species<kOtherSpecies; species++){
+        if(count[species] == 0) continue;
+        double n = count[species];
+        result->polarisation[species] += std::sqrt(headingX[species]*headingX[species] +
+                                                   headingY[species]*headingY[species])/n;
+
+        //mean squared distance from the centre = mean of squares - square of mean
+        double meanX = sumX[species]/n;
+        double meanY = sumY[species]/n;
+        result->spread[species] += std::sqrt(std::max(0.0, sumSquares[species]/n - meanX*meanX - meanY*meanY));
+    }
+}
@@ -0,0 +1,127 @@
+/* Sweep.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for Sweep, which runs one scenario many times with different settings and writes a
+ * summary of every run to a results file, for tuning the settings without dragging sliders. A sweep
+ * is a scenario file with a [sweep] table, which lists the settings to change and their values:
+ *
+ *     ticks = 1000
+ *
+ *     [species.blue]
+ *     count = 200
+ *
+ *     [sweep]
+ *     method = "grid"             # or "latin_hypercube"
+ *     samples = 100               # number of configurations, latin_hypercube only
+ *     repeats = 3                 # runs of each configuration, each with its own seed
+ *     runs_at_once = 0            # simulations run at the same time, 0 for one per core
+ *     species.blue.cohesion_strength = [0.2, 0.6, 1.0]
+ *     species.blue.separation_distance = [10, 50]
+ *
+ * Any number setting of the scenario can be swept, named by its table and key. With "grid" every
+ * combination of the listed values is run; with "latin_hypercube" each setting is given as [min, max]
+ * and samples configurations are spread over the ranges so that every setting has exactly one sample
+ * in each of samples equal slices of its range. Every run is an independent Flock on one thread,
+ * and the runs are spread over a ThreadPool, so a sweep keeps every core busy without the runs
+ * needing to share anything. Run i uses seed + i, so any run can be repeated on its own.
+ */
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <mutex>
+#include "Scenario.h"
+
+class Flock;
+
+//summary of one run of a sweep
+struct SweepResult
+{
+    int birdCount[kOtherSpecies];//Birds of each species left at the end
+    int eaten;//Birds eaten by Predators during the run
+    int died;//Birds of any species that died some other way during the run, such as by leaving the world
+    double polarisation[kOtherSpecies];//length of the mean heading, 1 if all Birds of the species fly the same way
+    double spread[kOtherSpecies];//rms distance of the Birds of the species from their centre
+    double seconds;//time the run took
+};
+
+class Sweep
+{
+public:
+
+    //the ways the configurations can be chosen
+    enum Method{kGrid, kLatinHypercube};
+
+    //Constructor
+    Sweep();
+
+    //reads a sweep file and works out the configurations. Returns false, and sets the error message, if it can't.
+    bool load(std::string path);
+
+    //runs every configuration, writing a line of resultsPath for each run. Progress is written to progress if it isn't null.
+    bool run(std::string resultsPath, std::ostream* progress = 0);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline std::string const getError()const{return fError;}
+    inline int const getConfigurationCount()const{return fConfigurations.size();}
+    inline int const getRunCount()const{return fConfigurations.size() * fRepeats;}
+    inline int const getRunsAtOnce()const{return fRunsAtOnce;}
+    inline uint64_t const getSeed()const{return fSeed;}
+
+    //setters for the settings that can also be given on the command line
+    inline void setRunsAtOnce(int newVal){fRunsAtOnce = newVal;}
+
+    //changes the seed, which also changes the configurations of a latin hypercube sweep
+    void setSeed(uint64_t newVal);
+
+private:
+
+    //reads the settings in the [sweep] table of the scenario
+    bool readSweepTable(const std::string& path);
+
+    //reads a [a, b, c] list of numbers
+    bool parseList(const std::string& value, std::vector<double>* out);
+
+    //fills fConfigurations using fMethod
+    void makeConfigurations();
+
+    //fills fConfigurations with every combination of the listed values
+    void makeGrid();
+
+    //fills fConfigurations with a Latin hypercube sample of the ranges
+    void makeLatinHypercube();
+
+    //runs one configuration with one seed
+    void runOne(int run, SweepResult* result)const;
+
+    //adds the polarisation and spread of each species in the flock to result
+    static void measure(Flock* flock, SweepResult* result);
+
+    //the scenario the configurations change
+    Scenario fScenario;
+
+    //how the configurations are chosen, and how many runs there are
+    Method fMethod;
+    int fSamples;
+    int fRepeats;
+    int fRunsAtOnce;
+    uint64_t fSeed;
+
+    //the swept settings: names, and the values listed for each in the file
+    std::vector<std::string> fParameterNames;
+    std::vector<std::vector<double> > fParameterValues;
+
+    //one list of setting values, in the order of fParameterNames, for each configuration
+    std::vector<std::vector<double> > fConfigurations;
+
+    //fResultsMutex protects the results file and the progress stream while runs finish
+    std::mutex fResultsMutex;
+    std::string fError;
+};
+
+#endif // SWEEP_H
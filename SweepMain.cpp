@@ -0,0 +1,63 @@
+/* SweepMain.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * main for BirdFlockSweep, which runs a sweep file (see Sweep.h) and writes a results file with a
+ * line for every run. Usage:
+ *
+ *     BirdFlockSweep sweep.toml results.csv [--runs-at-once N] [--seed N]
+ *
+ * The options override the settings in the sweep file.
+ */
+#include "Sweep.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+//prints how to use the program
+static void printUsage(){
+    std::cerr << "usage: BirdFlockSweep sweep.toml results.csv [--runs-at-once N] [--seed N]" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3){
+        printUsage();
+        return 1;
+    }
+
+    //read the options
+    int runsAtOnce = -1;
+    const char* seed = 0;
+    for(int i=3; i<argc; i++){
+        bool hasValue = i+1 < argc;
+        if(hasValue && strcmp(argv[i], "--runs-at-once") == 0) runsAtOnce = atoi(argv[++i]);
+        else if(hasValue && strcmp(argv[i], "--seed") == 0) seed = argv[++i];
+        else{
+            printUsage();
+            return 1;
+        }
+    }
+
+    Sweep sweep;
+    if(!sweep.load(argv[1])){
+        std::cerr << sweep.getError() << std::endl;
+        return 1;
+    }
+    if(seed) sweep.setSeed(strtoull(seed, 0, 10));
+    if(runsAtOnce >= 0) sweep.setRunsAtOnce(runsAtOnce);
+
+    std::cout << sweep.getConfigurationCount() << " configurations, " << sweep.getRunCount()
+              << " runs, seed " << sweep.getSeed() << std::endl;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(!sweep.run(argv[2], &std::cout)){
+        std::cerr << sweep.getError() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "finished in " << seconds << " s, results in " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/* ThreadPool.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for ThreadPool, a fixed set of reusable worker threads.
+ */
+#include "ThreadPool.h"
+#include "Numa.h"
+#include <algorithm>
+
+/* Constructor. Pinned threads are spread over the cores in node order, so the first threads share
+ * a node, and wrap around if there are more threads than cores. */
+ThreadPool::ThreadPool(int threadCount, bool pinned) :
+    fPinned(false), fCount(0), fChunkSize(1), fNextIndex(0), fGeneration(0), fBusyWorkers(0), fStopping(false)
+{
+    if(threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if(pinned){
+        std::vector<std::vector<int> > nodes = coresByNode();
+        std::vector<int> cores, coreNodes;
+        for(int n=0; n<nodes.size(); n++){
+            cores.insert(cores.end(), nodes[n].begin(), nodes[n].end());
+            coreNodes.insert(coreNodes.end(), nodes[n].size(), n);
+        }
+        for(int t=0; t<threadCount && !cores.empty(); t++){
+            fThreadCores.push_back(cores[t % cores.size()]);
+            fThreadNodes.push_back(coreNodes[t % cores.size()]);
+        }
+        fPinned = !cores.empty() && !threadCores().empty();
+    }
+    for(int t=1; t<threadCount; t++){
+        fWorkers.push_back(std::thread(&ThreadPool::work, this, t));
+    }
+}
+
+//Deconstructor
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStopping = true;
+    }
+    fJobStarted.notify_all();
+    for(int t=0; t<fWorkers.size(); t++){
+        fWorkers[t].join();
+    }
+}
+
+/* parallelFor
+ *
+ * Publishes the job to the workers, works on it from the calling thread, then waits for every
+ * worker to finish its last chunk. Small ranges are run straight away on the calling thread, as
+ * waking the workers would take longer than the work. If the pool is pinned, the calling thread is
+ * pinned to thread 0's core for the job, and put back on the cores it had before it returns, so
+ * whatever else it runs isn't tied to that core.
+ *
+ * inputs:
+ * - count: number of indices in the range
+ * - chunkSize: number of indices handed out at a time
+ * - function: callable taking (int begin, int end, int thread)
+ */
+void ThreadPool::parallelFor(int count, int chunkSize, std::function<void(int, int, int)> function){
+    if(count <= 0) return;
+    chunkSize = std::max(1, chunkSize);
+
+    std::vector<int> callerCores;
+    if(fPinned){
+        callerCores = threadCores();
+        pinThread(std::vector<int>(1, fThreadCores[0]));
+    }
+    runJob(count, chunkSize, function);
+    if(fPinned) pinThread(callerCores);
+}
+
+//runs a job from parallelFor on the calling thread and the workers
+void ThreadPool::runJob(int count, int chunkSize, std::function<void(int, int, int)>& function){
+    if(fWorkers.empty() || count <= chunkSize){
+        function(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fFunction = function;
+        fCount = count;
+        fChunkSize = chunkSize;
+        fNextIndex = 0;
+        fBusyWorkers = fWorkers.size();
+        fGeneration++;
+    }
+    fJobStarted.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(fMutex);
+    fJobFinished.wait(lock, [this]{return fBusyWorkers == 0;});
+    fFunction = nullptr;
+}
+
+//loop run by each worker
+void ThreadPool::work(int thread){
+    if(fPinned) pinThread(std::vector<int>(1, fThreadCores[thread]));
+    long long seenGeneration = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fJobStarted.wait(lock, [&]{return fStopping || fGeneration != seenGeneration;});
+            if(fStopping) return;
+            seenGeneration = fGeneration;
+        }
+
+        runChunks(thread);
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        if(--fBusyWorkers == 0) fJobFinished.notify_one();
+    }
+}
+
+//takes chunks of the current job until the whole range has been handed out, or of the thread's own share if pinned
+void ThreadPool::runChunks(int thread){
+    if(fPinned){
+        //shares are whole chunks, so chunks start at the same places as when they are handed out
+        int threads = getThreadCount();
+        long long chunks = ((long long)fCount + fChunkSize - 1)/fChunkSize;
+        int first = (int)(chunks*thread/threads), last = (int)(chunks*(thread + 1)/threads);
+        for(int chunk=first; chunk<last; chunk++){
+            int begin = chunk*fChunkSize;
+            fFunction(begin, std::min(fCount, begin + fChunkSize), thread);
+        }
+        return;
+    }
+    while(true){
+        int begin = fNextIndex.fetch_add(fChunkSize);
+        if(begin >= fCount) return;
+        fFunction(begin, std::min(fCount, begin + fChunkSize), thread);
+    }
+}
@@ -0,0 +1,85 @@
+/* ThreadPool.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for ThreadPool, a fixed set of worker threads that are started once and then reused,
+ * so work can be split between threads every tick without paying to start new threads each time
+ * (see Parallel.h for the simpler version used when drawing). parallelFor hands out the range in
+ * small chunks so fast threads take more of the work, which means the split between threads changes
+ * from run to run: callers must make sure the result of each index doesn't depend on which thread
+ * ran it or when, for example by only writing to that index's own data.
+ *
+ * A pinned pool instead ties each thread to a core, filling the cores of one NUMA node before
+ * moving on to the next (see Numa.h), and gives each thread the same share of every range, so a
+ * thread works on the same data every time, from the same node.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class ThreadPool
+{
+public:
+
+    /* Constructor. Starts threadCount-1 workers (the calling thread is the last one). 0 means one per
+     * core. If pinned, the thread calling parallelFor is pinned too, but only until it returns. */
+    ThreadPool(int threadCount = 0, bool pinned = false);
+
+    //Deconstructor. Stops and joins the workers.
+    virtual ~ThreadPool();
+
+    //number of threads that run work, including the calling thread
+    inline int const getThreadCount()const{return fWorkers.size() + 1;}
+
+    //whether the threads are pinned, and the NUMA node each is pinned to (-1 if not pinned)
+    inline bool const isPinned()const{return fPinned;}
+    inline int const getThreadNode(int thread)const{return fPinned ? fThreadNodes[thread] : -1;}
+
+    /* Calls function(begin, end, thread) for chunks of the range [0, count) until the whole range is
+     * done, spreading the chunks over all the threads. The calling thread works too, and the method
+     * only returns once every chunk is finished. thread is always < getThreadCount(). If the pool
+     * is pinned, thread t always gets the t-th of getThreadCount() equal parts of the range, and the
+     * calling thread, as thread 0, is pinned to thread 0's core while it works, then given back the
+     * cores it had. */
+    void parallelFor(int count, int chunkSize, std::function<void(int, int, int)> function);
+
+private:
+
+    //runs a job from parallelFor, once the calling thread is pinned if it needs to be
+    void runJob(int count, int chunkSize, std::function<void(int, int, int)>& function);
+
+    //loop run by each worker, waiting for work from parallelFor
+    void work(int thread);
+
+    //takes chunks of the current job until there are none left
+    void runChunks(int thread);
+
+    std::vector<std::thread> fWorkers;
+
+    //pinning: whether the threads are, and the core and node of each thread
+    bool fPinned;
+    std::vector<int> fThreadCores;
+    std::vector<int> fThreadNodes;
+
+    //the current job, set by parallelFor
+    std::function<void(int, int, int)> fFunction;
+    int fCount;
+    int fChunkSize;
+    std::atomic<int> fNextIndex;
+
+    //fGeneration goes up by one for every job, so workers know when there is a new one
+    std::mutex fMutex;
+    std::condition_variable fJobStarted;
+    std::condition_variable fJobFinished;
+    long long fGeneration;
+    int fBusyWorkers;
+    bool fStopping;
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,200 @@
+/* TileTransport.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for TileTransport. Every message is sent as its length, 8 bytes in little endian
+ * order, followed by the message itself.
+ */
+#include "TileTransport.h"
+#include "SocketTransport.h"
+#include "SharedMemoryTransport.h"
+#include <cstdlib>
+#include <chrono>
+
+//std::chrono::seconds takes these by reference, so they need a definition as well as a value
+const int TileTransport::kConnectSeconds;
+const int TileTransport::kTimeoutSeconds;
+
+//Constructor
+TileTransport::TileTransport(int rank, int size){
+    fRank = rank;
+    fSize = size;
+    fBytesSent = 0;
+    fBytesReceived = 0;
+}
+
+//Deconstructor
+TileTransport::~TileTransport(){
+}
+
+/* create
+ *
+ * inputs:
+ * - spec: which transport to use and where, as described in TileTransport.h
+ * - rank: rank of this process
+ * - size: number of processes
+ * - peers: ranks of the processes this one exchanges messages with
+ * - error: set to what went wrong, if anything does
+ *
+ * return: the connected transport, which the caller owns, or 0 if it couldn't be made
+ */
+TileTransport* TileTransport::create(const std::string& spec, int rank, int size, const std::vector<int>& peers, std::string* error){
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::string where = colon == std::string::npos ? "" : spec.substr(colon + 1);
+    if(where.empty() || (kind != "unix" && kind != "tcp" && kind != "shm")){
+        *error = "unknown transport \"" + spec + "\": expected unix:path, tcp:host[,host...]:port or shm:name";
+        return 0;
+    }
+
+    bool connected = false;
+    TileTransport* transport = 0;
+    if(kind == "shm"){
+        SharedMemoryTransport* shm = new SharedMemoryTransport(rank, size);
+        connected = shm->open(where, peers);
+        transport = shm;
+    }
+    else if(kind == "unix"){
+        SocketTransport* socket = new SocketTransport(rank, size);
+        connected = socket->openUnix(where, peers);
+        transport = socket;
+    }
+    else{
+        //everything after the last colon is the port, and everything before it the hosts
+        size_t portColon = where.rfind(':');
+        if(portColon == std::string::npos || portColon == 0){
+            *error = "transport \"" + spec + "\" has no port";
+            return 0;
+        }
+        std::vector<std::string> hosts;
+        std::string list = where.substr(0, portColon);
+        size_t start = 0;
+        while(start <= list.size()){
+            size_t comma = list.find(',', start);
+            if(comma == std::string::npos) comma = list.size();
+            if(comma > start) hosts.push_back(list.substr(start, comma - start));
+            start = comma + 1;
+        }
+        SocketTransport* socket = new SocketTransport(rank, size);
+        connected = socket->openTcp(hosts, atoi(where.c_str() + portColon + 1), peers);
+        transport = socket;
+    }
+
+    if(!connected){
+        *error = transport->getError();
+        delete transport;
+        return 0;
+    }
+    return transport;
+}
+
+/* exchange
+ *
+ * Moves every message a piece at a time, going round the peers sending whatever each can take
+ * and receiving whatever each has sent, and waiting only when nothing could be moved at all. So
+ * no peer is ever waited on while another has something to move, which is what keeps a ring of
+ * processes that all send before they receive from locking up.
+ *
+ * inputs:
+ * - outgoing: one message for each peer
+ * - incoming: resized to the number of peers, and set to the message from each
+ *
+ * return: true if every message was sent and received
+ */
+bool TileTransport::exchange(const std::vector<std::vector<uint8_t> >& outgoing, std::vector<std::vector<uint8_t> >* incoming){
+    int peerCount = fPeers.size();
+    if(outgoing.size() != peerCount){
+        fError = "a message is needed for every peer";
+        return false;
+    }
+    incoming->resize(peerCount);
+
+    //the length of each message goes in front of it
+    std::vector<uint8_t> sendLengths(8*peerCount, 0), receiveLengths(8*peerCount, 0);
+    for(int i=0; i<peerCount; i++){
+        uint64_t length = outgoing[i].size();
+        for(int b=0; b<8; b++) sendLengths[8*i + b] = (uint8_t)(length >> (8*b));
+    }
+    std::vector<size_t> sent(peerCount, 0), received(peerCount, 0);
+    std::vector<unsigned char> sending(peerCount, 1), receiving(peerCount, 1);
+
+    int idleRounds = 0;
+    int remaining = 2*peerCount;
+    std::chrono::steady_clock::time_point lastProgress = std::chrono::steady_clock::now();
+    while(remaining > 0){
+        bool progress = false;
+        for(int i=0; i<peerCount; i++){
+            if(!sending[i]) continue;
+            const uint8_t* data;
+            size_t size;
+            if(sent[i] < 8){
+                data = &sendLengths[8*i] + sent[i];
+                size = 8 - sent[i];
+            }
+            else{
+                data = outgoing[i].data() + (sent[i] - 8);
+                size = outgoing[i].size() - (sent[i] - 8);
+            }
+            long long n = size > 0 ? sendSome(i, data, size) : 0;
+            if(n < 0) return false;
+            sent[i] += n;
+            fBytesSent += n;
+            progress |= n > 0;
+            if(sent[i] == 8 + outgoing[i].size()){
+                sending[i] = 0;
+                remaining--;
+            }
+        }
+
+        for(int i=0; i<peerCount; i++){
+            if(!receiving[i]) continue;
+            std::vector<uint8_t>& message = incoming->at(i);
+            long long n;
+            if(received[i] < 8){
+                n = receiveSome(i, &receiveLengths[8*i] + received[i], 8 - received[i]);
+                if(n < 0) return false;
+                received[i] += n;
+
+                //once the length is in, make room for the message
+                if(received[i] == 8){
+                    uint64_t length = 0;
+                    for(int b=0; b<8; b++) length |= (uint64_t)receiveLengths[8*i + b] << (8*b);
+                    if(length > kMaxMessageBytes){
+                        fError = "message from rank " + std::to_string(fPeers[i]) + " is too big";
+                        return false;
+                    }
+                    message.resize(length);
+                }
+            }
+            else{
+                n = receiveSome(i, message.data() + (received[i] - 8), message.size() - (received[i] - 8));
+                if(n < 0) return false;
+                received[i] += n;
+            }
+            fBytesReceived += n;
+            progress |= n > 0;
+            if(received[i] >= 8 && received[i] == 8 + message.size()){
+                receiving[i] = 0;
+                remaining--;
+            }
+        }
+
+        if(progress){
+            idleRounds = 0;
+            lastProgress = std::chrono::steady_clock::now();
+        }
+        else if(remaining > 0){
+            if(std::chrono::steady_clock::now() - lastProgress > std::chrono::seconds(kTimeoutSeconds)){
+                for(int i=0; i<peerCount; i++){
+                    if(sending[i] || receiving[i]){
+                        fError = "rank " + std::to_string(fPeers[i]) + " stopped answering";
+                        break;
+                    }
+                }
+                return false;
+            }
+            wait(sending, receiving, ++idleRounds);
+        }
+    }
+    return true;
+}
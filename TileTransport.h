@@ -0,0 +1,91 @@
+/* TileTransport.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for TileTransport, the connection between the processes of a distributed run (see
+ * DistributedFlock.h). Each process has a rank, from 0 to size-1, and is connected only to its
+ * peers: the processes simulating the tiles next to its own. The only thing a transport can do is
+ * exchange(): send one message to every peer and receive one from every peer, all at the same
+ * time, so that two processes sending to each other never wait on each other.
+ *
+ * The messages are framed and moved here; a subclass only has to move bytes. SocketTransport does
+ * that over Unix sockets, between processes on one machine, or over TCP, between machines;
+ * SharedMemoryTransport does it through rings in shared memory, between processes on one machine.
+ * create() makes whichever one a spec names:
+ *
+ *     unix:/tmp/birdflock          Unix sockets at /tmp/birdflock.<rank>
+ *     tcp:host[,host...]:port      rank r listens on port + r, on host number r of the list (modulo its length)
+ *     shm:/birdflock               shared memory rings called /birdflock-<from>-<to>
+ */
+#ifndef TILETRANSPORT_H
+#define TILETRANSPORT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class TileTransport
+{
+public:
+
+    //Constructor
+    TileTransport(int rank, int size);
+
+    //Deconstructor
+    virtual ~TileTransport();
+
+    /* Makes the transport described by spec, for the process with the given rank, and connects it to
+     * each of its peers, waiting up to kConnectSeconds for them to start. Returns 0, and sets error,
+     * if the spec isn't valid or a peer couldn't be reached. */
+    static TileTransport* create(const std::string& spec, int rank, int size, const std::vector<int>& peers, std::string* error);
+
+    /* Sends outgoing[i] to peer i and receives a message from each peer into incoming[i], in the
+     * order of getPeers(). Returns false, and sets the error, if a peer goes or stops answering
+     * for kTimeoutSeconds. */
+    bool exchange(const std::vector<std::vector<uint8_t> >& outgoing, std::vector<std::vector<uint8_t> >* incoming);
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline int const getRank()const{return fRank;}
+    inline int const getSize()const{return fSize;}
+    inline const std::vector<int>* getPeers()const{return &fPeers;}
+    inline std::string const getError()const{return fError;}
+    inline long long const getBytesSent()const{return fBytesSent;}
+    inline long long const getBytesReceived()const{return fBytesReceived;}
+
+    //longest to wait for the peers to start, and for a peer to answer during an exchange
+    static const int kConnectSeconds = 30;
+    static const int kTimeoutSeconds = 60;
+
+    //largest message accepted
+    static const uint64_t kMaxMessageBytes = 1ull << 32;
+
+protected:
+
+    /* sends as many of the bytes as can be sent to peer number peer without waiting. Returns the
+     * number sent, or -1 and sets fError if the peer has gone. */
+    virtual long long sendSome(int peer, const uint8_t* data, size_t size) = 0;
+
+    /* receives as many bytes as have arrived from peer number peer, up to size, without waiting.
+     * Returns the number received, or -1 and sets fError if the peer has gone. */
+    virtual long long receiveSome(int peer, uint8_t* data, size_t size) = 0;
+
+    /* waits a little for something to send to or receive from the peers marked in sending and
+     * receiving. idleRounds is how many times in a row nothing has happened. */
+    virtual void wait(const std::vector<unsigned char>& sending, const std::vector<unsigned char>& receiving, int idleRounds) = 0;
+
+    int fRank;
+    int fSize;
+    std::vector<int> fPeers;
+    std::string fError;
+
+private:
+
+    //bytes moved by exchange, including the lengths in front of the messages
+    long long fBytesSent;
+    long long fBytesReceived;
+};
+
+#endif // TILETRANSPORT_H
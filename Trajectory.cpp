@@ -0,0 +1,221 @@
+/* Trajectory.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for the trajectory file format. Contains the encoder and decoder for frame payloads.
+ *
+ * A payload is the ids of the birds that died (each stored as the difference from the previous
+ * id), followed by every bird in the frame. Each bird is its id (as a difference from the previous
+ * bird's id), then either its species and absolute x, y, vx, vy (in keyframes, or if the bird
+ * wasn't in the previous frame), or just the change in x, y, vx, vy since the previous frame. All
+ * numbers are zigzag encoded variable length integers, so small changes only take one byte.
+ */
+#include "Trajectory.h"
+
+//-------------------------- variable length integer helpers --------------------------//
+
+//maps signed integers to unsigned ones so that small negative numbers are also small: 0,-1,1,-2... -> 0,1,2,3...
+inline static uint32_t zigzag(int32_t value){return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);}
+inline static int32_t unzigzag(uint32_t value){return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);}
+
+//appends a value using 7 bits per byte, with the top bit set on every byte but the last
+inline static void putVarint(std::vector<uint8_t>* out, int32_t signedValue){
+    uint32_t value = zigzag(signedValue);
+    while(value >= 0x80){
+        out->push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back((uint8_t)value);
+}
+
+//reads a value written by putVarint, moving p along. Returns false if the data runs out first.
+inline static bool getVarint(const uint8_t*& p, const uint8_t* end, int32_t* signedValue){
+    uint32_t value = 0;
+    for(int shift=0; shift<35; shift+=7){
+        if(p >= end) return false;
+        uint8_t byte = *p++;
+        value |= (uint32_t)(byte & 0x7f) << shift;
+        if(!(byte & 0x80)){
+            *signedValue = unzigzag(value);
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------ TrajectoryFrame ------------------------------------//
+
+void TrajectoryFrame::clear(){
+    ids.clear();
+    species.clear();
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    deaths.clear();
+}
+
+void TrajectoryFrame::resize(int birdCount){
+    ids.resize(birdCount);
+    species.resize(birdCount);
+    x.resize(birdCount);
+    y.resize(birdCount);
+    vx.resize(birdCount);
+    vy.resize(birdCount);
+}
+
+void TrajectoryFrame::push(int32_t id, uint8_t s, int32_t px, int32_t py, int32_t pvx, int32_t pvy){
+    ids.push_back(id);
+    species.push_back(s);
+    x.push_back(px);
+    y.push_back(py);
+    vx.push_back(pvx);
+    vy.push_back(pvy);
+}
+
+//------------------------------------ TrajectoryState ------------------------------------//
+
+TrajectoryState::TrajectoryState(){
+    reset();
+}
+
+/* reset
+ * Frame numbers start at 1 after a reset and fSeen is all zeros, so nothing is known until
+ * a frame has been stored.
+ */
+void TrajectoryState::reset(){
+    fFrame = 1;
+    fSeen.clear();
+    fSpecies.clear();
+    fValues.clear();
+}
+
+void TrajectoryState::store(int32_t id, uint8_t species, int32_t x, int32_t y, int32_t vx, int32_t vy){
+    if(id >= fSeen.size()){
+        //grow with some spare room, as new ids are given out in increasing order
+        int size = id + id/2 + 1024;
+        fSeen.resize(size, 0);
+        fSpecies.resize(size, 0);
+        fValues.resize(4*size, 0);
+    }
+    fSeen[id] = fFrame;
+    fSpecies[id] = species;
+    int32_t* values = &fValues[4*id];
+    values[0] = x;
+    values[1] = y;
+    values[2] = vx;
+    values[3] = vy;
+}
+
+//------------------------------------ FrameEncoder ------------------------------------//
+
+FrameEncoder::FrameEncoder(){}
+
+/* encode
+ *
+ * inputs:
+ * - frame: the frame to encode
+ * - keyframe: whether to store absolute values for every bird
+ * - out: vector the payload is appended to
+ */
+void FrameEncoder::encode(const TrajectoryFrame& frame, bool keyframe, std::vector<uint8_t>* out){
+    size_t start = out->size();
+    fState.nextFrame();
+
+    int32_t previousId = 0;
+    for(int i=0; i<frame.deaths.size(); i++){
+        putVarint(out, frame.deaths[i] - previousId);
+        previousId = frame.deaths[i];
+    }
+
+    previousId = 0;
+    for(int i=0; i<frame.size(); i++){
+        int32_t id = frame.ids[i];
+        putVarint(out, id - previousId);
+        previousId = id;
+
+        if(keyframe || !fState.known(id)){
+            out->push_back(frame.species[i]);
+            putVarint(out, frame.x[i]);
+            putVarint(out, frame.y[i]);
+            putVarint(out, frame.vx[i]);
+            putVarint(out, frame.vy[i]);
+        }
+        else{
+            const int32_t* last = fState.values(id);
+            putVarint(out, frame.x[i] - last[0]);
+            putVarint(out, frame.y[i] - last[1]);
+            putVarint(out, frame.vx[i] - last[2]);
+            putVarint(out, frame.vy[i] - last[3]);
+        }
+        fState.store(id, frame.species[i], frame.x[i], frame.y[i], frame.vx[i], frame.vy[i]);
+    }
+
+    //pad so the next frame header is 8 byte aligned
+    while((out->size() - start) % 8 != 0){
+        out->push_back(0);
+    }
+}
+
+//------------------------------------ FrameDecoder ------------------------------------//
+
+FrameDecoder::FrameDecoder() : fStarted(false){}
+
+/* decode
+ *
+ * inputs:
+ * - header: header of the frame
+ * - payload: the payloadSize bytes after the header
+ * - out: frame to fill. Emptied first.
+ *
+ * return: true if the frame was decoded
+ */
+bool FrameDecoder::decode(const TrajectoryFrameHeader& header, const uint8_t* payload, TrajectoryFrame* out){
+    out->clear();
+    out->tick = header.tick;
+
+    bool keyframe = header.keyframe != 0;
+    if(keyframe){
+        fState.reset();
+        fStarted = true;
+    }
+    if(!fStarted) return false;
+    fState.nextFrame();
+
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + header.payloadSize;
+
+    int32_t id = 0;
+    for(int i=0; i<header.deathCount; i++){
+        int32_t delta;
+        if(!getVarint(p, end, &delta)) return false;
+        id += delta;
+        out->deaths.push_back(id);
+    }
+
+    id = 0;
+    for(int i=0; i<header.birdCount; i++){
+        int32_t delta, values[4];
+        if(!getVarint(p, end, &delta)) return false;
+        id += delta;
+        if(id < 0) return false;
+
+        uint8_t species;
+        bool absolute = keyframe || !fState.known(id);
+        if(absolute){
+            if(p >= end) return false;
+            species = *p++;
+        }
+        else{
+            species = fState.species(id);
+        }
+        for(int v=0; v<4; v++){
+            if(!getVarint(p, end, &values[v])) return false;
+            if(!absolute) values[v] += fState.values(id)[v];
+        }
+
+        fState.store(id, species, values[0], values[1], values[2], values[3]);
+        out->push(id, species, values[0], values[1], values[2], values[3]);
+    }
+    return true;
+}
@@ -0,0 +1,157 @@
+/* Trajectory.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for the trajectory file format, used to record a simulation and play it back
+ * later. A trajectory file is a TrajectoryHeader, followed by one frame per recorded tick,
+ * followed by an index of all the frames and a TrajectoryFooter. Every frame is a
+ * TrajectoryFrameHeader followed by its encoded payload. All structs are fixed size, little
+ * endian and 8 byte aligned in the file, so a file can be memory mapped and read in place.
+ *
+ * Positions and velocities are stored as integers (quantised), and most frames only store the
+ * change since the previous frame (delta frames). Every keyframeInterval frames a keyframe
+ * stores absolute values instead, so playback can start from any keyframe. FrameEncoder and
+ * FrameDecoder turn TrajectoryFrames into payloads and back.
+ */
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//magic numbers at the start of the header and footer, and the version of the format
+const char kTrajectoryMagic[4] = {'B','F','T','R'};
+const char kTrajectoryIndexMagic[4] = {'B','F','T','I'};
+const uint32_t kTrajectoryFrameMagic = 0x454d5246;//"FRME"
+const uint32_t kTrajectoryVersion = 1;
+
+//start of the file
+struct TrajectoryHeader{
+    char magic[4];//kTrajectoryMagic
+    uint32_t version;//kTrajectoryVersion
+    int32_t worldWidth;
+    int32_t worldHeight;
+    uint32_t positionScale;//number of quantisation steps per unit of distance
+    uint32_t velocityScale;//number of quantisation steps per unit of speed
+    uint32_t keyframeInterval;//number of frames between keyframes
+    uint32_t reserved;
+};
+
+//start of every frame
+struct TrajectoryFrameHeader{
+    uint32_t magic;//kTrajectoryFrameMagic
+    uint32_t keyframe;//1 if keyframe, 0 if delta frame
+    uint64_t tick;//tick of the simulation this frame was recorded at
+    uint32_t birdCount;
+    uint32_t deathCount;
+    uint64_t payloadSize;//bytes of payload after this header, including padding to a multiple of 8
+};
+
+//one entry of the index at the end of the file for every frame
+struct TrajectoryIndexEntry{
+    uint64_t tick;
+    uint64_t offset;//position in the file of the TrajectoryFrameHeader
+    uint64_t keyframe;//index of the entry of the keyframe this frame is decoded from
+};
+
+//end of the file
+struct TrajectoryFooter{
+    uint64_t indexOffset;//position in the file of the first TrajectoryIndexEntry
+    uint64_t frameCount;//number of index entries
+    char magic[4];//kTrajectoryIndexMagic
+    uint32_t version;
+};
+
+/* TrajectoryFrame
+ *
+ * The state of the flock at one tick, stored as separate arrays for each quantity. Positions
+ * and velocities are already quantised using the scales in the header. deaths holds the ids of
+ * the birds removed from the flock since the previous recorded frame.
+ */
+struct TrajectoryFrame{
+    uint64_t tick;
+    std::vector<int32_t> ids;
+    std::vector<uint8_t> species;
+    std::vector<int32_t> x;
+    std::vector<int32_t> y;
+    std::vector<int32_t> vx;
+    std::vector<int32_t> vy;
+    std::vector<int32_t> deaths;
+
+    inline int size()const{return ids.size();}
+
+    //empties all arrays, keeping their memory
+    void clear();
+
+    //sets the number of birds, keeping memory when shrinking so the arrays can be filled by index
+    void resize(int birdCount);
+
+    //adds one bird to the end of the arrays
+    void push(int32_t id, uint8_t species, int32_t x, int32_t y, int32_t vx, int32_t vy);
+};
+
+/* Stores the last quantised state of each bird id, so frames can be delta encoded against it.
+ * fSeen is the number of the frame the id was last in, so an id only counts as known if it was
+ * in the frame immediately before. Shared by FrameEncoder and FrameDecoder so both sides always
+ * agree on which values a delta is relative to. */
+class TrajectoryState{
+public:
+    TrajectoryState();
+
+    //forgets all birds, so the next frame must be a keyframe
+    void reset();
+
+    //starts the next frame
+    inline void nextFrame(){fFrame++;}
+
+    //whether the bird was in the previous frame
+    inline bool known(int32_t id)const{return id < fSeen.size() && fSeen[id] == fFrame-1;}
+
+    //stores the values of a bird in the current frame
+    void store(int32_t id, uint8_t species, int32_t x, int32_t y, int32_t vx, int32_t vy);
+
+    //the last stored values of a bird, valid if known(id)
+    inline uint8_t species(int32_t id)const{return fSpecies[id];}
+    inline const int32_t* values(int32_t id)const{return &fValues[4*id];}
+
+private:
+    uint64_t fFrame;
+    std::vector<uint64_t> fSeen;
+    std::vector<uint8_t> fSpecies;
+    std::vector<int32_t> fValues;//x, y, vx, vy for each id
+};
+
+//Encodes TrajectoryFrames into payloads, keeping the state needed for delta frames.
+class FrameEncoder{
+public:
+    FrameEncoder();
+
+    //forgets the previous frame
+    inline void reset(){fState.reset();}
+
+    //appends the payload of frame to out, padded to a multiple of 8 bytes
+    void encode(const TrajectoryFrame& frame, bool keyframe, std::vector<uint8_t>* out);
+
+private:
+    TrajectoryState fState;
+};
+
+//Decodes payloads back into TrajectoryFrames. Frames must be decoded in order, starting from a keyframe.
+class FrameDecoder{
+public:
+    FrameDecoder();
+
+    //forgets the previous frame
+    inline void reset(){fState.reset();}
+
+    /* decodes the payload of a frame into out. Returns false if the payload is corrupt, or if it is a
+     * delta frame and the previous frame wasn't decoded */
+    bool decode(const TrajectoryFrameHeader& header, const uint8_t* payload, TrajectoryFrame* out);
+
+private:
+    TrajectoryState fState;
+    bool fStarted;//whether a keyframe has been decoded since the last reset
+};
+
+#endif // TRAJECTORY_H
@@ -0,0 +1,194 @@
+/* TrajectoryReader.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for TrajectoryReader, which memory maps a trajectory file written by
+ * TrajectoryRecorder and decodes any frame of it.
+ */
+#include "TrajectoryReader.h"
+#include <cstring>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//Constructor
+TrajectoryReader::TrajectoryReader() :
+    fData(0), fSize(0), fIndex(0), fFrameCount(0), fCurrentFrame(-1){}
+
+//Deconstructor
+TrajectoryReader::~TrajectoryReader(){
+    close();
+}
+
+/* open
+ *
+ * Maps the whole file into memory and checks the header. The index is taken from the end of
+ * the file if the recording was closed properly, or rebuilt by scanning the frames if it wasn't
+ * (for example if the simulator crashed while recording).
+ *
+ * inputs:
+ * - path: file to open
+ *
+ * return: true if the file is a trajectory file
+ */
+bool TrajectoryReader::open(std::string path){
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(TrajectoryHeader)){
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);//the mapping stays valid after the file is closed
+    if(data == MAP_FAILED) return false;
+
+    fData = (const uint8_t*)data;
+    fSize = info.st_size;
+
+    if(memcmp(getHeader()->magic, kTrajectoryMagic, 4) != 0 || getHeader()->version != kTrajectoryVersion){
+        close();
+        return false;
+    }
+
+    //use the index at the end of the file if it is there and fits inside the file
+    const TrajectoryFooter* footer = (const TrajectoryFooter*)(fData + fSize - sizeof(TrajectoryFooter));
+    if(fSize >= sizeof(TrajectoryHeader) + sizeof(TrajectoryFooter) && memcmp(footer->magic, kTrajectoryIndexMagic, 4) == 0 &&
+       footer->indexOffset + footer->frameCount*sizeof(TrajectoryIndexEntry) + sizeof(TrajectoryFooter) == fSize){
+        fIndex = (const TrajectoryIndexEntry*)(fData + footer->indexOffset);
+        fFrameCount = footer->frameCount;
+    }
+    else{
+        scanFrames();
+    }
+
+    //the recording is read mostly forwards, so let the OS read ahead
+    madvise((void*)fData, fSize, MADV_SEQUENTIAL);
+    return true;
+}
+
+//unmaps the file and forgets the index
+void TrajectoryReader::close(){
+    if(fData){
+        munmap((void*)fData, fSize);
+    }
+    fData = 0;
+    fSize = 0;
+    fIndex = 0;
+    fScannedIndex.clear();
+    fFrameCount = 0;
+    fCurrentFrame = -1;
+    fDecoder.reset();
+}
+
+/* scanFrames
+ *
+ * Walks from frame header to frame header to rebuild the index. Stops at the first header that
+ * is missing or incomplete, so a recording cut off part way through a frame still opens.
+ */
+void TrajectoryReader::scanFrames(){
+    fScannedIndex.clear();
+    uint64_t offset = sizeof(TrajectoryHeader);
+    uint64_t keyframe = 0;
+    bool foundKeyframe = false;
+
+    while(offset + sizeof(TrajectoryFrameHeader) <= fSize){
+        const TrajectoryFrameHeader* header = (const TrajectoryFrameHeader*)(fData + offset);
+        if(header->magic != kTrajectoryFrameMagic) break;
+        if(offset + sizeof(TrajectoryFrameHeader) + header->payloadSize > fSize) break;
+
+        if(header->keyframe){
+            keyframe = fScannedIndex.size();
+            foundKeyframe = true;
+        }
+        if(foundKeyframe){
+            TrajectoryIndexEntry entry;
+            entry.tick = header->tick;
+            entry.offset = offset;
+            entry.keyframe = keyframe;
+            fScannedIndex.push_back(entry);
+        }
+        offset += sizeof(TrajectoryFrameHeader) + header->payloadSize;
+    }
+
+    fIndex = fScannedIndex.data();
+    fFrameCount = fScannedIndex.size();
+}
+
+/* findFrame
+ *
+ * Finds the frame for a tick. Recordings without dropped ticks have one frame per tick, so the
+ * frame can be worked out directly; otherwise the index is binary searched.
+ *
+ * inputs:
+ * - tick: tick of the simulation
+ *
+ * return: index of the last frame at or before tick (0 if tick is before the first frame)
+ */
+int TrajectoryReader::findFrame(unsigned long long tick)const{
+    if(fFrameCount == 0) return 0;
+
+    unsigned long long first = fIndex[0].tick;
+    if(tick <= first) return 0;
+    if(fIndex[fFrameCount-1].tick - first == fFrameCount-1){
+        return std::min((unsigned long long)fFrameCount-1, tick - first);
+    }
+
+    int low = 0, high = fFrameCount-1;//the answer is always in [low, high]
+    while(low < high){
+        int middle = (low + high + 1)/2;
+        if(fIndex[middle].tick <= tick) low = middle;
+        else high = middle-1;
+    }
+    return low;
+}
+
+/* readFrame
+ *
+ * Decodes a frame. If the frame is after the current frame and no later than the next keyframe,
+ * the frames in between are decoded from the current one; otherwise decoding starts again from
+ * the keyframe before the frame. Either way at most keyframeInterval frames are decoded.
+ *
+ * inputs:
+ * - frame: index of the frame
+ *
+ * return: the decoded frame, or 0 if it couldn't be decoded
+ */
+const TrajectoryFrame* TrajectoryReader::readFrame(int frame){
+    if(frame < 0 || frame >= fFrameCount) return 0;
+    if(frame == fCurrentFrame) return &fFrame;
+
+    int keyframe = fIndex[frame].keyframe;
+    if(fCurrentFrame < keyframe || fCurrentFrame > frame){
+        fCurrentFrame = keyframe - 1;
+    }
+
+    while(fCurrentFrame < frame){
+        if(!decodeNext()){
+            fCurrentFrame = -1;
+            fDecoder.reset();
+            return 0;
+        }
+    }
+    return &fFrame;
+}
+
+//decodes the frame after fCurrentFrame into fFrame
+bool TrajectoryReader::decodeNext(){
+    int next = fCurrentFrame + 1;
+    uint64_t offset = fIndex[next].offset;
+    if(offset + sizeof(TrajectoryFrameHeader) > fSize) return false;
+
+    const TrajectoryFrameHeader* header = (const TrajectoryFrameHeader*)(fData + offset);
+    if(header->magic != kTrajectoryFrameMagic || offset + sizeof(TrajectoryFrameHeader) + header->payloadSize > fSize) return false;
+
+    if(!fDecoder.decode(*header, (const uint8_t*)(header + 1), &fFrame)) return false;
+    fCurrentFrame = next;
+    return true;
+}
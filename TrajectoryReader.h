@@ -0,0 +1,70 @@
+/* TrajectoryReader.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for TrajectoryReader, which opens a trajectory file written by TrajectoryRecorder
+ * and decodes any frame of it. The file is memory mapped rather than read, so opening even a very
+ * large recording is instant and only the frames actually looked at are loaded from disk. Any frame
+ * can be found straight away using the index at the end of the file, and decoding it only needs
+ * the frames back to the keyframe before it, so jumping around a recording is fast. Stepping
+ * forwards one frame at a time only decodes one frame.
+ */
+#ifndef TRAJECTORYREADER_H
+#define TRAJECTORYREADER_H
+
+#include <string>
+#include <vector>
+#include "Trajectory.h"
+
+class TrajectoryReader
+{
+public:
+
+    //Constructor
+    TrajectoryReader();
+
+    //Deconstructor. Unmaps the file.
+    virtual ~TrajectoryReader();
+
+    //opens and maps a file. Returns false if it isn't a valid trajectory file.
+    bool open(std::string path);
+
+    //unmaps the file
+    void close();
+
+    /* Getter methods for data members. Declared inline for faster execution time,
+     * at the cost of more memory usage. Declared const so compiler can perform
+     * some optimisation */
+    inline bool const isOpen()const{return fData != 0;}
+    inline const TrajectoryHeader* getHeader()const{return (const TrajectoryHeader*)fData;}
+    inline int const getFrameCount()const{return fFrameCount;}
+    inline unsigned long long const getTick(int frame)const{return fIndex[frame].tick;}
+
+    //index of the last frame recorded at or before a tick
+    int findFrame(unsigned long long tick)const;
+
+    //decodes a frame. Returns 0 if the frame doesn't exist or is corrupt. Valid until the next call.
+    const TrajectoryFrame* readFrame(int frame);
+
+private:
+
+    //decodes the frame after fCurrentFrame
+    bool decodeNext();
+
+    //builds fScannedIndex by walking through the frame headers, for files without an index
+    void scanFrames();
+
+    const uint8_t* fData;//start of the mapped file
+    size_t fSize;//size of the mapped file
+
+    //the index of all the frames, either inside the mapped file or scanned into fScannedIndex
+    const TrajectoryIndexEntry* fIndex;
+    std::vector<TrajectoryIndexEntry> fScannedIndex;
+    int fFrameCount;
+
+    FrameDecoder fDecoder;
+    TrajectoryFrame fFrame;//the last decoded frame
+    int fCurrentFrame;//index of fFrame, or -1 if nothing has been decoded
+};
+
+#endif // TRAJECTORYREADER_H
@@ -0,0 +1,234 @@
+/* TrajectoryRecorder.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for TrajectoryRecorder, which records every tick of a Flock into a trajectory
+ * file. Copying the flock happens on the simulation thread; encoding and writing happen on a
+ * background thread.
+ */
+#include "TrajectoryRecorder.h"
+#include "Flock.h"
+#include "Bird.h"
+#include <cmath>
+#include <cstring>
+
+//Constructor
+TrajectoryRecorder::TrajectoryRecorder() :
+    fFile(0), fFileOffset(0), fLastKeyframe(0), fClosing(false), fRecordedFrames(0), fDroppedFrames(0){}
+
+//Deconstructor
+TrajectoryRecorder::~TrajectoryRecorder(){
+    close();
+}
+
+/* open
+ *
+ * Creates the file, writes the header, and starts the background thread.
+ *
+ * inputs:
+ * - path: file to create
+ * - worldWidth, worldHeight: size of the world being recorded
+ * - keyframeInterval: number of frames between keyframes
+ *
+ * return: true if the file was created
+ */
+bool TrajectoryRecorder::open(std::string path, int worldWidth, int worldHeight, int keyframeInterval){
+    close();
+
+    fFile = fopen(path.c_str(), "wb");
+    if(!fFile) return false;
+    setvbuf(fFile, 0, _IOFBF, 1 << 22);//large buffer so writes happen in big blocks
+
+    memset(&fHeader, 0, sizeof(fHeader));
+    memcpy(fHeader.magic, kTrajectoryMagic, 4);
+    fHeader.version = kTrajectoryVersion;
+    fHeader.worldWidth = worldWidth;
+    fHeader.worldHeight = worldHeight;
+    fHeader.positionScale = kPositionScale;
+    fHeader.velocityScale = kVelocityScale;
+    fHeader.keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+    fwrite(&fHeader, sizeof(fHeader), 1, fFile);
+    fFileOffset = sizeof(fHeader);
+
+    fEncoder.reset();
+    fIndex.clear();
+    fPendingDeaths.clear();
+    fRecordedFrames = 0;
+    fDroppedFrames = 0;
+    fClosing = false;
+
+    for(int i=0; i<kFrameBuffers; i++){
+        fFrames.push_back(new TrajectoryFrame());
+    }
+    fFreeFrames = fFrames;
+
+    fWriter = std::thread(&TrajectoryRecorder::writeFrames, this);
+    return true;
+}
+
+/* close
+ *
+ * Stops the background thread once it has written every queued frame, then writes the
+ * index of all frames and the footer, and closes the file.
+ */
+void TrajectoryRecorder::close(){
+    if(!fFile) return;
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fClosing = true;
+    }
+    fFrameQueued.notify_one();
+    fWriter.join();
+
+    TrajectoryFooter footer;
+    memset(&footer, 0, sizeof(footer));
+    footer.indexOffset = fFileOffset;
+    footer.frameCount = fIndex.size();
+    memcpy(footer.magic, kTrajectoryIndexMagic, 4);
+    footer.version = kTrajectoryVersion;
+
+    if(!fIndex.empty()){
+        fwrite(fIndex.data(), sizeof(TrajectoryIndexEntry), fIndex.size(), fFile);
+    }
+    fwrite(&footer, sizeof(footer), 1, fFile);
+    fclose(fFile);
+    fFile = 0;
+
+    for(int i=0; i<fFrames.size(); i++){
+        delete fFrames[i];
+    }
+    fFrames.clear();
+    fFreeFrames.clear();
+    fQueuedFrames.clear();
+}
+
+/* record
+ *
+ * Called by Flock at the end of every tick. Takes a free frame buffer, fills it with the
+ * quantised state of every bird and the ids of the birds that died this tick, and queues it
+ * for the background thread. If there is no free buffer the tick is dropped.
+ *
+ * inputs:
+ * - flock: the flock being recorded
+ */
+void TrajectoryRecorder::record(Flock* flock){
+    if(!fFile) return;
+
+    const std::vector<int>* deaths = flock->getDeaths();
+    fPendingDeaths.insert(fPendingDeaths.end(), deaths->begin(), deaths->end());
+
+    TrajectoryFrame* frame = 0;
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if(!fFreeFrames.empty()){
+            frame = fFreeFrames.back();
+            fFreeFrames.pop_back();
+        }
+    }
+    if(!frame){
+        fDroppedFrames++;
+        return;
+    }
+
+    frame->deaths.clear();
+    frame->deaths.swap(fPendingDeaths);
+    quantiseFlock(flock, frame);
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fQueuedFrames.push_back(frame);
+    }
+    fFrameQueued.notify_one();
+    fRecordedFrames++;
+}
+
+/* quantiseFlock
+ *
+ * Copies the flock into a frame, quantising as it goes. Also used by StreamServer.
+ *
+ * inputs:
+ * - flock: the flock to copy
+ * - frame: the frame to fill
+ */
+void TrajectoryRecorder::quantiseFlock(Flock* flock, TrajectoryFrame* frame){
+    std::vector<Bird*>* birds = flock->getBirds();
+    int birdCount = birds->size();
+    frame->resize(birdCount);
+    frame->tick = flock->getTick();
+
+    int32_t* ids = frame->ids.data();
+    uint8_t* species = frame->species.data();
+    int32_t* x = frame->x.data();
+    int32_t* y = frame->y.data();
+    int32_t* vx = frame->vx.data();
+    int32_t* vy = frame->vy.data();
+    for(int i=0; i<birdCount; i++){
+        const Bird* b = birds->at(i);
+        ids[i] = b->getId();
+        species[i] = b->getSpecies();
+        x[i] = quantise((double)b->getXPos(), kPositionScale);
+        y[i] = quantise((double)b->getYPos(), kPositionScale);
+        vx[i] = quantise((double)b->getVelocity().x(), kVelocityScale);
+        vy[i] = quantise((double)b->getVelocity().y(), kVelocityScale);
+    }
+}
+
+/* writeFrames
+ *
+ * Run by the background thread. Waits for queued frames, writes them, and puts the buffers
+ * back on the free list. Returns once the recorder is closing and the queue is empty.
+ */
+void TrajectoryRecorder::writeFrames(){
+    while(true){
+        TrajectoryFrame* frame;
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            while(fQueuedFrames.empty() && !fClosing){
+                fFrameQueued.wait(lock);
+            }
+            if(fQueuedFrames.empty()) return;//closing, and everything has been written
+            frame = fQueuedFrames.front();
+            fQueuedFrames.pop_front();
+        }
+
+        writeFrame(frame);
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        fFreeFrames.push_back(frame);
+    }
+}
+
+/* writeFrame
+ *
+ * Encodes a frame, writes its header and payload to the file, and adds it to the index.
+ * Every keyframeInterval'th frame is written as a keyframe.
+ */
+void TrajectoryRecorder::writeFrame(TrajectoryFrame* frame){
+    bool keyframe = fIndex.size() % fHeader.keyframeInterval == 0;
+
+    fPayload.clear();
+    fEncoder.encode(*frame, keyframe, &fPayload);
+
+    TrajectoryFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kTrajectoryFrameMagic;
+    header.keyframe = keyframe ? 1 : 0;
+    header.tick = frame->tick;
+    header.birdCount = frame->size();
+    header.deathCount = frame->deaths.size();
+    header.payloadSize = fPayload.size();
+
+    if(keyframe) fLastKeyframe = fIndex.size();
+    TrajectoryIndexEntry entry;
+    entry.tick = frame->tick;
+    entry.offset = fFileOffset;
+    entry.keyframe = fLastKeyframe;
+    fIndex.push_back(entry);
+
+    fwrite(&header, sizeof(header), 1, fFile);
+    if(!fPayload.empty()){
+        fwrite(fPayload.data(), 1, fPayload.size(), fFile);
+    }
+    fFileOffset += sizeof(header) + fPayload.size();
+}
@@ -0,0 +1,100 @@
+/* TrajectoryRecorder.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for TrajectoryRecorder, which records every tick of a Flock into a trajectory
+ * file (see Trajectory.h). Flock calls record() at the end of every simulateFlock. record() only
+ * copies the positions, velocities and ids of the birds into a frame buffer, and all encoding and
+ * writing is done by a background thread, so recording never makes the simulation wait for the
+ * disk. If the background thread falls behind and every frame buffer is in use, the tick is
+ * skipped rather than stalling the simulation; the file stays valid because the next frame is
+ * encoded against the last frame that was actually written.
+ */
+#ifndef TRAJECTORYRECORDER_H
+#define TRAJECTORYRECORDER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cmath>
+#include "Trajectory.h"
+
+class Flock;
+
+class TrajectoryRecorder
+{
+public:
+
+    //Constructor
+    TrajectoryRecorder();
+
+    //Deconstructor. Closes the file if it is still open.
+    virtual ~TrajectoryRecorder();
+
+    /* Opens a new file and starts the background thread. Returns false if the file couldn't
+     * be created. Every keyframeInterval'th frame is a keyframe. */
+    bool open(std::string path, int worldWidth, int worldHeight, int keyframeInterval = 50);
+
+    //writes out all queued frames and the index, then closes the file
+    void close();
+
+    //copies the current state of the flock into a frame and queues it for writing. Called by Flock.
+    void record(Flock* flock);
+
+    inline bool const isOpen()const{return fFile != 0;}
+    inline long long const getRecordedFrames()const{return fRecordedFrames;}
+    inline long long const getDroppedFrames()const{return fDroppedFrames;}
+
+    //quantisation scales, in steps per unit
+    static const int kPositionScale = 16;
+    static const int kVelocityScale = 1024;
+
+    //fills frame with the tick and the quantised state of every bird of the flock, leaving its deaths alone
+    static void quantiseFlock(Flock* flock, TrajectoryFrame* frame);
+
+private:
+
+    //rounds value*scale to the nearest integer
+    inline static int32_t quantise(double value, int scale){return (int32_t)std::floor(value*scale + 0.5);}
+
+    //loop run by the background thread: encodes and writes frames until the recorder is closed
+    void writeFrames();
+
+    //encodes and writes one frame to the file
+    void writeFrame(TrajectoryFrame* frame);
+
+    FILE* fFile;
+    TrajectoryHeader fHeader;
+    uint64_t fFileOffset;//current size of the file
+
+    //only used by the background thread
+    FrameEncoder fEncoder;
+    std::vector<uint8_t> fPayload;
+    std::vector<TrajectoryIndexEntry> fIndex;
+    uint64_t fLastKeyframe;
+
+    /* Frame buffers. fFreeFrames are ready to be filled by record(), fQueuedFrames are waiting
+     * for the background thread. Both are protected by fMutex. */
+    std::vector<TrajectoryFrame*> fFrames;
+    std::vector<TrajectoryFrame*> fFreeFrames;
+    std::deque<TrajectoryFrame*> fQueuedFrames;
+    std::mutex fMutex;
+    std::condition_variable fFrameQueued;
+    bool fClosing;
+    std::thread fWriter;
+
+    //ids of birds that died in ticks that were dropped, so they can be added to the next frame
+    std::vector<int32_t> fPendingDeaths;
+
+    long long fRecordedFrames;
+    long long fDroppedFrames;
+
+    //number of frame buffers. The simulation can get this many ticks ahead of the disk before ticks are dropped.
+    static const int kFrameBuffers = 8;
+};
+
+#endif // TRAJECTORYRECORDER_H
@@ -1,117 +1,154 @@
-/* TwoVector.h
- * Author: Antonino Sergi, altered by Max Elliott
- * Created on: Sep 25, 2015, altered on 2017-12-02
- *
- * TwoVector is a altered version of Antonio Sergi's ThreeVector class used
- * in the initial exercise. It applies the same concepts, but in 2D rather than 3D.
- * They are used in the simulation for the position and velocity of the FlockObjects,
- * and also as forces to change the velocity of Birds.
- */
-
-#ifndef TWOVECTOR_H_
-#define TWOVECTOR_H_
-
-#include<cmath>
-
-class TwoVector {
-public:
-
-        //Constructors.
-        TwoVector();
-        TwoVector(double x, double y);
-
-
-        //Destructor.
-        virtual ~TwoVector();
-
-        //Declaration of access methods. inline instructs the compiler to replicate
-        //the corresponding machine code each time they are invoked, rather than
-        //jumping to the position of a single copy of machine code; this results in
-        //faster execution, but larger executables. Declaring a method inline requires
-        //the implementation to be done in the same file. const indicates that the object is not
-        //modified by the execution of the method, thus the compiler can perform some
-        //optimization
-        //The components in cartesian coordinate system.
-        inline double x()  const;
-        inline double y()  const;
-
-        //inline but not const, since they are meant to modify the object
-        //Set the components
-        inline void SetX(double);
-        inline void SetY(double);
-
-        //Returns magnitude of a TwoVector
-        inline double mag()const;
-
-        //Declaration of operators acting on the invoking instance; they could be implemented
-        //here or in the implementation file, if they were not declared inline
-        //Assignment.
-        inline TwoVector & operator = (const TwoVector &);
-
-        //Addition.
-        inline TwoVector & operator += (const TwoVector &);
-
-        //Subtraction.
-        inline TwoVector & operator -= (const TwoVector &);
-
-        //Unary minus.
-        inline TwoVector operator - () const;
-
-        //Unit vector parallel to this.
-        TwoVector Unit() const;
-
-private:
-
-        double fX, fY;//x and y compenent of each vector
-
-};
-
-//Declaration of operators without an invoking instance. They must be global, thus
-//declared outside the scope of the class
-//Addition of 2-vectors.
-TwoVector operator + (const TwoVector &, const TwoVector &);
-
-//Subtraction of 2-vectors.
-TwoVector operator - (const TwoVector &, const TwoVector &);
-
-//Scaling of 2-vectors with a real number
-TwoVector operator * (const TwoVector &, double a);
-TwoVector operator * (double a, const TwoVector &);
-
-//Implementation of all methods and operators declared inline
-inline double TwoVector::x()  const { return fX; }
-inline double TwoVector::y()  const { return fY; }
-
-inline void TwoVector::SetX(double newVal) { fX = newVal; }
-inline void TwoVector::SetY(double newVal) { fY = newVal; }
-
-inline double TwoVector::mag()const{
-    return pow(fX*fX + fY*fY, 0.5);
-}
-
-//All operators involving assignment return the invoking instance itself
-//by dereferencing the pointer this
-inline TwoVector & TwoVector::operator = (const TwoVector & p) {
-   fX = p.fX;
-   fY = p.fY;
-   return *this;
-}
-
-inline TwoVector& TwoVector::operator += (const TwoVector & p) {
-   fX += p.fX;
-   fY += p.fY;
-   return *this;
-}
-
-inline TwoVector& TwoVector::operator -= (const TwoVector & p) {
-   fX -= p.fX;
-   fY -= p.fY;
-   return *this;
-}
-
-inline TwoVector TwoVector::operator - () const {
-   return TwoVector(-fX, -fY);
-}
-
-
-#endif /* TWOVECTOR_H_ */
+/* TwoVector.h
+ * Author: Antonino Sergi, altered by Max Elliott
+ * Created on: Sep 25, 2015, altered on 2017-12-02
+ *
+ * TwoVector is a altered version of Antonio Sergi's ThreeVector class used
+ * in the initial exercise. It applies the same concepts, but in 2D rather than 3D.
+ * They are used in the simulation for the position and velocity of the FlockObjects,
+ * and also as forces to change the velocity of Birds.
+ *
+ * The class is a template on the type of its components, BasicTwoVector<T>, made for float, double
+ * and Fixed in TwoVector.cpp. TwoVector is the one the simulation uses, with components of type Real:
+ * double normally, or float when built with BIRDFLOCK_FLOAT defined (qmake "DEFINES+=BIRDFLOCK_FLOAT"),
+ * which halves the memory the Birds take and lets the compiler fit twice as many components in
+ * each vector instruction, at the cost of precision the screen can't show anyway. Built with
+ * BIRDFLOCK_FIXED defined instead, Real is Fixed (see Fixed.h), and the simulation uses integer
+ * arithmetic only, so it gives the same results with every compiler and processor.
+ */
+
+#ifndef TWOVECTOR_H_
+#define TWOVECTOR_H_
+
+#include<cmath>
+#include "Fixed.h"
+
+//the type of every position, velocity, distance and strength in the simulation
+#if defined(BIRDFLOCK_FLOAT)
+typedef float Real;
+#elif defined(BIRDFLOCK_FIXED)
+typedef Fixed Real;
+#else
+typedef double Real;
+#endif
+
+template<typename T>
+class BasicTwoVector {
+
+public:
+
+        //the type of the components, and of anything a BasicTwoVector is scaled by
+        typedef T Scalar;
+
+        //Constructors.
+        BasicTwoVector();
+        BasicTwoVector(T x, T y);
+
+        //Declaration of access methods. inline instructs the compiler to replicate
+        //the corresponding machine code each time they are invoked, rather than
+        //jumping to the position of a single copy of machine code; this results in
+        //faster execution, but larger executables. Declaring a method inline requires
+        //the implementation to be done in the same file. const indicates that the object is not
+        //modified by the execution of the method, thus the compiler can perform some
+        //optimization
+
+        //The components in cartesian coordinate system.
+        inline T x()  const;
+        inline T y()  const;
+
+        //inline but not const, since they are meant to modify the object
+        //Set the components
+        inline void SetX(T);
+        inline void SetY(T);
+
+        //Returns magnitude of a TwoVector
+        inline T mag()const;
+
+        //Declaration of operators acting on the invoking instance; they could be implemented
+        //here or in the implementation file, if they were not declared inline
+
+        //Assignment.
+        inline BasicTwoVector & operator = (const BasicTwoVector &);
+
+        //Addition.
+        inline BasicTwoVector & operator += (const BasicTwoVector &);
+
+        //Subtraction.
+        inline BasicTwoVector & operator -= (const BasicTwoVector &);
+
+        //Unary minus.
+        inline BasicTwoVector operator - () const;
+
+        //Unit vector parallel to this.
+        BasicTwoVector Unit() const;
+
+private:
+        T fX, fY;//x and y compenent of each vector
+
+};
+
+typedef BasicTwoVector<Real> TwoVector;
+
+//Declaration of operators without an invoking instance. They must be global, thus
+//declared outside the scope of the class. The scale is given as Scalar, so that it
+//is converted from whatever number it is, rather than used to work out the type T.
+
+//Addition of 2-vectors.
+template<typename T>
+BasicTwoVector<T> operator + (const BasicTwoVector<T> &, const BasicTwoVector<T> &);
+
+//Subtraction of 2-vectors.
+template<typename T>
+BasicTwoVector<T> operator - (const BasicTwoVector<T> &, const BasicTwoVector<T> &);
+
+//Scaling of 2-vectors with a real number
+template<typename T>
+BasicTwoVector<T> operator * (const BasicTwoVector<T> &, typename BasicTwoVector<T>::Scalar a);
+template<typename T>
+BasicTwoVector<T> operator * (typename BasicTwoVector<T>::Scalar a, const BasicTwoVector<T> &);
+
+//Implementation of all methods and operators declared inline
+template<typename T>
+inline T BasicTwoVector<T>::x()  const { return fX; }
+template<typename T>
+inline T BasicTwoVector<T>::y()  const { return fY; }
+
+template<typename T>
+inline void BasicTwoVector<T>::SetX(T newVal) { fX = newVal; }
+template<typename T>
+inline void BasicTwoVector<T>::SetY(T newVal) { fY = newVal; }
+
+template<typename T>
+inline T BasicTwoVector<T>::mag()const{
+    using std::sqrt;//sqrt of a Fixed is found in Fixed.h
+    return sqrt(fX*fX + fY*fY);
+}
+
+//All operators involving assignment return the invoking instance itself
+//by dereferencing the pointer this
+template<typename T>
+inline BasicTwoVector<T> & BasicTwoVector<T>::operator = (const BasicTwoVector<T> & p) {
+   fX = p.fX;
+   fY = p.fY;
+   return *this;
+}
+
+template<typename T>
+inline BasicTwoVector<T>& BasicTwoVector<T>::operator += (const BasicTwoVector<T> & p) {
+   fX += p.fX;
+   fY += p.fY;
+   return *this;
+}
+
+template<typename T>
+inline BasicTwoVector<T>& BasicTwoVector<T>::operator -= (const BasicTwoVector<T> & p) {
+   fX -= p.fX;
+   fY -= p.fY;
+   return *this;
+}
+
+template<typename T>
+inline BasicTwoVector<T> BasicTwoVector<T>::operator - () const {
+   return BasicTwoVector<T>(-fX, -fY);
+}
+
+#endif /* TWOVECTOR_H_ */
@@ -0,0 +1,189 @@
+/* WebSocket.cpp
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * .cpp file for the WebSocket handshake and framing helpers. Includes a minimal SHA-1, which the
+ * handshake needs and nothing else uses.
+ */
+#include "WebSocket.h"
+#include <cstring>
+
+//appended to the client's key before hashing, fixed by the protocol
+static const char* kWebSocketGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+//rotates a 32 bit value left
+inline static uint32_t rotateLeft(uint32_t value, int bits){return (value << bits) | (value >> (32 - bits));}
+
+/* sha1
+ *
+ * The SHA-1 hash of some bytes, as in FIPS 180-4.
+ *
+ * inputs:
+ * - data, size: the bytes to hash
+ * - digest: set to the 20 byte hash
+ */
+static void sha1(const uint8_t* data, size_t size, uint8_t digest[20]){
+    uint32_t h[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+    //pad with a 1 bit, zeros, and the length in bits, to a multiple of 64 bytes
+    std::vector<uint8_t> message(data, data + size);
+    message.push_back(0x80);
+    while(message.size() % 64 != 56) message.push_back(0);
+    uint64_t bits = (uint64_t)size*8;
+    for(int i=7; i>=0; i--) message.push_back((uint8_t)(bits >> (8*i)));
+
+    for(size_t block=0; block<message.size(); block+=64){
+        uint32_t w[80];
+        for(int i=0; i<16; i++){
+            const uint8_t* p = &message[block + 4*i];
+            w[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+        }
+        for(int i=16; i<80; i++){
+            w[i] = rotateLeft(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for(int i=0; i<80; i++){
+            uint32_t f, k;
+            if(i < 20){
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            }
+            else if(i < 40){
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            }
+            else if(i < 60){
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            }
+            else{
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for(int i=0; i<5; i++){
+        digest[4*i] = (uint8_t)(h[i] >> 24);
+        digest[4*i + 1] = (uint8_t)(h[i] >> 16);
+        digest[4*i + 2] = (uint8_t)(h[i] >> 8);
+        digest[4*i + 3] = (uint8_t)h[i];
+    }
+}
+
+std::string base64Encode(const uint8_t* data, size_t size){
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for(size_t i=0; i<size; i+=3){
+        uint32_t group = (uint32_t)data[i] << 16;
+        if(i+1 < size) group |= (uint32_t)data[i+1] << 8;
+        if(i+2 < size) group |= data[i+2];
+        out += alphabet[(group >> 18) & 63];
+        out += alphabet[(group >> 12) & 63];
+        out += i+1 < size ? alphabet[(group >> 6) & 63] : '=';
+        out += i+2 < size ? alphabet[group & 63] : '=';
+    }
+    return out;
+}
+
+std::string webSocketAccept(const std::string& key){
+    std::string text = key + kWebSocketGuid;
+    uint8_t digest[20];
+    sha1(reinterpret_cast<const uint8_t*>(text.data()), text.size(), digest);
+    return base64Encode(digest, 20);
+}
+
+/* appendWebSocketFrame
+ *
+ * inputs:
+ * - out: vector the frame is appended to
+ * - opcode: a WebSocketOpcode
+ * - payload, size: the message
+ * - mask: whether to mask the payload, which clients must do
+ * - maskKey: the key to mask it with
+ */
+void appendWebSocketFrame(std::vector<uint8_t>* out, int opcode, const uint8_t* payload, size_t size, bool mask, uint32_t maskKey){
+    out->push_back(0x80 | (opcode & 0x0f));
+
+    //lengths over 125 are stored after the second byte, in network byte order
+    uint8_t maskBit = mask ? 0x80 : 0;
+    if(size < 126){
+        out->push_back(maskBit | (uint8_t)size);
+    }
+    else if(size < 65536){
+        out->push_back(maskBit | 126);
+        out->push_back((uint8_t)(size >> 8));
+        out->push_back((uint8_t)size);
+    }
+    else{
+        out->push_back(maskBit | 127);
+        for(int i=7; i>=0; i--) out->push_back((uint8_t)((uint64_t)size >> (8*i)));
+    }
+
+    if(!mask){
+        out->insert(out->end(), payload, payload + size);
+        return;
+    }
+    uint8_t key[4] = {(uint8_t)(maskKey >> 24), (uint8_t)(maskKey >> 16), (uint8_t)(maskKey >> 8), (uint8_t)maskKey};
+    out->insert(out->end(), key, key + 4);
+    for(size_t i=0; i<size; i++){
+        out->push_back(payload[i] ^ key[i % 4]);
+    }
+}
+
+/* readWebSocketFrame
+ *
+ * inputs:
+ * - data, size: bytes received so far
+ * - frame: set to the frame, if there is a whole one
+ * - maxPayload: largest payload accepted
+ *
+ * return: bytes the frame took up, 0 if it isn't all there yet, or -1 if it is too big
+ */
+long long readWebSocketFrame(const uint8_t* data, size_t size, WebSocketFrame* frame, size_t maxPayload){
+    if(size < 2) return 0;
+    size_t position = 2;
+    uint64_t length = data[1] & 0x7f;
+    if(length == 126){
+        if(size < 4) return 0;
+        length = ((uint64_t)data[2] << 8) | data[3];
+        position = 4;
+    }
+    else if(length == 127){
+        if(size < 10) return 0;
+        length = 0;
+        for(int i=0; i<8; i++) length = (length << 8) | data[2 + i];
+        position = 10;
+    }
+    if(length > maxPayload) return -1;
+
+    bool masked = (data[1] & 0x80) != 0;
+    uint8_t key[4] = {0, 0, 0, 0};
+    if(masked){
+        if(size < position + 4) return 0;
+        memcpy(key, data + position, 4);
+        position += 4;
+    }
+    if(size < position + length) return 0;
+
+    frame->final = (data[0] & 0x80) != 0;
+    frame->opcode = data[0] & 0x0f;
+    frame->masked = masked;
+    frame->payload.assign(data + position, data + position + length);
+    if(masked){
+        for(size_t i=0; i<length; i++) frame->payload[i] ^= key[i % 4];
+    }
+    return position + length;
+}
@@ -0,0 +1,55 @@
+/* WebSocket.h
+ * Author: Max Elliott
+ * Created On: 2026-10-18
+ *
+ * Header file for the small parts of the WebSocket protocol (RFC 6455) that StreamServer and its
+ * client need: working out the handshake reply, and turning messages into frames and back. There
+ * is no networking in here; the callers own the sockets and pass the bytes through these.
+ *
+ * Only whole messages are supported. Fragmented messages, which browsers only send for very large
+ * messages, are skipped.
+ */
+#ifndef WEBSOCKET_H
+#define WEBSOCKET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//frame opcodes
+enum WebSocketOpcode{
+    kWebSocketContinuation = 0x0,
+    kWebSocketText = 0x1,
+    kWebSocketBinary = 0x2,
+    kWebSocketClose = 0x8,
+    kWebSocketPing = 0x9,
+    kWebSocketPong = 0xa
+};
+
+//one frame read by readWebSocketFrame, with its payload already unmasked
+struct WebSocketFrame
+{
+    bool final;
+    int opcode;
+    bool masked;
+    std::vector<uint8_t> payload;
+};
+
+/* the Sec-WebSocket-Accept a server replies with for the Sec-WebSocket-Key a client sent: the
+ * base64 of the SHA-1 of the key followed by the protocol's fixed GUID */
+std::string webSocketAccept(const std::string& key);
+
+//base64 of some bytes, with padding
+std::string base64Encode(const uint8_t* data, size_t size);
+
+/* Appends a whole message as one frame to out. Clients must mask every frame with a key that
+ * changes from frame to frame; servers must never mask. */
+void appendWebSocketFrame(std::vector<uint8_t>* out, int opcode, const uint8_t* payload, size_t size,
+                          bool mask = false, uint32_t maskKey = 0);
+
+/* Reads one frame from the start of data. Returns the number of bytes it took up, 0 if data doesn't
+ * hold a whole frame yet, or -1 if the frame is bigger than maxPayload. */
+long long readWebSocketFrame(const uint8_t* data, size_t size, WebSocketFrame* frame, size_t maxPayload);
+
+#endif // WEBSOCKET_H
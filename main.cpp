@@ -8,5 +8,8 @@ int main(int argc, char *argv[])
     MainWindow mainWindow;
     mainWindow.show();
 
+    //a scenario file can be given on the command line to start with instead of the default flock
+    if(argc > 1) mainWindow.loadScenario(argv[1]);
+
     return a.exec();
 }